@@ -0,0 +1,152 @@
+#include <atom/core/model_interface.hpp>
+#include <atom/logging/logger.hpp>
+#include <atom/scheduler/scheduler.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "synthetic_model.hpp"
+
+// Open-loop load on the Scheduler at 1x and 2x its nominal capacity (two
+// workers, a model that takes 1 ms per Infer) with a 50 ms deadline per task. Goodput
+// counts tasks completed within their deadline. Without admission control
+// the queue grows without bound and, unless late tasks are shed, nearly
+// every task misses its deadline; with it, the excess is refused up front
+// with QueueFull and goodput stays near capacity. A High stream of 5% of
+// capacity runs alongside the Normal load to show the reserved headroom.
+
+namespace {
+
+using namespace atom;
+using Clock = std::chrono::steady_clock;
+using bench::SyntheticModel;
+
+constexpr size_t kWorkers = 2;
+constexpr auto kServiceTime = std::chrono::microseconds(1000);
+constexpr auto kDeadline = std::chrono::milliseconds(50);
+constexpr auto kDuration = std::chrono::seconds(3);
+constexpr size_t kCapacity = kWorkers * 1000;       // tasks per second
+
+struct Outcome {
+    double goodput;             // per second
+    double rejected;            // per second
+    double p99_ms;              // of completed Normal tasks
+    size_t limit;               // concurrency limit at the end
+    double high_goodput;        // fraction of High tasks completed in time
+};
+
+struct Counters {
+    std::atomic<size_t> good{0};
+    std::atomic<size_t> high_good{0};
+    std::mutex mutex;
+    std::vector<double> latencies;
+};
+
+Outcome Run(const std::string& name, scheduler::SchedulerConfig config, double load) {
+    config.num_threads = kWorkers;
+    config.task_timeout = kDeadline;
+    scheduler::Scheduler sched(config);
+    sched.Start();
+    auto model = std::make_shared<SyntheticModel>(kServiceTime);
+
+    Counters counters;
+    counters.latencies.reserve(static_cast<size_t>(kCapacity * load * 4));
+    size_t rejected = 0;
+    size_t high_submitted = 0;
+
+    auto submit = [&](core::Priority priority) {
+        const auto submitted = Clock::now();
+        const bool high = priority == core::Priority::High;
+        auto id = sched.SubmitTask(model, {}, priority,
+            [&counters, submitted, high](const scheduler::TaskResult& result) {
+                if (result.status != scheduler::TaskStatus::Completed) return;
+                const auto latency = Clock::now() - submitted;
+                if (latency <= kDeadline) (high ? counters.high_good : counters.good)++;
+                if (!high) {
+                    std::lock_guard<std::mutex> lock(counters.mutex);
+                    counters.latencies.push_back(std::chrono::duration<double, std::milli>(latency).count());
+                }
+            });
+        if (!id && !high) rejected++;
+    };
+
+    // Submits once per millisecond, carrying fractions over
+    const double per_tick = kCapacity * load / 1000.0;
+    const double high_per_tick = kCapacity * 0.05 / 1000.0;
+    double owed = 0.0;
+    double high_owed = 0.0;
+    const auto start = Clock::now();
+    for (auto tick = start; tick - start < kDuration; tick += std::chrono::milliseconds(1)) {
+        std::this_thread::sleep_until(tick);
+        for (owed += per_tick; owed >= 1.0; owed -= 1.0) submit(core::Priority::Normal);
+        for (high_owed += high_per_tick; high_owed >= 1.0; high_owed -= 1.0, ++high_submitted) {
+            submit(core::Priority::High);
+        }
+    }
+    const size_t limit = sched.GetConcurrencyLimit();
+    sched.Stop();
+
+    const double seconds = std::chrono::duration<double>(kDuration).count();
+    auto& latencies = counters.latencies;
+    std::sort(latencies.begin(), latencies.end());
+    Outcome outcome{
+        counters.good.load() / seconds,
+        rejected / seconds,
+        latencies.empty() ? 0.0 : latencies[latencies.size() * 99 / 100],
+        limit,
+        high_submitted ? static_cast<double>(counters.high_good.load()) / high_submitted : 0.0
+    };
+
+    std::cout << "  " << std::left << std::setw(28) << name << std::right
+              << std::setw(9) << outcome.goodput
+              << std::setw(11) << outcome.rejected
+              << std::setw(11) << outcome.p99_ms
+              << std::setw(8) << (config.admission.algorithm == scheduler::LimitAlgorithm::None ? 0 : outcome.limit)
+              << std::setw(10) << outcome.high_goodput * 100.0 << "%" << std::endl;
+    return outcome;
+}
+
+} // namespace
+
+int main() {
+    logging::Logger::Instance().SetLevel(logging::LogLevel::Error);
+    std::cout << std::fixed << std::setprecision(1);
+
+    scheduler::SchedulerConfig unbounded;
+    unbounded.max_queue_size = 0;
+    unbounded.shed_late_tasks = false;
+
+    scheduler::SchedulerConfig shedding = unbounded;
+    shedding.shed_late_tasks = true;
+
+    scheduler::SchedulerConfig capped;
+    capped.max_queue_size = 100;
+
+    scheduler::SchedulerConfig aimd;
+    aimd.max_queue_size = 0;
+    aimd.admission.algorithm = scheduler::LimitAlgorithm::Aimd;
+
+    scheduler::SchedulerConfig gradient;
+    gradient.max_queue_size = 0;
+    gradient.admission.algorithm = scheduler::LimitAlgorithm::Gradient;
+
+    for (double load : {1.0, 2.0}) {
+        std::cout << load << "x capacity (" << static_cast<size_t>(kCapacity * load) << " Normal tasks/s, "
+                  << kDeadline.count() << " ms deadline)" << std::endl;
+        std::cout << "  " << std::left << std::setw(28) << "admission" << std::right
+                  << std::setw(9) << "goodput" << std::setw(11) << "rejected/s"
+                  << std::setw(11) << "p99 ms" << std::setw(8) << "limit"
+                  << std::setw(11) << "High ok" << std::endl;
+        Run("unbounded, no shedding", unbounded, load);
+        Run("unbounded, shed late", shedding, load);
+        Run("max_queue_size 100", capped, load);
+        Run("adaptive AIMD", aimd, load);
+        Run("adaptive gradient", gradient, load);
+    }
+    return 0;
+}
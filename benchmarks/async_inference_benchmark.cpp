@@ -0,0 +1,99 @@
+#include <atom/core/model_interface.hpp>
+#include <atom/logging/logger.hpp>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <thread>
+#include "synthetic_model.hpp"
+
+// Compares a synchronous preprocess -> Infer -> postprocess loop against the
+// same loop driven through InferAsync, where inference of frame N overlaps
+// with pre/postprocessing of its neighbours on the submitting thread.
+
+namespace {
+
+using namespace atom;
+using Clock = std::chrono::steady_clock;
+using bench::SyntheticModel;
+
+void BusyWait(std::chrono::microseconds duration) {
+    auto end = Clock::now() + duration;
+    while (Clock::now() < end) {
+        std::this_thread::yield();
+    }
+}
+
+struct Workload {
+    size_t frames{200};
+    std::chrono::microseconds preprocess{3000};
+    std::chrono::microseconds inference{8000};
+    std::chrono::microseconds postprocess{3000};
+    size_t max_in_flight{4};
+};
+
+core::Tensor MakeFrame() {
+    auto tensor = core::Tensor::Create({1, 3, 64, 64}, core::DataType::Float32);
+    return std::move(*tensor);
+}
+
+double RunSynchronous(SyntheticModel& model, const Workload& workload) {
+    auto start = Clock::now();
+    for (size_t i = 0; i < workload.frames; ++i) {
+        BusyWait(workload.preprocess);
+        auto result = model.Infer({MakeFrame()});
+        if (!result) {
+            std::cerr << "Infer failed: " << result.error().message << std::endl;
+        }
+        BusyWait(workload.postprocess);
+    }
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+double RunPipelined(SyntheticModel& model, const Workload& workload) {
+    std::deque<std::future<core::Result<std::vector<core::Tensor>>>> in_flight;
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < workload.frames; ++i) {
+        BusyWait(workload.preprocess);
+        in_flight.push_back(model.InferAsync({MakeFrame()}));
+
+        // Postprocess the oldest frame while newer ones are inferring
+        if (in_flight.size() >= workload.max_in_flight) {
+            auto result = in_flight.front().get();
+            in_flight.pop_front();
+            if (!result) {
+                std::cerr << "InferAsync failed: " << result.error().message << std::endl;
+            }
+            BusyWait(workload.postprocess);
+        }
+    }
+    while (!in_flight.empty()) {
+        in_flight.front().get();
+        in_flight.pop_front();
+        BusyWait(workload.postprocess);
+    }
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main() {
+    logging::Logger::Instance().SetLevel(logging::LogLevel::Warning);
+
+    Workload workload;
+    SyntheticModel model(workload.inference);
+
+    double sync_seconds = RunSynchronous(model, workload);
+    double async_seconds = RunPipelined(model, workload);
+    model.Shutdown();
+
+    double sync_fps = workload.frames / sync_seconds;
+    double async_fps = workload.frames / async_seconds;
+
+    std::cout << "frames:            " << workload.frames << std::endl;
+    std::cout << "synchronous:       " << sync_fps << " frames/s" << std::endl;
+    std::cout << "pipelined (async): " << async_fps << " frames/s" << std::endl;
+    std::cout << "speedup:           " << async_fps / sync_fps << "x" << std::endl;
+
+    return 0;
+}
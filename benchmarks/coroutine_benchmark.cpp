@@ -0,0 +1,116 @@
+#include <atom/core/model_interface.hpp>
+#include <atom/logging/logger.hpp>
+#include <atom/scheduler/coroutine.hpp>
+#include <atom/scheduler/scheduler.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "synthetic_model.hpp"
+
+// Requests of two chained inferences (the second consumes the first's
+// outputs), all outstanding at once. Blocking style needs a thread per
+// request parked in WaitForTask; with coroutines one thread submits every
+// request and awaits them with WhenAll, and each request continues on a
+// scheduler worker, so the thread count stays at workers + 1.
+
+namespace {
+
+using namespace atom;
+using Clock = std::chrono::steady_clock;
+using bench::SyntheticModel;
+
+constexpr size_t kWorkers = 16;
+constexpr auto kServiceTime = std::chrono::microseconds(200);
+
+scheduler::SchedulerConfig Config() {
+    scheduler::SchedulerConfig config;
+    config.num_threads = kWorkers;
+    config.max_queue_size = 0;                      // every request is outstanding at once
+    config.task_timeout = core::Duration::zero();
+    return config;
+}
+
+void Report(const std::string& name, size_t requests, size_t completed, size_t threads, Clock::duration elapsed) {
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    std::cout << "  " << std::left << std::setw(26) << name << std::right
+              << std::setw(10) << requests
+              << std::setw(10) << completed
+              << std::setw(10) << threads
+              << std::setw(14) << completed / seconds << std::endl;
+}
+
+void RunBlocking(size_t requests) {
+    scheduler::Scheduler sched(Config());
+    sched.Start();
+    auto model = std::make_shared<SyntheticModel>(kServiceTime);
+
+    std::atomic<size_t> completed{0};
+    const auto start = Clock::now();
+    std::vector<std::thread> threads;
+    threads.reserve(requests);
+    for (size_t i = 0; i < requests; ++i) {
+        threads.emplace_back([&]() {
+            auto first = sched.SubmitTask(model, std::vector<core::Tensor>(1));
+            if (!first) return;
+            auto result = sched.WaitForTask(*first);
+            if (!result || result->status != scheduler::TaskStatus::Completed) return;
+            auto second = sched.SubmitTask(model, std::move(result->outputs));
+            if (!second) return;
+            result = sched.WaitForTask(*second);
+            if (result && result->status == scheduler::TaskStatus::Completed) completed++;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    Report("thread per request", requests, completed, requests + kWorkers, Clock::now() - start);
+}
+
+scheduler::CoTask<bool> Request(scheduler::Scheduler& sched, core::ModelPtr model) {
+    auto result = co_await sched.Submit(model, std::vector<core::Tensor>(1));
+    if (!result || result->status != scheduler::TaskStatus::Completed) co_return false;
+    result = co_await sched.Submit(model, std::move(result->outputs));
+    co_return result && result->status == scheduler::TaskStatus::Completed;
+}
+
+void RunCoroutines(size_t requests) {
+    scheduler::Scheduler sched(Config());
+    sched.Start();
+    auto model = std::make_shared<SyntheticModel>(kServiceTime);
+
+    const auto start = Clock::now();
+    std::vector<scheduler::CoTask<bool>> pending;
+    pending.reserve(requests);
+    for (size_t i = 0; i < requests; ++i) {
+        pending.push_back(Request(sched, model));
+    }
+    const auto results = scheduler::SyncWait(scheduler::WhenAll(std::move(pending)));
+    size_t completed = 0;
+    for (bool ok : results) {
+        completed += ok;
+    }
+    Report("coroutines, one thread", requests, completed, 1 + kWorkers, Clock::now() - start);
+}
+
+} // namespace
+
+int main() {
+    logging::Logger::Instance().SetLevel(logging::LogLevel::Error);
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << kWorkers << " workers, " << kServiceTime.count() << " us per Infer, 2 chained Infers per request"
+              << std::endl;
+    std::cout << "  " << std::left << std::setw(26) << "style" << std::right
+              << std::setw(10) << "requests" << std::setw(10) << "completed"
+              << std::setw(10) << "threads" << std::setw(14) << "requests/s" << std::endl;
+
+    for (size_t requests : {1000, 4000}) {
+        RunBlocking(requests);
+        RunCoroutines(requests);
+    }
+    RunCoroutines(20000);
+    RunCoroutines(50000);
+    return 0;
+}
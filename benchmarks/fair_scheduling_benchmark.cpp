@@ -0,0 +1,131 @@
+#include <atom/core/model_interface.hpp>
+#include <atom/logging/logger.hpp>
+#include <atom/scheduler/scheduler.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "synthetic_model.hpp"
+
+// Skewed multi-tenant load on the Scheduler: one tenant floods SubmitBatch
+// while quiet tenants trickle in single tasks. Reports the quiet tenants'
+// latency with every task in one tenant (a single FIFO, as before fair
+// queuing) against one tenant per client, then the latency of a Low task
+// behind a Critical flood with and without aging, and finally the raw
+// FairQueue push + pop cost as the number of tenants grows.
+
+namespace {
+
+using namespace atom;
+using Clock = std::chrono::steady_clock;
+using bench::SyntheticModel;
+
+struct Percentiles {
+    double p50_ms;
+    double p99_ms;
+};
+
+Percentiles Summarize(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    return {samples[samples.size() / 2], samples[samples.size() * 99 / 100]};
+}
+
+// Latency of the quiet tenants' tasks while the noisy one floods
+Percentiles QuietLatency(bool per_tenant) {
+    scheduler::SchedulerConfig config;
+    config.num_threads = 2;
+    config.task_timeout = core::Duration::zero();
+    config.max_queue_size = 0;      // the flood alone fills the default cap
+    scheduler::Scheduler sched(config);
+    sched.Start();
+    auto model = std::make_shared<SyntheticModel>(std::chrono::microseconds(1000));
+
+    std::vector<std::pair<core::ModelPtr, std::vector<core::Tensor>>> flood(1000, {model, {}});
+    sched.SubmitBatch(flood, core::Priority::Normal, {.tenant = per_tenant ? "noisy" : ""});
+
+    std::mutex mutex;
+    std::vector<double> latencies;
+    std::vector<scheduler::TaskId> ids;
+    for (int round = 0; round < 40; ++round) {
+        for (int client = 0; client < 3; ++client) {
+            auto submitted = Clock::now();
+            auto id = sched.SubmitTask(model, {}, core::Priority::Normal,
+                [&, submitted](const scheduler::TaskResult&) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    latencies.push_back(std::chrono::duration<double, std::milli>(Clock::now() - submitted).count());
+                },
+                {.tenant = per_tenant ? "quiet" + std::to_string(client) : ""});
+            ids.push_back(*id);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    sched.WaitForAll(ids);
+    sched.Stop();
+    return Summarize(latencies);
+}
+
+// Latency of one Low task submitted behind a Critical flood
+double LowLatency(core::Duration aging_interval) {
+    scheduler::SchedulerConfig config;
+    config.num_threads = 1;
+    config.task_timeout = core::Duration::zero();
+    config.aging_interval = aging_interval;
+    scheduler::Scheduler sched(config);
+    sched.Start();
+    auto model = std::make_shared<SyntheticModel>(std::chrono::microseconds(1000));
+
+    std::vector<std::pair<core::ModelPtr, std::vector<core::Tensor>>> flood(300, {model, {}});
+    sched.SubmitBatch(flood, core::Priority::Critical);
+    auto submitted = Clock::now();
+    auto id = sched.SubmitTask(model, {}, core::Priority::Low);
+    sched.WaitForTask(*id);
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - submitted).count();
+    sched.Stop();
+    return ms;
+}
+
+// Nanoseconds per push + pop with tasks spread over the given tenants
+double QueueCost(size_t tenants) {
+    constexpr size_t kTasks = 1 << 18;
+    auto model = std::make_shared<SyntheticModel>(std::chrono::microseconds(0));
+    std::vector<scheduler::TaskPtr> tasks;
+    tasks.reserve(kTasks);
+    for (size_t i = 0; i < kTasks; ++i) {
+        auto task = std::make_shared<scheduler::Task>(i, model, std::vector<core::Tensor>{},
+                                                      static_cast<core::Priority>(i % 4));
+        task->SetTenant("tenant" + std::to_string(i % tenants));
+        tasks.push_back(std::move(task));
+    }
+
+    scheduler::FairQueue queue;
+    auto start = Clock::now();
+    for (auto& task : tasks) queue.Push(task);
+    while (queue.Pop()) {}
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / kTasks;
+}
+
+} // namespace
+
+int main() {
+    logging::Logger::Instance().SetLevel(logging::LogLevel::Warning);
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::cout << "quiet tenants behind a 1000-task flood (2 workers, 1 ms tasks)" << std::endl;
+    auto fifo = QuietLatency(false);
+    auto fair = QuietLatency(true);
+    std::cout << "  single queue:  p50 " << fifo.p50_ms << " ms  p99 " << fifo.p99_ms << " ms" << std::endl;
+    std::cout << "  fair queuing:  p50 " << fair.p50_ms << " ms  p99 " << fair.p99_ms << " ms" << std::endl;
+
+    std::cout << "Low task behind a 300-task Critical flood (1 worker)" << std::endl;
+    std::cout << "  no aging:      " << LowLatency(std::chrono::hours(1)) << " ms" << std::endl;
+    std::cout << "  aging 20 ms:   " << LowLatency(std::chrono::milliseconds(20)) << " ms" << std::endl;
+
+    std::cout << "FairQueue push + pop" << std::endl;
+    for (size_t tenants : {1, 16, 1024, 65536}) {
+        std::cout << "  " << std::setw(6) << tenants << " tenants: " << QueueCost(tenants) << " ns/task" << std::endl;
+    }
+    return 0;
+}
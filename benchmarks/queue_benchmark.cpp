@@ -0,0 +1,120 @@
+#include <atom/data/queue.hpp>
+#include <atom/data/ring_queue.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Compares ThreadSafeQueue (std::queue + mutex + condition variables)
+// against the lock-free MpmcQueue / SpscQueue rings. Throughput moves small
+// items through one queue of capacity 1024 at several producer:consumer
+// counts; latency bounces one item between two threads through a pair of
+// queues and reports the round trip.
+
+namespace {
+
+using namespace atom;
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kCapacity = 1024;
+constexpr size_t kItems = 1 << 21;
+constexpr size_t kRoundTrips = 20000;
+
+// Million items per second
+template<typename Queue>
+double Throughput(size_t producers, size_t consumers) {
+    Queue queue(kCapacity);
+    const size_t per_producer = kItems / producers;
+    std::atomic<size_t> received{0};
+
+    auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (size_t c = 0; c < consumers; ++c) {
+        threads.emplace_back([&]() {
+            size_t count = 0;
+            while (queue.Pop()) ++count;
+            received.fetch_add(count);
+        });
+    }
+    std::vector<std::thread> producer_threads;
+    for (size_t p = 0; p < producers; ++p) {
+        producer_threads.emplace_back([&]() {
+            for (size_t i = 0; i < per_producer; ++i) queue.Push(i);
+        });
+    }
+    for (auto& thread : producer_threads) thread.join();
+    queue.Stop();
+    for (auto& thread : threads) thread.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    if (received.load() != per_producer * producers) std::cerr << "lost items" << std::endl;
+    return per_producer * producers / seconds / 1e6;
+}
+
+struct Latency {
+    double median_us;
+    double p99_us;
+};
+
+template<typename Queue>
+Latency PingPong() {
+    Queue ping(kCapacity);
+    Queue pong(kCapacity);
+    std::thread echo([&]() {
+        while (auto item = ping.Pop()) pong.Push(*item);
+    });
+
+    std::vector<double> samples;
+    samples.reserve(kRoundTrips);
+    for (size_t i = 0; i < kRoundTrips; ++i) {
+        auto start = Clock::now();
+        ping.Push(i);
+        pong.Pop();
+        samples.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    }
+    ping.Stop();
+    echo.join();
+
+    std::sort(samples.begin(), samples.end());
+    return {samples[samples.size() / 2], samples[samples.size() * 99 / 100]};
+}
+
+template<typename Queue>
+void Report(const char* name, size_t producers, size_t consumers) {
+    std::cout << std::setw(8) << producers << ':' << std::left << std::setw(4) << consumers << std::right
+              << std::setw(18) << name << std::setw(12) << Throughput<Queue>(producers, consumers) << std::endl;
+}
+
+template<typename Queue>
+void ReportLatency(const char* name) {
+    Latency latency = PingPong<Queue>();
+    std::cout << std::setw(18) << name << std::setw(12) << latency.median_us << std::setw(12) << latency.p99_us
+              << std::endl;
+}
+
+} // namespace
+
+int main() {
+    using Locked = data::ThreadSafeQueue<size_t>;
+    using Mpmc = data::MpmcQueue<size_t>;
+    using Spsc = data::SpscQueue<size_t>;
+
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "   P:C                  queue    Mitems/s" << std::endl;
+
+    const std::pair<size_t, size_t> shapes[] = {{1, 1}, {1, 4}, {4, 1}, {2, 2}, {4, 4}, {8, 8}};
+    for (auto [producers, consumers] : shapes) {
+        Report<Locked>("ThreadSafeQueue", producers, consumers);
+        Report<Mpmc>("MpmcQueue", producers, consumers);
+        if (producers == 1 && consumers == 1) Report<Spsc>("SpscQueue", 1, 1);
+    }
+
+    std::cout << std::endl << "             queue   median us      p99 us   (round trip)" << std::endl;
+    ReportLatency<Locked>("ThreadSafeQueue");
+    ReportLatency<Mpmc>("MpmcQueue");
+    ReportLatency<Spsc>("SpscQueue");
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include <atom/core/model_interface.hpp>
+#include <atom/logging/logger.hpp>
+#include <atom/scheduler/scheduler.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Long-running submit -> execute -> complete loop on the Scheduler. Half of
+// the tasks are taken with WaitForTask, the other half only report through
+// their callback and are retired when result_retention runs out. Every
+// interval it prints the heap allocations per task (counted by replacing
+// the global operator new), the resident set size and the tasks still
+// tracked; at steady state the first should be zero and the others flat.
+//
+// Usage: scheduler_soak_benchmark [seconds]   (default 30)
+
+namespace {
+
+std::atomic<unsigned long long> g_allocations{0};
+
+} // namespace
+
+// Both out of line, or GCC pairs the inlined malloc and free with new and
+// delete and warns about a mismatch
+[[gnu::noinline]] void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+[[gnu::noinline]] void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { operator delete(p); }
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+void operator delete[](void* p, size_t) noexcept { operator delete(p); }
+
+namespace {
+
+using namespace atom;
+using Clock = std::chrono::steady_clock;
+
+// Model that returns no outputs immediately
+class NullModel : public core::ModelBase {
+public:
+    NullModel() : ModelBase("Null") {
+        initialized_ = true;
+    }
+
+    core::Result<void> Initialize(const std::string&, const core::InferenceOptions&) override { return {}; }
+    core::Result<void> Warmup() override { return {}; }
+    void Shutdown() override {}
+
+    core::Result<std::vector<core::Tensor>> Infer(const std::vector<core::Tensor>&) override {
+        return std::vector<core::Tensor>{};
+    }
+
+    using ModelBase::InferAsync;
+    core::Result<void> InferAsync(std::vector<core::Tensor> inputs, InferCallback callback) override {
+        callback(Infer(inputs));
+        return {};
+    }
+
+    core::BackendType GetBackendType() const override { return core::BackendType::Custom; }
+    size_t GetMemoryUsage() const override { return 0; }
+};
+
+double ResidentMb() {
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0;
+    size_t resident = 0;
+    statm >> pages >> resident;
+    return resident * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    logging::Logger::Instance().SetLevel(logging::LogLevel::Warning);
+    std::cout << std::fixed << std::setprecision(2);
+
+    const auto duration = std::chrono::seconds(argc > 1 ? std::atoi(argv[1]) : 30);
+    constexpr size_t kBatch = 64;
+    constexpr auto kInterval = std::chrono::seconds(2);
+
+    scheduler::SchedulerConfig config;
+    config.num_threads = 2;
+    config.task_timeout = core::Duration::zero();
+    config.result_retention = std::chrono::milliseconds(200);
+    scheduler::Scheduler sched(config);
+    sched.Start();
+    auto model = std::make_shared<NullModel>();
+
+    std::atomic<size_t> callbacks{0};
+    std::vector<scheduler::TaskId> waited;
+    waited.reserve(kBatch);
+
+    const auto start = Clock::now();
+    auto report_at = start + kInterval;
+    size_t tasks = 0;
+    size_t interval_tasks = 0;
+    unsigned long long interval_allocations = g_allocations.load();
+
+    std::cout << "   time   tasks/s   allocs/task   RSS MB   tracked" << std::endl;
+    while (Clock::now() - start < duration) {
+        for (size_t i = 0; i < kBatch; ++i) {
+            auto id = sched.SubmitTask(model, {}, core::Priority::Normal,
+                [&callbacks](const scheduler::TaskResult&) { callbacks.fetch_add(1, std::memory_order_relaxed); });
+            if (id && i % 2 == 0) waited.push_back(*id);
+        }
+        for (auto id : waited) {
+            sched.WaitForTask(id);
+        }
+        waited.clear();
+        tasks += kBatch;
+        interval_tasks += kBatch;
+
+        const auto now = Clock::now();
+        if (now >= report_at) {
+            const auto allocations = g_allocations.load();
+            const double seconds = std::chrono::duration<double>(now - start).count();
+            std::cout << std::setw(6) << seconds << "s"
+                      << std::setw(10) << static_cast<size_t>(interval_tasks / std::chrono::duration<double>(kInterval).count())
+                      << std::setw(14) << static_cast<double>(allocations - interval_allocations) / interval_tasks
+                      << std::setw(9) << ResidentMb()
+                      << std::setw(10) << sched.GetTrackedTaskCount() << std::endl;
+            interval_allocations = g_allocations.load();
+            interval_tasks = 0;
+            report_at += kInterval;
+        }
+    }
+
+    sched.Stop();
+    std::cout << tasks << " tasks, " << callbacks.load() << " callbacks" << std::endl;
+    return 0;
+}
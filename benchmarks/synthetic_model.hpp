@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atom/core/model_interface.hpp>
+#include <atom/inference/backend.hpp>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// Stand-ins for a device-backed model, shared by the benchmarks
+
+namespace atom::bench {
+
+// Backend that takes a fixed time per Execute, like a device would, and
+// returns its inputs
+class SyntheticBackend : public inference::IBackend {
+public:
+    explicit SyntheticBackend(std::chrono::microseconds latency) : latency_(latency) {}
+    ~SyntheticBackend() override { DrainAsync(); }
+
+    core::Result<void> Initialize(const core::DeviceInfo&) override { return {}; }
+    void Shutdown() override { DrainAsync(); }
+    core::Result<void> LoadModel(const std::string&) override { return {}; }
+    void UnloadModel() override {}
+
+    core::Result<std::vector<core::Tensor>> Execute(
+        const std::vector<core::Tensor>& inputs) override {
+        std::this_thread::sleep_for(latency_);
+        return std::vector<core::Tensor>{inputs};
+    }
+
+    core::BackendType GetType() const override { return core::BackendType::Custom; }
+    bool IsInitialized() const override { return true; }
+    bool IsModelLoaded() const override { return true; }
+    core::Result<void> OptimizeForBatchSize(size_t) override { return {}; }
+    core::Result<void> SetPrecision(core::DataType) override { return {}; }
+
+private:
+    std::chrono::microseconds latency_;
+};
+
+// Model over a SyntheticBackend: Infer blocks for the latency, InferAsync
+// runs on the backend's async workers
+class SyntheticModel : public core::ModelBase {
+public:
+    explicit SyntheticModel(std::chrono::microseconds latency)
+        : ModelBase("Synthetic"), backend_(latency) {
+        device_ = core::DeviceInfo{core::DeviceType::CPU, 0};
+        initialized_ = true;
+    }
+
+    core::Result<void> Initialize(const std::string&, const core::InferenceOptions&) override { return {}; }
+    core::Result<void> Warmup() override { return {}; }
+    void Shutdown() override { backend_.DrainAsync(); }
+
+    core::Result<std::vector<core::Tensor>> Infer(const std::vector<core::Tensor>& inputs) override {
+        return backend_.Execute(inputs);
+    }
+
+    using ModelBase::InferAsync;
+    core::Result<void> InferAsync(std::vector<core::Tensor> inputs, InferCallback callback) override {
+        return backend_.ExecuteAsync(std::move(inputs), std::move(callback));
+    }
+
+    core::BackendType GetBackendType() const override { return core::BackendType::Custom; }
+    size_t GetMemoryUsage() const override { return 0; }
+
+private:
+    SyntheticBackend backend_;
+};
+
+} // namespace atom::bench
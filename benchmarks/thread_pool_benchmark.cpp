@@ -0,0 +1,141 @@
+#include <atom/scheduler/thread_pool.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Tiny-task throughput of the work-stealing ThreadPool against the previous
+// design (one std::queue<std::function> behind a mutex and condition
+// variable), from 1 to 64 threads. "external" posts every task from the
+// main thread; "fork-join" spawns a binary tree of tasks from the workers
+// themselves, which is where per-worker deques pay off.
+
+namespace {
+
+using namespace atom;
+using Clock = std::chrono::steady_clock;
+
+// The pool as it was before work stealing
+class LockedPool {
+public:
+    explicit LockedPool(size_t num_threads) {
+        for (size_t i = 0; i < num_threads; ++i) {
+            workers_.emplace_back([this]() { WorkerThread(); });
+        }
+    }
+
+    ~LockedPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopped_ = true;
+        }
+        condition_.notify_all();
+        for (auto& worker : workers_) worker.join();
+    }
+
+    void Post(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push(std::move(task));
+        }
+        condition_.notify_one();
+    }
+
+    void WaitAll() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wait_condition_.wait(lock, [this]() { return tasks_.empty() && active_ == 0; });
+    }
+
+private:
+    void WorkerThread() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait(lock, [this]() { return stopped_ || !tasks_.empty(); });
+                if (stopped_ && tasks_.empty()) return;
+                task = std::move(tasks_.front());
+                tasks_.pop();
+                ++active_;
+            }
+            task();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                --active_;
+            }
+            wait_condition_.notify_all();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::condition_variable wait_condition_;
+    size_t active_{0};
+    bool stopped_{false};
+};
+
+constexpr size_t kExternalTasks = 200000;
+constexpr int kTreeDepth = 17;          // 2^18 - 1 tasks
+
+template<typename Pool>
+void Spawn(Pool& pool, std::atomic<size_t>& leaves, int depth) {
+    if (depth == 0) {
+        leaves.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    pool.Post([&pool, &leaves, depth]() { Spawn(pool, leaves, depth - 1); });
+    pool.Post([&pool, &leaves, depth]() { Spawn(pool, leaves, depth - 1); });
+}
+
+// Million tasks per second
+template<typename Pool>
+double External(size_t threads) {
+    Pool pool(threads);
+    std::atomic<size_t> counter{0};
+    auto start = Clock::now();
+    for (size_t i = 0; i < kExternalTasks; ++i) {
+        pool.Post([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+    }
+    pool.WaitAll();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (counter.load() != kExternalTasks) std::cerr << "lost tasks" << std::endl;
+    return kExternalTasks / seconds / 1e6;
+}
+
+template<typename Pool>
+double ForkJoin(size_t threads) {
+    Pool pool(threads);
+    std::atomic<size_t> leaves{0};
+    auto start = Clock::now();
+    pool.Post([&pool, &leaves]() { Spawn(pool, leaves, kTreeDepth); });
+    pool.WaitAll();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    const size_t tasks = (size_t{2} << kTreeDepth) - 1;
+    if (leaves.load() != (size_t{1} << kTreeDepth)) std::cerr << "lost tasks" << std::endl;
+    return tasks / seconds / 1e6;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+    std::cout << "Mtasks/s      external            fork-join" << std::endl;
+    std::cout << "threads   locked   stealing   locked   stealing" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (size_t threads = 1; threads <= 64; threads *= 2) {
+        std::cout << std::setw(7) << threads
+                  << std::setw(9) << External<LockedPool>(threads)
+                  << std::setw(11) << External<scheduler::ThreadPool>(threads)
+                  << std::setw(9) << ForkJoin<LockedPool>(threads)
+                  << std::setw(11) << ForkJoin<scheduler::ThreadPool>(threads) << std::endl;
+    }
+    return 0;
+}
@@ -2,9 +2,14 @@
 #include <atom/scheduler/scheduler.hpp>
 #include <atom/data/preprocessor.hpp>
 #include <atom/logging/logger.hpp>
+#include "../models/detection/yolo/yolov8_postprocess.hpp"
+#include "../models/tracking/byte_tracker.hpp"
 #include <opencv2/opencv.hpp>
+#include <algorithm>
 #include <iostream>
 #include <chrono>
+#include <deque>
+#include <optional>
 
 int main(int argc, char** argv) {
     using namespace atom;
@@ -62,6 +67,48 @@ int main(int argc, char** argv) {
         preprocess_config.target_size = cv::Size(640, 640);
         data::Preprocessor preprocessor(preprocess_config);
         
+        // Detect on the frames the tracker asks for (at most every 5th
+        // frame here), follow objects by motion prediction in between
+        models::YOLOv8Postprocessor postprocessor;
+        models::TrackerConfig tracker_config;
+        tracker_config.max_interval = 5;
+        models::ByteTracker tracker(tracker_config);
+        
+        // Frames are pipelined: up to kMaxInFlight are submitted before the
+        // oldest is handed to the tracker, in order. An entry without a task
+        // is a frame the tracker only predicts.
+        constexpr size_t kMaxInFlight = 3;
+        std::deque<std::optional<scheduler::TaskId>> in_flight;
+        core::u32 frames_since_detection = 0;
+        
+        auto track_oldest = [&]() {
+            const auto task_id = in_flight.front();
+            in_flight.pop_front();
+            if (!task_id) {
+                tracker.Predict();
+                return;
+            }
+            // A failed detection is not an empty scene: predict rather than
+            // report every track as lost
+            auto result = sched.WaitForTask(*task_id);
+            if (!result || result->status != scheduler::TaskStatus::Completed) {
+                const std::string reason = !result ? result.error().message
+                    : result->error ? result->error->message : "task did not complete";
+                LOG_WARNING("Detection failed: " + reason);
+                tracker.Predict();
+                return;
+            }
+            auto batch = postprocessor.Process(result->outputs);
+            if (!batch) {
+                LOG_WARNING("Postprocessing failed: " + batch.error().message);
+                tracker.Predict();
+                return;
+            }
+            // Boxes stay in network input coordinates; the tracker only needs them consistent
+            const auto tracks = tracker.Update(batch->detections);
+            LOG_DEBUG(std::to_string(tracks.size()) + " tracks");
+        };
+        
         // Process video frames
         cv::Mat frame;
         int frame_count = 0;
@@ -70,37 +117,50 @@ int main(int argc, char** argv) {
         while (cap.read(frame)) {
             frame_count++;
             
+            // Report throughput every 30 frames
+            if (frame_count % 30 == 0) {
+                auto now = std::chrono::high_resolution_clock::now();
+                auto elapsed = std::chrono::duration<double>(now - start_time).count();
+                double fps = frame_count / elapsed;
+                LOG_INFO("Processed " + std::to_string(frame_count) + 
+                        " frames, FPS: " + std::to_string(fps));
+            }
+            
+            if (in_flight.size() == kMaxInFlight) {
+                track_oldest();
+            }
+            
+            // The tracker lags the frames in flight, so its NeedsDetection()
+            // is only trusted while no detection is pending; max_interval
+            // still bounds the gap between detections
+            frames_since_detection++;
+            const bool detect = frames_since_detection >= tracker_config.max_interval ||
+                (tracker.NeedsDetection() &&
+                 std::none_of(in_flight.begin(), in_flight.end(), [](const auto& id) { return id.has_value(); }));
+            if (!detect) {
+                in_flight.push_back(std::nullopt);
+                continue;
+            }
+            
             // Preprocess frame
             auto tensor = preprocessor.PreprocessImage(frame);
             if (!tensor) {
                 LOG_WARNING("Failed to preprocess frame " + std::to_string(frame_count));
+                in_flight.push_back(std::nullopt);
                 continue;
             }
             
-            // Submit inference task
-            auto task_id = sched.SubmitTask(
-                *model,
-                {*tensor},
-                core::Priority::Normal,
-                [frame_count](const scheduler::TaskResult& result) {
-                    if (result.status == scheduler::TaskStatus::Completed) {
-                        LOG_DEBUG("Frame " + std::to_string(frame_count) + " processed");
-                    }
-                }
-            );
-            
+            auto task_id = sched.SubmitTask(*model, {*tensor}, core::Priority::Normal);
             if (!task_id) {
                 LOG_WARNING("Failed to submit task for frame " + std::to_string(frame_count));
+                in_flight.push_back(std::nullopt);
+                continue;
             }
-            
-            // Limit to 30 FPS
-            if (frame_count % 30 == 0) {
-                auto now = std::chrono::high_resolution_clock::now();
-                auto elapsed = std::chrono::duration<double>(now - start_time).count();
-                double fps = frame_count / elapsed;
-                LOG_INFO("Processed " + std::to_string(frame_count) + 
-                        " frames, FPS: " + std::to_string(fps));
-            }
+            in_flight.push_back(*task_id);
+            frames_since_detection = 0;
+        }
+        while (!in_flight.empty()) {
+            track_oldest();
         }
         
         auto end_time = std::chrono::high_resolution_clock::now();
@@ -109,6 +169,7 @@ int main(int argc, char** argv) {
         
         LOG_INFO("Total frames processed: " + std::to_string(frame_count));
         LOG_INFO("Average FPS: " + std::to_string(fps));
+        LOG_INFO("Detected frames: " + std::to_string(tracker.GetStats().detected_frames));
         
         // Cleanup
         sched.Stop();
@@ -4,6 +4,7 @@
 #include <map>
 #include <any>
 #include <mutex>
+#include <shared_mutex>
 #include <filesystem>
 
 namespace atom::core {
@@ -54,6 +55,8 @@ public:
     static constexpr const char* KEY_ENABLE_PROFILING = "profiling.enabled";
     static constexpr const char* KEY_LOG_LEVEL = "logging.level";
     static constexpr const char* KEY_CUDA_DEVICE = "cuda.device_id";
+    static constexpr const char* KEY_PLAN_CACHE_DIR = "inference.plan_cache_dir";
+    static constexpr const char* KEY_CPU_THREADS = "inference.cpu_threads";
     
 private:
     Config() = default;
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "types.hpp"
+#include <string>
+
+namespace atom::core {
+
+// Read-only memory mapping of a whole file. Pages are loaded on first touch,
+// so opening is cheap regardless of file size and the page cache is shared
+// between processes mapping the same file.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    
+    static Result<MappedFile> Open(const std::string& path);
+    
+    const byte_t* GetData() const { return data_; }
+    size_t GetSize() const { return size_; }
+    bool IsOpen() const { return data_ != nullptr; }
+    
+    void Close();
+    
+private:
+    const byte_t* data_{nullptr};
+    size_t size_{0};
+};
+
+} // namespace atom::core
@@ -4,13 +4,18 @@
 #include "tensor.hpp"
 #include <vector>
 #include <string>
+#include <algorithm>
 #include <memory>
+#include <functional>
+#include <future>
 
 namespace atom::core {
 
 // Base interface for all AI models
 class IModel {
 public:
+    using InferCallback = std::function<void(Result<std::vector<Tensor>>)>;
+    
     virtual ~IModel() = default;
     
     // Model lifecycle
@@ -20,7 +25,12 @@ public:
     
     // Inference
     virtual Result<std::vector<Tensor>> Infer(const std::vector<Tensor>& inputs) = 0;
-    virtual Result<std::vector<Tensor>> InferAsync(const std::vector<Tensor>& inputs) = 0;
+    
+    // Asynchronous inference: returns as soon as the request is queued.
+    // The callback runs on a backend worker thread and is not invoked if
+    // submission itself fails.
+    virtual std::future<Result<std::vector<Tensor>>> InferAsync(std::vector<Tensor> inputs) = 0;
+    virtual Result<void> InferAsync(std::vector<Tensor> inputs, InferCallback callback) = 0;
     
     // Metadata
     virtual ModelMetadata GetMetadata() const = 0;
@@ -52,6 +62,23 @@ public:
     
     ModelMetadata GetMetadata() const override { return metadata_; }
     
+    // Future-based async inference on top of the callback form
+    std::future<Result<std::vector<Tensor>>> InferAsync(std::vector<Tensor> inputs) override {
+        auto promise = std::make_shared<std::promise<Result<std::vector<Tensor>>>>();
+        auto future = promise->get_future();
+        
+        auto submitted = InferAsync(std::move(inputs), [promise](Result<std::vector<Tensor>> result) {
+            promise->set_value(std::move(result));
+        });
+        if (!submitted) {
+            promise->set_value(std::unexpected(submitted.error()));
+        }
+        
+        return future;
+    }
+    
+    Result<void> InferAsync(std::vector<Tensor> inputs, InferCallback callback) override = 0;
+    
     bool ValidateInputs(const std::vector<Tensor>& inputs) const override {
         const auto& expected_shapes = metadata_.input_shapes;
         const auto& expected_types = metadata_.input_types;
@@ -64,13 +91,31 @@ public:
             if (inputs[i].GetDataType() != expected_types[i]) {
                 return false;
             }
-            // Allow dynamic batch size (first dimension can vary)
+            // Allow dynamic batch size (first dimension can vary), and with
+            // shape buckets any spatial size that fits a bucket resolution
             const auto& input_shape = inputs[i].GetShape();
             const auto& expected_shape = expected_shapes[i];
             if (input_shape.size() != expected_shape.size()) {
                 return false;
             }
-            for (size_t j = 1; j < input_shape.size(); ++j) {
+            if (!shape_buckets_.batch_sizes.empty() && !input_shape.empty() &&
+                input_shape[0] > *std::max_element(shape_buckets_.batch_sizes.begin(),
+                                                   shape_buckets_.batch_sizes.end())) {
+                return false;
+            }
+            size_t fixed_dims = input_shape.size();
+            if (!shape_buckets_.resolutions.empty() && input_shape.size() == 4) {
+                const bool fits = std::any_of(shape_buckets_.resolutions.begin(), shape_buckets_.resolutions.end(),
+                    [&](const auto& r) {
+                        return input_shape[2] > 0 && input_shape[3] > 0 &&
+                               input_shape[2] <= r.first && input_shape[3] <= r.second;
+                    });
+                if (!fits) {
+                    return false;
+                }
+                fixed_dims = 2;
+            }
+            for (size_t j = 1; j < fixed_dims; ++j) {
                 if (input_shape[j] != expected_shape[j]) {
                     return false;
                 }
@@ -86,6 +131,7 @@ protected:
     bool initialized_;
     DeviceInfo device_{DeviceType::CUDA, 0};
     ModelMetadata metadata_;
+    ShapeBucketOptions shape_buckets_;   // set by models that serve shape buckets
 };
 
 // Smart pointer type for models
@@ -19,7 +19,8 @@ public:
     void Shutdown() override;
     
     Result<std::vector<Tensor>> Infer(const std::vector<Tensor>& inputs) override;
-    Result<std::vector<Tensor>> InferAsync(const std::vector<Tensor>& inputs) override;
+    std::future<Result<std::vector<Tensor>>> InferAsync(std::vector<Tensor> inputs) override;
+    Result<void> InferAsync(std::vector<Tensor> inputs, InferCallback callback) override;
     
     ModelMetadata GetMetadata() const override;
     std::string GetName() const override;
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "types.hpp"
+#include <string>
+#include <vector>
+
+namespace atom::core {
+
+// How worker threads are bound to CPUs
+enum class AffinityPolicy {
+    None,           // float freely (the OS decides)
+    NumaNode,       // workers split into per-node groups, each free within its node
+    Core            // one CPU per worker, filled node by node
+};
+
+struct NumaNode {
+    int id;
+    std::vector<int> cpus;          // usable by this process
+};
+
+// CPUs and node id for one worker; node -1 and no CPUs = unbound
+struct WorkerPlacement {
+    int node{-1};
+    std::vector<int> cpus;
+};
+
+// NUMA nodes of the machine, read from sysfs
+// (/sys/devices/system/node/node*/cpulist) and restricted to the CPUs this
+// process may run on. Without sysfs, or with NUMA disabled, it is a single
+// node 0 holding every usable CPU.
+class NumaTopology {
+public:
+    static const NumaTopology& Instance();
+
+    static NumaTopology Detect(const std::string& sysfs_root = "/sys/devices/system/node");
+
+    const std::vector<NumaNode>& GetNodes() const { return nodes_; }
+    size_t GetNodeCount() const { return nodes_.size(); }
+    bool IsNuma() const { return nodes_.size() > 1; }
+    size_t GetCpuCount() const;
+
+    // -1 if the CPU is not usable
+    int NodeOfCpu(int cpu) const;
+
+    // Placements for count workers, sorted by node so each node's workers
+    // are contiguous. Workers are spread over nodes by CPU count; node >= 0
+    // keeps them all on that node.
+    std::vector<WorkerPlacement> PlaceWorkers(size_t count, AffinityPolicy policy, int node = -1) const;
+
+private:
+    std::vector<NumaNode> nodes_;
+    std::vector<int> cpu_to_node_;
+};
+
+// Binds the calling thread to the CPUs; node becomes its home node for
+// allocations. Empty cpus leaves the thread unbound.
+Result<void> PinCurrentThread(const WorkerPlacement& placement);
+
+// The calling thread's home node if it was pinned to one, else the node of
+// the CPU it is running on; 0 on a single-node machine
+int CurrentNumaNode();
+
+// Node holding the page at addr (faulting it in), -1 if unknown
+int NumaNodeOfAddress(const void* addr);
+
+// Host memory whose pages prefer the given node, page aligned; release with
+// std::free. Falls back to plain malloc when the node cannot be bound.
+void* AllocateOnNode(size_t bytes, int node);
+
+} // namespace atom::core
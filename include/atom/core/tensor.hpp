@@ -45,6 +45,11 @@ public:
     // Reshape (no data copy)
     Result<void> Reshape(Shape new_shape);
     
+    // Batch dimension (dim 0) helpers. All tensors must agree on the
+    // remaining dimensions, data type and device.
+    static Result<Tensor> ConcatBatch(std::span<const Tensor* const> tensors);
+    Result<std::vector<Tensor>> SplitBatch(std::span<const i64> batch_sizes) const;
+    
     // Data access with type checking
     template<typename T>
     Result<T*> GetDataAs() {
@@ -9,6 +9,7 @@
 #include <expected>
 #include <chrono>
 #include <span>
+#include <utility>
 
 namespace atom::core {
 
@@ -141,6 +142,37 @@ enum class BackendType {
     Custom
 };
 
+// Load-time backend and kernel selection by micro-benchmark
+struct AutotuneOptions {
+    bool enabled{false};
+    std::vector<size_t> batch_sizes{1};
+    Duration budget{std::chrono::seconds(2)};   // measuring time per model
+    std::string cache_path{"atom_tuning.cache"};
+};
+
+// Host threads one inference may use. Intra-op threads split a large
+// operator; inter-op threads run independent graph branches at once. Fewer
+// per request leaves more of the shared pool to concurrent requests.
+struct ThreadingOptions {
+    size_t intra_op_threads{0};    // 0 = every compute thread
+    size_t inter_op_threads{1};
+
+    bool operator==(const ThreadingOptions&) const = default;
+};
+
+// Input shapes a model is compiled for. Requests are padded up to the
+// smallest bucket that holds them (batch x resolution) and each bucket gets
+// its own backend plan, built on first use. Empty batch_sizes and
+// resolutions disable bucketing.
+struct ShapeBucketOptions {
+    std::vector<i64> batch_sizes;                      // e.g. {1, 2, 4, 8, 16}
+    std::vector<std::pair<i64, i64>> resolutions;      // {height, width} of NCHW inputs
+    size_t max_plans{0};                               // resident bucket plans, 0 = unlimited
+    f32 pad_value{0.0f};
+
+    bool IsEnabled() const { return !batch_sizes.empty() || !resolutions.empty(); }
+};
+
 // Inference options
 struct InferenceOptions {
     DeviceInfo device{DeviceType::CUDA, 0};
@@ -148,6 +180,10 @@ struct InferenceOptions {
     std::optional<Duration> timeout;
     bool enable_profiling{false};
     std::optional<size_t> batch_size;
+    size_t execution_contexts{1};  // concurrent Execute calls per loaded model
+    AutotuneOptions autotune;
+    ThreadingOptions threading;
+    ShapeBucketOptions shape_buckets;
 };
 
 } // namespace atom::core
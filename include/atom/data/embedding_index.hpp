@@ -0,0 +1,104 @@
+#pragma once
+
+#include "../core/mapped_file.hpp"
+#include "../core/tensor.hpp"
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace atom::data {
+
+enum class EmbeddingMetric {
+    Cosine,         // vectors and queries are L2-normalized on the way in
+    InnerProduct
+};
+
+struct EmbeddingIndexConfig {
+    atom::core::i64 dimension{0};                 // 0 = taken from the first Add
+    atom::core::DataType storage{atom::core::DataType::Float32};   // Float32 or Int8
+    EmbeddingMetric metric{EmbeddingMetric::Cosine};
+
+    // IVF: with partitions > 0, Train() clusters the vectors and searches
+    // scan only the `probes` partitions closest to the query
+    atom::core::u32 partitions{0};
+    atom::core::u32 probes{8};
+    atom::core::u32 training_iterations{10};
+    atom::core::u32 training_samples{64};         // per partition
+};
+
+struct SearchHit {
+    atom::core::u64 id;
+    atom::core::f32 score;                        // higher is closer
+};
+
+// In-process vector index for model embeddings (re-identification,
+// deduplication). Vectors are kept in one row-major block, padded to a
+// whole number of SIMD registers, as float32 or as int8 with a scale per
+// vector. Search is exact top-k over everything, or over the probed IVF
+// partitions once trained; dot products use AVX2 / AVX-512 kernels and the
+// scan is split across the compute pool. Save() writes a file that Load()
+// maps instead of reading, so a large index opens instantly.
+//
+// Searches may run concurrently; Add and Train wait for them.
+class EmbeddingIndex {
+public:
+    explicit EmbeddingIndex(EmbeddingIndexConfig config = {});
+
+    EmbeddingIndex(EmbeddingIndex&& other) noexcept;
+    EmbeddingIndex& operator=(EmbeddingIndex&& other) noexcept;
+
+    // One row per vector: [N, D], or pooled features such as [N, D, 1, 1].
+    // `ids` gives one id per row; empty means consecutive ids from Size().
+    atom::core::Result<void> Add(const atom::core::Tensor& embeddings, std::span<const atom::core::u64> ids = {});
+    atom::core::Result<void> Add(std::span<const atom::core::f32> embedding, atom::core::u64 id);
+
+    // Builds the IVF partitions (k-means on a sample) and assigns every vector;
+    // vectors added later join their closest partition
+    atom::core::Result<void> Train();
+    bool IsTrained() const { return !centroids_.empty(); }
+
+    // Best k per query, best first; queries are rows like in Add.
+    // hits holds queries * k entries, padded with id ~0 and score -inf.
+    atom::core::Result<void> Search(const atom::core::Tensor& queries, size_t k, std::vector<SearchHit>& hits) const;
+    atom::core::Result<std::vector<SearchHit>> Search(std::span<const atom::core::f32> query, size_t k) const;
+
+    atom::core::Result<void> Save(const std::string& path) const;
+    // A `dimension` > 0 is the one the caller's embeddings have: a file of
+    // any other dimension is refused rather than failing every later search
+    static atom::core::Result<EmbeddingIndex> Load(const std::string& path, atom::core::i64 dimension = 0);
+
+    size_t Size() const { return count_; }
+    atom::core::i64 Dimension() const { return config_.dimension; }
+    const EmbeddingIndexConfig& GetConfig() const { return config_; }
+    size_t GetMemoryUsage() const;
+
+private:
+    EmbeddingIndexConfig config_;
+    atom::core::i64 padded_{0};                   // row length in elements
+    size_t count_{0};
+
+    // Rows, scales and ids live in the owned vectors, or in mapping_ after
+    // Load until the first Add copies them out
+    std::vector<atom::core::byte_t> owned_rows_;
+    std::vector<atom::core::f32> owned_scales_;
+    std::vector<atom::core::u64> owned_ids_;
+    atom::core::MappedFile mapping_;
+    const atom::core::byte_t* rows_{nullptr};
+    const atom::core::f32* scales_{nullptr};
+    const atom::core::u64* ids_{nullptr};
+
+    std::vector<atom::core::f32> centroids_;      // partitions x padded_
+    std::vector<std::vector<atom::core::u32>> lists_;   // rows per partition
+
+    mutable std::shared_mutex mutex_;
+
+    size_t RowBytes() const;
+    void Materialize();
+    void Append(const atom::core::f32* vector, atom::core::u64 id);
+    void PrepareQuery(const atom::core::f32* query, atom::core::f32* padded, atom::core::i16* codes,
+                      atom::core::f32& scale) const;
+    atom::core::u32 NearestPartition(const atom::core::f32* padded) const;
+};
+
+} // namespace atom::data
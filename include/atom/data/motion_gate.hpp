@@ -0,0 +1,117 @@
+#pragma once
+
+#include "roi_align.hpp"
+#include "../logging/metrics.hpp"
+#include <string>
+#include <vector>
+
+namespace atom::data {
+
+struct MotionGateConfig {
+    int scale{4};                                // luma plane is the frame subsampled by this
+    int block_size{8};                           // luma pixels per block side, rounded up to a multiple of 8
+    atom::core::f32 pixel_threshold{6.0f};       // mean absolute luma difference that marks a block changed
+    atom::core::f32 min_changed_fraction{0.0f};  // changed blocks (share of all) tolerated as noise
+    atom::core::u32 max_skip_frames{300};        // re-infer at least this often, 0 = never forced
+
+    // Localized motion: re-infer only regions of changed blocks, while they
+    // cover at most max_region_fraction of the frame
+    bool enable_regions{false};
+    int region_margin{1};                        // blocks added around each region
+    atom::core::f32 max_region_fraction{0.3f};
+
+    // When set, frame counts and the saved-compute share are also published
+    // to MetricsRegistry as <metrics_name>.frames, .skipped_frames,
+    // .region_frames, .full_frames, .skip_rate and .saved_fraction
+    std::string metrics_name;
+};
+
+enum class MotionAction {
+    Skip,       // nothing changed: reuse the previous results
+    Regions,    // re-infer `regions` only
+    Full        // re-infer the whole frame
+};
+
+struct MotionDecision {
+    MotionAction action{MotionAction::Full};
+    atom::core::f32 changed_fraction{0.0f};      // share of blocks that changed
+    std::vector<RoiBox> regions;                 // frame pixels, with Regions
+};
+
+struct MotionGateStats {
+    atom::core::u64 frames{0};
+    atom::core::u64 skipped{0};
+    atom::core::u64 region_frames{0};
+    atom::core::u64 full_frames{0};
+    atom::core::f64 inferred_area{0.0};          // frames' worth of pixels sent to inference
+
+    double SkipRate() const {
+        return frames == 0 ? 0.0 : static_cast<double>(skipped) / static_cast<double>(frames);
+    }
+    // Share of per-frame inference avoided, counting regions by their area
+    double SavedFraction() const {
+        return frames == 0 ? 0.0 : 1.0 - inferred_area / static_cast<double>(frames);
+    }
+};
+
+// Cheap change detector for the front of a per-camera pipeline. Each frame
+// is reduced to a downscaled luma plane and compared with the plane of the
+// last inferred frame by block-wise SAD (AVX2 where available); the result
+// says whether the frame needs inference at all, only in a few regions, or
+// in full. The reference is updated with whatever the caller is told to
+// infer, so slow drift still adds up to a change. The first frame and any
+// frame-size change are always Full. One gate per stream; not thread-safe.
+class MotionGate {
+public:
+    explicit MotionGate(MotionGateConfig config = {});
+
+    // `frame` is 8-bit, 3-channel; `decision` is reused between calls
+    atom::core::Result<void> Evaluate(const cv::Mat& frame, MotionDecision& decision);
+
+    void Reset();
+
+    const MotionGateConfig& GetConfig() const { return config_; }
+    const MotionGateStats& GetStats() const { return stats_; }
+    void ResetStats() { stats_ = {}; }
+
+private:
+    // Registry metrics, null when the gate is not published
+    struct Metrics {
+        atom::logging::Counter* frames{nullptr};
+        atom::logging::Counter* skipped{nullptr};
+        atom::logging::Counter* region_frames{nullptr};
+        atom::logging::Counter* full_frames{nullptr};
+        atom::logging::Gauge* skip_rate{nullptr};
+        atom::logging::Gauge* saved_fraction{nullptr};
+    };
+
+    MotionGateConfig config_;
+    MotionGateStats stats_;
+    Metrics metrics_;
+    atom::core::u32 frames_since_inference_{0};
+
+    atom::core::i64 frame_width_{0};
+    atom::core::i64 frame_height_{0};
+    atom::core::i64 scale_{1};                   // config scale, capped at the frame's smaller side
+    atom::core::i64 plane_width_{0};
+    atom::core::i64 plane_height_{0};
+    atom::core::i64 plane_stride_{0};            // multiple of 32, zero padded
+    atom::core::i64 blocks_x_{0};
+    atom::core::i64 blocks_y_{0};
+
+    std::vector<atom::core::u8> reference_;
+    std::vector<atom::core::u8> current_;
+    std::vector<atom::core::u32> chunk_sums_;    // SAD per 8 luma columns of a block row
+    std::vector<atom::core::u8> changed_;        // per block
+    std::vector<atom::core::i32> labels_;        // per block, for region grouping
+    std::vector<atom::core::i32> stack_;
+
+    void Configure(const cv::Mat& frame);
+    void ComputeLuma(const cv::Mat& frame);
+    atom::core::i64 MarkChangedBlocks();
+    atom::core::f32 CollectRegions(std::vector<RoiBox>& regions);
+    void CommitBlocks(const std::vector<RoiBox>& regions);
+    void Record(MotionAction action, atom::core::f64 area);
+};
+
+} // namespace atom::data
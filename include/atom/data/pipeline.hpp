@@ -1,8 +1,9 @@
 #pragma once
 
-#include "queue.hpp"
+#include "ring_queue.hpp"
 #include "preprocessor.hpp"
 #include "../core/types.hpp"
+#include "../core/numa.hpp"
 #include <thread>
 #include <atomic>
 #include <functional>
@@ -22,12 +23,24 @@ public:
         , input_queue_(1000)
         , output_queue_(1000) {}
     
+    // Pins the workers of the next Start; node >= 0 keeps them on that NUMA
+    // node, e.g. the one whose scheduler workers consume the stage's output
+    void SetAffinity(atom::core::AffinityPolicy policy, int node = -1) {
+        affinity_ = policy;
+        affinity_node_ = node;
+    }
+    
     void Start() {
         if (running_) return;
         running_ = true;
         
+        auto placements = atom::core::NumaTopology::Instance().PlaceWorkers(num_workers_, affinity_, affinity_node_);
         for (size_t i = 0; i < num_workers_; ++i) {
-            workers_.emplace_back([this]() { WorkerLoop(); });
+            workers_.emplace_back([this, placement = std::move(placements[i])]() {
+                // Best effort: a worker that cannot be pinned runs anyway
+                static_cast<void>(atom::core::PinCurrentThread(placement));
+                WorkerLoop();
+            });
         }
     }
     
@@ -60,10 +73,12 @@ private:
     std::string name_;
     TransformFunc transform_;
     size_t num_workers_;
+    atom::core::AffinityPolicy affinity_{atom::core::AffinityPolicy::None};
+    int affinity_node_{-1};
     std::atomic<bool> running_{false};
     
-    ThreadSafeQueue<InputT> input_queue_;
-    ThreadSafeQueue<OutputT> output_queue_;
+    MpmcQueue<InputT> input_queue_;
+    MpmcQueue<OutputT> output_queue_;
     std::vector<std::thread> workers_;
     
     void WorkerLoop() {
@@ -0,0 +1,326 @@
+#pragma once
+
+#include "../core/types.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace atom::data {
+
+namespace detail {
+
+// Blocks while word == expected, for at most timeout. May return early.
+inline void FutexWait(std::atomic<atom::core::u32>& word, atom::core::u32 expected,
+                      std::optional<atom::core::Duration> timeout) {
+#if defined(__linux__)
+    timespec ts{};
+    if (timeout) {
+        const auto ns = std::max<atom::core::i64>(timeout->count(), 0);
+        ts.tv_sec = static_cast<time_t>(ns / 1'000'000'000);
+        ts.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+    }
+    syscall(SYS_futex, reinterpret_cast<atom::core::u32*>(&word), FUTEX_WAIT_PRIVATE, expected,
+            timeout ? &ts : nullptr, nullptr, 0);
+#else
+    if (!timeout) {
+        word.wait(expected, std::memory_order_acquire);
+    } else if (word.load(std::memory_order_acquire) == expected) {
+        std::this_thread::sleep_for(std::min<atom::core::Duration>(*timeout, std::chrono::milliseconds(1)));
+    }
+#endif
+}
+
+inline void FutexWake(std::atomic<atom::core::u32>& word, bool all) {
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<atom::core::u32*>(&word), FUTEX_WAKE_PRIVATE, all ? INT_MAX : 1,
+            nullptr, nullptr, 0);
+#else
+    all ? word.notify_all() : word.notify_one();
+#endif
+}
+
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+} // namespace detail
+
+// Bounded lock-free ring with the blocking semantics of ThreadSafeQueue:
+// Push waits while full, Pop while empty, both optionally with a timeout,
+// and after Stop() Push fails while Pop drains what is left. Slots carry
+// Vyukov-style sequence numbers, so producers and consumers only contend
+// on their own cache-line-padded index; a thread spins briefly and then
+// parks on a futex only when the ring is full (producers) or empty
+// (consumers), and the other side pays for a wake-up only when someone is
+// actually parked.
+//
+// SingleProducerConsumer drops the index CAS loops for links with exactly
+// one pushing and one popping thread. Capacity is rounded up to a power
+// of two.
+template<typename T, bool SingleProducerConsumer = false>
+class RingQueue {
+public:
+    explicit RingQueue(size_t capacity = 1024) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        mask_ = size - 1;
+        cells_ = std::make_unique<Cell[]>(size);
+        for (size_t i = 0; i < size; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~RingQueue() {
+        Clear();
+    }
+
+    RingQueue(const RingQueue&) = delete;
+    RingQueue& operator=(const RingQueue&) = delete;
+
+    bool Push(T item, std::optional<atom::core::Duration> timeout = std::nullopt) {
+        const auto deadline = Deadline(timeout);
+        bool parked = false;
+        while (true) {
+            for (int spin = 0; spin < kSpinCount; ++spin) {
+                const Status status = TryPush(item);
+                if (status == Status::Ok && parked) PassWake(not_full_, HasSpace());
+                if (status != Status::Full) return status == Status::Ok;
+                detail::CpuRelax();
+            }
+            if (!Park(not_full_, deadline, [this]() { return HasSpace(); })) {
+                return false;   // Timeout
+            }
+            parked = true;
+        }
+    }
+
+    std::optional<T> Pop(std::optional<atom::core::Duration> timeout = std::nullopt) {
+        const auto deadline = Deadline(timeout);
+        bool parked = false;
+        while (true) {
+            for (int spin = 0; spin < kSpinCount; ++spin) {
+                if (auto item = TryPop()) {
+                    if (parked) PassWake(not_empty_, HasItems());
+                    return item;
+                }
+                // Stopped: drain, including slots claimed before Stop() but
+                // not filled yet
+                if (stopped_.load() && !HasItems()) return std::nullopt;
+                detail::CpuRelax();
+            }
+            if (!Park(not_empty_, deadline, [this]() { return HasItems(); })) {
+                return std::nullopt;   // Timeout
+            }
+            parked = true;
+        }
+    }
+
+    size_t Size() const {
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        const size_t head = head_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    bool Empty() const { return Size() == 0; }
+    size_t Capacity() const { return mask_ + 1; }
+
+    void Stop() {
+        stopped_.store(true);
+        for (Waiters* waiters : {&not_empty_, &not_full_}) {
+            waiters->epoch.fetch_add(1, std::memory_order_release);
+            detail::FutexWake(waiters->epoch, true);
+        }
+    }
+
+    void Clear() {
+        while (TryPop()) {}
+    }
+
+private:
+    enum class Status { Ok, Full, Stopped };
+
+    static constexpr int kSpinCount = 64;
+    static constexpr size_t kCacheLine = 64;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        bool valid{false};   // false: claimed after Stop() and left empty
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* Item() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    // Threads parked on one condition (not empty / not full). At most one
+    // wake-up is in flight: the woken thread passes it on if the condition
+    // still holds, so a burst of pops wakes a parked producer once instead
+    // of once per pop.
+    struct Waiters {
+        alignas(kCacheLine) std::atomic<atom::core::u32> epoch{0};
+        std::atomic<atom::core::u32> waiting{0};
+        std::atomic<bool> wake_pending{false};
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    static std::optional<Clock::time_point> Deadline(std::optional<atom::core::Duration> timeout) {
+        if (!timeout) return std::nullopt;
+        return Clock::now() + *timeout;
+    }
+
+    // The seq_cst claim of an index followed by a seq_cst load of the other
+    // side's waiter count pairs with Park(): either the claimer sees the
+    // waiter and wakes it, or the waiter sees the claim and does not sleep.
+    // The same ordering against stopped_ guarantees that a Push returning
+    // true is seen by every Pop that returns nullopt after Stop().
+    Status TryPush(T& item) {
+        if (stopped_.load(std::memory_order_relaxed)) return Status::Stopped;
+
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells_[pos & mask_];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0) {
+                if constexpr (SingleProducerConsumer) {
+                    tail_.store(pos + 1, std::memory_order_seq_cst);
+                    break;
+                } else if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_seq_cst,
+                                                       std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return Status::Full;
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+
+        const bool stopped = stopped_.load(std::memory_order_seq_cst);
+        const bool wake = not_empty_.waiting.load(std::memory_order_seq_cst) > 0;
+        if (!stopped) ::new (static_cast<void*>(cell->storage)) T(std::move(item));
+        cell->valid = !stopped;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        if (wake) Wake(not_empty_);
+        return stopped ? Status::Stopped : Status::Ok;
+    }
+
+    std::optional<T> TryPop() {
+        while (true) {
+            size_t pos = head_.load(std::memory_order_relaxed);
+            Cell* cell;
+            while (true) {
+                cell = &cells_[pos & mask_];
+                const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+                if (diff == 0) {
+                    if constexpr (SingleProducerConsumer) {
+                        head_.store(pos + 1, std::memory_order_seq_cst);
+                        break;
+                    } else if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_seq_cst,
+                                                           std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return std::nullopt;
+                } else {
+                    pos = head_.load(std::memory_order_relaxed);
+                }
+            }
+
+            const bool wake = not_full_.waiting.load(std::memory_order_seq_cst) > 0;
+            std::optional<T> item;
+            if (cell->valid) {
+                item.emplace(std::move(*cell->Item()));
+                cell->Item()->~T();
+            }
+            cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+            if (wake) Wake(not_full_);
+            if (item) return item;
+        }
+    }
+
+    // Slots claimed by producers but not yet popped; counts slots still
+    // being filled, so a waiter spins instead of sleeping through them
+    bool HasItems() const {
+        return tail_.load(std::memory_order_seq_cst) != head_.load(std::memory_order_seq_cst);
+    }
+
+    bool HasSpace() const {
+        return tail_.load(std::memory_order_seq_cst) - head_.load(std::memory_order_seq_cst) <= mask_;
+    }
+
+    void Wake(Waiters& waiters) {
+        if (waiters.wake_pending.load(std::memory_order_relaxed) || waiters.wake_pending.exchange(true)) return;
+        waiters.epoch.fetch_add(1, std::memory_order_release);
+        detail::FutexWake(waiters.epoch, false);
+    }
+
+    void PassWake(Waiters& waiters, bool ready) {
+        if (ready && waiters.waiting.load(std::memory_order_seq_cst) > 0) Wake(waiters);
+    }
+
+    // Returns false once the deadline has passed
+    template<typename Ready>
+    bool Park(Waiters& waiters, std::optional<Clock::time_point> deadline, Ready ready) {
+        std::optional<atom::core::Duration> remaining;
+        if (deadline) {
+            remaining = *deadline - Clock::now();
+            if (remaining->count() <= 0) return false;
+        }
+
+        const atom::core::u32 epoch = waiters.epoch.load(std::memory_order_acquire);
+        waiters.waiting.fetch_add(1, std::memory_order_seq_cst);
+        if (ready()) {
+            // The other side is mid-way through a slot; let it finish
+            std::this_thread::yield();
+        } else if (!stopped_.load(std::memory_order_seq_cst)) {
+            // Also clears a flag left behind by a waker whose target had
+            // already left; any wake-up after this bumps the epoch first
+            waiters.wake_pending.store(false, std::memory_order_seq_cst);
+            detail::FutexWait(waiters.epoch, epoch, remaining);
+            waiters.wake_pending.store(false, std::memory_order_seq_cst);
+        }
+        waiters.waiting.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    alignas(kCacheLine) std::atomic<size_t> head_{0};
+    alignas(kCacheLine) std::atomic<size_t> tail_{0};
+    Waiters not_empty_;
+    Waiters not_full_;
+    alignas(kCacheLine) std::atomic<bool> stopped_{false};
+    size_t mask_{0};
+    std::unique_ptr<Cell[]> cells_;
+};
+
+template<typename T>
+using MpmcQueue = RingQueue<T, false>;
+
+// One producer thread and one consumer thread at a time
+template<typename T>
+using SpscQueue = RingQueue<T, true>;
+
+} // namespace atom::data
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "preprocessor.hpp"
+#include <span>
+
+namespace atom::data {
+
+// Region of a frame, corner coordinates in frame pixels
+struct RoiBox {
+    atom::core::f32 x1, y1, x2, y2;
+};
+
+// Crops every box out of an 8-bit, 3-channel frame and resizes it to
+// config.target_size in one pass, writing straight into a [K, 3, H, W]
+// float32 batch. Sampling is ROI-align style (bilinear, half-pixel
+// centers, clamped at the frame edge), so boxes need not be integral.
+// Pixels are scaled to [0, 1], swapped to RGB with to_rgb and, with
+// normalize, standardized by config.mean / config.std (given in output
+// channel order). The interpolation flag is not used.
+//
+// `batch` is reused when it already has the right shape.
+atom::core::Result<void> CropResizeBatch(const cv::Mat& frame, std::span<const RoiBox> boxes,
+                                         const PreprocessConfig& config, atom::core::Tensor& batch);
+
+atom::core::Result<atom::core::Tensor> CropResizeBatch(const cv::Mat& frame, std::span<const RoiBox> boxes,
+                                                       const PreprocessConfig& config);
+
+} // namespace atom::data
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../core/types.hpp"
+#include "../core/tensor.hpp"
+#include "../data/ring_queue.hpp"
+#include <functional>
+#include <future>
+#include <thread>
+#include <atomic>
+#include <vector>
+
+namespace atom::inference {
+
+class IBackend;
+
+using ExecuteResult = atom::core::Result<std::vector<atom::core::Tensor>>;
+using CompletionCallback = std::function<void(ExecuteResult)>;
+
+// Submission queue with dedicated worker threads for one backend instance.
+// Submit never blocks: a full queue is reported as ErrorCode::QueueFull.
+class AsyncExecutor {
+public:
+    explicit AsyncExecutor(IBackend& backend, size_t num_workers = 1, size_t queue_capacity = 256);
+    ~AsyncExecutor();
+
+    AsyncExecutor(const AsyncExecutor&) = delete;
+    AsyncExecutor& operator=(const AsyncExecutor&) = delete;
+    AsyncExecutor(AsyncExecutor&&) = delete;
+    AsyncExecutor& operator=(AsyncExecutor&&) = delete;
+
+    // The callback runs on a worker thread once Execute has finished.
+    // It is not invoked when Submit itself returns an error.
+    atom::core::Result<void> Submit(std::vector<atom::core::Tensor> inputs, CompletionCallback callback);
+    std::future<ExecuteResult> Submit(std::vector<atom::core::Tensor> inputs);
+
+    // Stops accepting work, runs what is already queued and joins the workers
+    void Stop();
+    bool IsRunning() const { return running_; }
+
+    // Query
+    size_t GetWorkerCount() const { return workers_.size(); }
+    size_t GetPendingCount() const { return queue_.Size(); }
+    size_t GetInFlightCount() const { return in_flight_.load(); }
+
+private:
+    struct Request {
+        std::vector<atom::core::Tensor> inputs;
+        CompletionCallback callback;
+    };
+
+    IBackend& backend_;
+    atom::data::MpmcQueue<Request> queue_;
+    std::vector<std::thread> workers_;
+    std::atomic<bool> running_{true};
+    std::atomic<size_t> in_flight_{0};
+
+    void WorkerLoop();
+};
+
+} // namespace atom::inference
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "backend.hpp"
+#include <filesystem>
+#include <map>
+#include <mutex>
+
+namespace atom::inference {
+
+// Median latency of one backend/kernel variant at one batch size
+struct KernelTiming {
+    atom::core::BackendType backend;
+    std::string variant;
+    atom::core::f64 median_ms{0.0};
+};
+
+// Tuning outcome for one batch size
+struct TuningEntry {
+    size_t batch_size{1};
+    atom::core::BackendType backend{atom::core::BackendType::CPU};
+    std::string variant;
+    atom::core::f64 median_ms{0.0};
+    std::vector<KernelTiming> timings;   // every candidate that ran
+};
+
+// Persistent tuning results keyed by model hash and host CPU, so a later
+// startup on the same machine can skip measuring. Plain tab-separated text,
+// one line per (key, batch size); unreadable lines are ignored.
+class TuningCache {
+public:
+    explicit TuningCache(std::filesystem::path path);
+    
+    atom::core::Result<void> Load();
+    atom::core::Result<void> Save() const;
+    
+    std::optional<TuningEntry> Find(const std::string& key, size_t batch_size) const;
+    void Store(const std::string& key, const TuningEntry& entry);
+    
+    // "<model hash>|<cpu model>|<threads>"
+    static std::string MakeKey(atom::core::u64 model_hash, const std::string& cpu_model);
+    
+    const std::filesystem::path& GetPath() const { return path_; }
+    
+private:
+    std::filesystem::path path_;
+    mutable std::mutex mutex_;
+    std::map<std::pair<std::string, size_t>, TuningEntry> entries_;
+};
+
+// Result of tuning: a backend with the model loaded and the winning kernel
+// variant selected for every tuned batch size
+struct TuningDecision {
+    UniqueBackendPtr backend;
+    std::vector<TuningEntry> entries;
+    bool from_cache{false};
+};
+
+// Runs every registered backend, and every kernel variant each backend
+// offers, on the model's input shapes at each requested batch size. One
+// backend serves the model, so the backend with the lowest summed latency
+// wins; within it the fastest variant is chosen per batch size.
+class BackendAutotuner {
+public:
+    explicit BackendAutotuner(atom::core::AutotuneOptions options);
+    
+    // input_shapes: per model input, batch dimension first (replaced per batch size)
+    atom::core::Result<TuningDecision> Tune(const std::string& model_path,
+                                            const atom::core::DeviceInfo& device,
+                                            const std::vector<atom::core::Shape>& input_shapes,
+                                            const std::vector<atom::core::DataType>& input_types);
+    
+    static atom::core::Result<atom::core::u64> HashModelFile(const std::string& model_path);
+    static std::string GetCpuModel();
+    
+private:
+    atom::core::AutotuneOptions options_;
+    
+    atom::core::Result<UniqueBackendPtr> CreateLoadedBackend(atom::core::BackendType type,
+                                                             const std::string& model_path,
+                                                             const atom::core::DeviceInfo& device) const;
+    atom::core::Result<TuningDecision> ApplyCached(const std::vector<TuningEntry>& entries,
+                                                   const std::string& model_path,
+                                                   const atom::core::DeviceInfo& device) const;
+    atom::core::Result<atom::core::f64> Measure(IBackend& backend,
+                                                const std::vector<atom::core::Tensor>& inputs,
+                                                atom::core::Duration budget) const;
+};
+
+} // namespace atom::inference
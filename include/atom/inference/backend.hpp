@@ -2,15 +2,17 @@
 
 #include "../core/types.hpp"
 #include "../core/tensor.hpp"
+#include "async_executor.hpp"
 #include <vector>
 #include <memory>
+#include <mutex>
 
 namespace atom::inference {
 
 // Base interface for inference backends
 class IBackend {
 public:
-    virtual ~IBackend() = default;
+    virtual ~IBackend();
     
     // Initialization
     virtual atom::core::Result<void> Initialize(const atom::core::DeviceInfo& device) = 0;
@@ -24,6 +26,22 @@ public:
     virtual atom::core::Result<std::vector<atom::core::Tensor>> Execute(
         const std::vector<atom::core::Tensor>& inputs) = 0;
     
+    // Asynchronous inference. Requests are queued on this backend's submission
+    // queue and run on its worker threads, so the caller never blocks on Execute.
+    // Backends with native async support (CUDA streams) may override.
+    virtual atom::core::Result<void> ExecuteAsync(
+        std::vector<atom::core::Tensor> inputs, CompletionCallback callback);
+    std::future<ExecuteResult> ExecuteAsync(std::vector<atom::core::Tensor> inputs);
+    
+    // Number of submission workers; takes effect on the next ExecuteAsync after a drain
+    void SetAsyncWorkerCount(size_t num_workers);
+    
+    // Runs queued async requests to completion and joins the workers.
+    // Must be called before Shutdown() releases what Execute depends on,
+    // and by every derived destructor: destroying a backend whose async
+    // workers were started and not drained aborts.
+    void DrainAsync();
+    
     // Query
     virtual atom::core::BackendType GetType() const = 0;
     virtual bool IsInitialized() const = 0;
@@ -32,6 +50,42 @@ public:
     // Optimization
     virtual atom::core::Result<void> OptimizeForBatchSize(size_t batch_size) = 0;
     virtual atom::core::Result<void> SetPrecision(atom::core::DataType precision) = 0;
+    
+    // Concurrency: number of execution contexts that can run Execute at the
+    // same time on one loaded model. Contexts share the model weights.
+    // Not safe to call while Execute is running.
+    virtual atom::core::Result<void> SetExecutionContextCount(size_t count);
+    virtual size_t GetExecutionContextCount() const { return 1; }
+    
+    // Host threads per inference. Backends whose kernels do not run on host
+    // threads ignore this. Not safe to call while Execute is running.
+    virtual atom::core::Result<void> SetThreading(const atom::core::ThreadingOptions& threading) {
+        (void)threading;
+        return {};
+    }
+    
+    // Plans specialized to one set of input shapes, for shape buckets. Execute
+    // uses a prepared plan when a request matches it exactly and handles other
+    // shapes as before. Backends that do not specialize keep nothing. Safe to
+    // call while Execute is running.
+    virtual atom::core::Result<void> PrepareShapes(const std::vector<atom::core::Shape>& input_shapes) {
+        (void)input_shapes;
+        return {};
+    }
+    virtual void ReleaseShapes(const std::vector<atom::core::Shape>& input_shapes) {
+        (void)input_shapes;
+    }
+    
+    // Kernel variants, for autotuning. A variant selected for a batch size
+    // applies to requests of that batch; without one it sets the default.
+    virtual std::vector<std::string> GetKernelVariants() const { return {"default"}; }
+    virtual atom::core::Result<void> SelectKernelVariant(const std::string& variant,
+                                                         std::optional<size_t> batch_size = std::nullopt);
+    
+private:
+    std::mutex async_mutex_;
+    std::unique_ptr<AsyncExecutor> async_executor_;
+    size_t async_worker_count_{1};
 };
 
 using BackendPtr = std::shared_ptr<IBackend>;
@@ -4,6 +4,9 @@
 #include <functional>
 #include <map>
 #include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string_view>
 
 namespace atom::inference {
 
@@ -37,6 +40,9 @@ private:
     std::map<atom::core::BackendType, CreatorFunc> creators_;
 };
 
+const char* BackendTypeName(atom::core::BackendType type);
+std::optional<atom::core::BackendType> ParseBackendType(std::string_view name);
+
 // Auto-registration helper
 template<typename T>
 class BackendRegistrar {
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "../../core/types.hpp"
+#include <fstream>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace atom::inference::cpu {
+
+// Little helpers for the native-endian binary formats used by the CPU backend
+
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::ostream& stream) : stream_(stream) {}
+
+    void WriteBytes(const void* data, size_t size) {
+        stream_.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    }
+
+    template<typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        WriteBytes(&value, sizeof(T));
+    }
+
+    template<typename T>
+    void WriteVector(const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        Write(static_cast<atom::core::u64>(values.size()));
+        WriteBytes(values.data(), values.size() * sizeof(T));
+    }
+
+    void WriteString(const std::string& value) {
+        Write(static_cast<atom::core::u64>(value.size()));
+        WriteBytes(value.data(), value.size());
+    }
+
+    bool Ok() const { return stream_.good(); }
+
+private:
+    std::ostream& stream_;
+};
+
+class BinaryReader {
+public:
+    explicit BinaryReader(std::istream& stream) : stream_(stream) {}
+
+    void ReadBytes(void* data, size_t size) {
+        stream_.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+    }
+
+    template<typename T>
+    void Read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        ReadBytes(&value, sizeof(T));
+    }
+
+    template<typename T>
+    void ReadVector(std::vector<T>& values) {
+        atom::core::u64 size = 0;
+        Read(size);
+        if (!Ok() || size > kMaxElements) {
+            stream_.setstate(std::ios::failbit);
+            return;
+        }
+        values.resize(size);
+        ReadBytes(values.data(), size * sizeof(T));
+    }
+
+    void ReadString(std::string& value) {
+        atom::core::u64 size = 0;
+        Read(size);
+        if (!Ok() || size > kMaxElements) {
+            stream_.setstate(std::ios::failbit);
+            return;
+        }
+        value.resize(size);
+        ReadBytes(value.data(), size);
+    }
+
+    bool Ok() const { return stream_.good(); }
+
+private:
+    // Guards against absurd allocations from corrupt files
+    static constexpr atom::core::u64 kMaxElements = 1ull << 32;
+
+    std::istream& stream_;
+};
+
+// 64-bit FNV-1a, used for content hashes and cache keys
+class Fnv1a {
+public:
+    void Update(const void* data, size_t size) {
+        const auto* bytes = static_cast<const atom::core::u8*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash_ ^= bytes[i];
+            hash_ *= 1099511628211ull;
+        }
+    }
+
+    template<typename T>
+    void Update(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        Update(&value, sizeof(T));
+    }
+
+    atom::core::u64 Value() const { return hash_; }
+
+private:
+    atom::core::u64 hash_{14695981039346656037ull};
+};
+
+// Fnv1a of a whole file's contents
+inline std::optional<atom::core::u64> HashFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return std::nullopt;
+
+    Fnv1a hash;
+    std::vector<char> buffer(1 << 16);
+    while (file) {
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        hash.Update(buffer.data(), static_cast<size_t>(file.gcount()));
+    }
+    return hash.Value();
+}
+
+// Read-only stream over memory, so BinaryReader can parse mapped files
+class MemoryStreamBuf : public std::streambuf {
+public:
+    MemoryStreamBuf(const void* data, size_t size) {
+        auto* begin = const_cast<char*>(static_cast<const char*>(data));
+        setg(begin, begin, begin + size);
+    }
+};
+
+} // namespace atom::inference::cpu
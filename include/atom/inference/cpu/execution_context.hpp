@@ -0,0 +1,99 @@
+#pragma once
+
+#include "plan.hpp"
+#include "kernels.hpp"
+#include "../../core/tensor.hpp"
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace atom::inference::cpu {
+
+// Everything about running a plan that depends on the input shapes: value
+// shapes, the arena layout and scratch sizes. Immutable once built, so one
+// instance can be shared by every context running that shape.
+struct ShapePlan {
+    std::vector<Shape> input_shapes;
+    std::vector<Shape> shapes;                  // per value
+    std::vector<i64> offsets;                   // per value arena offset, -1 if not in the arena
+    i64 arena_size{0};                          // floats
+    i64 scratch{0};                             // floats per branch
+    i64 quantized_scratch{0};                   // bytes per branch
+    bool concurrent{false};                     // laid out for branch-parallel runs
+};
+
+atom::core::Result<std::shared_ptr<const ShapePlan>> BuildShapePlan(
+    const Plan& plan, const std::vector<Shape>& input_shapes, bool concurrent);
+
+// Mutable per-inference state for one plan: the activation arena and kernel
+// scratch. The plan and its weights are shared read-only between contexts,
+// so several contexts can run the same model concurrently.
+//
+// One run can also use several threads of the shared compute pool: kernels
+// split large operators across intra-op threads, and with more than one
+// branch, nodes whose inputs are ready run concurrently (inter-op), each
+// branch with its own scratch.
+class ExecutionContext {
+public:
+    explicit ExecutionContext(std::shared_ptr<const Plan> plan);
+
+    ExecutionContext(const ExecutionContext&) = delete;
+    ExecutionContext& operator=(const ExecutionContext&) = delete;
+
+    // Sizes buffers for the given input shapes; Run calls this on shape changes
+    atom::core::Result<void> Prepare(const std::vector<Shape>& input_shapes);
+    // Same with a prebuilt shape plan; it must match IsConcurrent()
+    atom::core::Result<void> Prepare(std::shared_ptr<const ShapePlan> shape_plan);
+
+    // shape_plan is used when it matches the input shapes, saving the
+    // re-planning a shape change would otherwise cost
+    atom::core::Result<std::vector<atom::core::Tensor>> Run(
+        const std::vector<atom::core::Tensor>& inputs,
+        const std::shared_ptr<const ShapePlan>& shape_plan = nullptr);
+
+    // Called with every graph input and node output as it is produced; used
+    // for calibration
+    using ValueObserver = std::function<void(u32 value, const f32* data, i64 size)>;
+    void SetValueObserver(ValueObserver observer) { observer_ = std::move(observer); }
+
+    // intra_op_threads includes the calling thread; both are capped by the pool
+    void SetParallelism(size_t intra_op_threads, size_t branches);
+    size_t GetIntraOpThreads() const { return parallel_.Width(); }
+    size_t GetBranchCount() const { return branches_; }
+    bool IsConcurrent() const { return branches_ > 1; }
+
+    void SetKernelConfig(const kernels::KernelConfig& config) { config_ = config; }
+    const kernels::KernelConfig& GetKernelConfig() const { return config_; }
+
+    size_t GetMemoryUsage() const;
+
+private:
+    std::shared_ptr<const Plan> plan_;
+    const Graph* graph_;
+    kernels::KernelConfig config_;
+    ValueObserver observer_;
+    Parallel parallel_;
+    size_t branches_{1};
+
+    // Node dependencies for branch-parallel runs
+    std::vector<std::vector<u32>> successors_;
+    std::vector<u32> predecessor_counts_;
+
+    std::shared_ptr<const ShapePlan> shape_plan_;
+    std::vector<f32> arena_;
+    std::vector<const f32*> values_;            // per value, resolved for the current run
+    std::vector<std::vector<f32>> scratch_;        // per branch
+    std::vector<std::vector<u8>> quantized_scratch_;
+
+    struct BranchRun;
+    void RunBranches();
+    static void RunBranch(ExecutionContext* context, const std::shared_ptr<BranchRun>& run, size_t lane);
+    void CompleteNode(const std::shared_ptr<BranchRun>& run, u32 node);
+    void SpawnBranches(const std::shared_ptr<BranchRun>& run);
+    void RunNode(size_t index, size_t lane = 0);
+    void Observe(u32 value) const;
+    f32* Mutable(u32 value) { return arena_.data() + shape_plan_->offsets[value]; }
+    const f32* Weight(i32 index) const { return index >= 0 ? plan_->GetWeight(index).Floats() : nullptr; }
+};
+
+} // namespace atom::inference::cpu
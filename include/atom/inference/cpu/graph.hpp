@@ -0,0 +1,111 @@
+#pragma once
+
+#include "../../core/types.hpp"
+#include <string>
+#include <vector>
+
+namespace atom::inference::cpu {
+
+using atom::core::i8;
+using atom::core::i32;
+using atom::core::i64;
+using atom::core::u8;
+using atom::core::u32;
+using atom::core::u64;
+using atom::core::f32;
+using atom::core::f64;
+using atom::core::Shape;
+
+// Operators understood by the CPU executor (NCHW layout throughout)
+enum class OpType : u32 {
+    Conv2D,
+    Gemm,          // Y = X * W^T + b, X is [N, K], W is [M, K]
+    Add,
+    Mul,
+    Relu,
+    SiLU,
+    Sigmoid,
+    MaxPool,
+    GlobalAvgPool,
+    Concat,        // along attrs.axis
+    Split,         // along attrs.axis into attrs.split_sizes
+    Upsample,      // nearest neighbour by attrs.scale
+    Softmax,       // over the last dimension
+    Flatten        // [N, ...] -> [N, prod(...)]
+};
+
+// Activation fused into the producing Conv2D/Gemm/Add
+enum class Activation : u32 {
+    None,
+    Relu,
+    SiLU,
+    Sigmoid
+};
+
+struct OpAttributes {
+    i32 kernel[2]{1, 1};
+    i32 stride[2]{1, 1};
+    i32 pad[4]{0, 0, 0, 0};     // top, left, bottom, right
+    i32 dilation[2]{1, 1};
+    i32 group{1};
+    i32 axis{1};
+    i32 scale{2};
+    Activation activation{Activation::None};
+    std::vector<i64> split_sizes;
+};
+
+struct Node {
+    OpType op;
+    std::vector<u32> inputs;    // value indices
+    std::vector<u32> outputs;   // value indices
+    OpAttributes attrs;
+    i32 weight{-1};             // weight index or -1
+    i32 bias{-1};
+    std::string name;
+};
+
+// A tensor flowing between nodes. Only graph inputs carry a shape in the
+// file; everything else is derived by InferShapes.
+struct Value {
+    std::string name;
+    Shape shape;
+};
+
+struct Weight {
+    Shape shape;
+    std::vector<f32> data;
+};
+
+// Immutable model graph. Nodes are stored in a valid execution order.
+struct Graph {
+    std::vector<Value> values;
+    std::vector<Weight> weights;
+    std::vector<Node> nodes;
+    std::vector<u32> inputs;
+    std::vector<u32> outputs;
+
+    // Serialized model format (.atomg)
+    static atom::core::Result<Graph> Load(const std::string& path);
+    atom::core::Result<void> Save(const std::string& path) const;
+
+    // Structural checks: indices in range, every value produced before use
+    atom::core::Result<void> Validate() const;
+
+    // Shapes of every value for the given input shapes
+    atom::core::Result<std::vector<Shape>> InferShapes(const std::vector<Shape>& input_shapes) const;
+
+    // Content hash of topology and weights
+    u64 Hash() const;
+
+    size_t GetWeightBytes() const;
+};
+
+const char* OpTypeName(OpType op);
+
+// Node encoding shared by the graph and plan file formats
+class BinaryWriter;
+class BinaryReader;
+void WriteNode(BinaryWriter& writer, const Node& node);
+void ReadNode(BinaryReader& reader, Node& node);
+
+} // namespace atom::inference::cpu
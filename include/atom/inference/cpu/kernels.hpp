@@ -0,0 +1,110 @@
+#pragma once
+
+#include "graph.hpp"
+#include "parallel.hpp"
+#include <optional>
+#include <string_view>
+
+namespace atom::inference::cpu::kernels {
+
+// All kernels work on contiguous row-major float32 buffers (NCHW for images).
+// Those taking a Parallel split their output into disjoint slices across it.
+
+// Interchangeable implementations; which one wins depends on shapes and the
+// host CPU, so the backend autotuner picks per model and batch size.
+enum class ConvAlgorithm : u32 {
+    Im2Col,     // unfold patches, then GEMM
+    Direct      // accumulate straight into the output plane, no scratch
+};
+
+enum class GemmAlgorithm : u32 {
+    Blocked,    // cache-blocked i-k-j loops
+    Tiled       // 4x16 register tile per inner loop
+};
+
+struct KernelConfig {
+    ConvAlgorithm conv{ConvAlgorithm::Im2Col};
+    GemmAlgorithm gemm{GemmAlgorithm::Blocked};
+
+    bool operator==(const KernelConfig&) const = default;
+};
+
+// Variant names used by the backend and the tuning cache, e.g. "im2col+tiled"
+std::string KernelConfigName(const KernelConfig& config);
+std::optional<KernelConfig> ParseKernelConfig(std::string_view name);
+std::vector<KernelConfig> AllKernelConfigs();
+
+// Instruction sets the int8 kernels dispatch between at run time
+enum class CpuIsa : u32 {
+    Generic,
+    Avx2,          // u8*s8 via maddubs; activations limited to 7 bits
+    Avx512Vnni     // u8*s8 via vpdpbusd
+};
+
+// Best ISA on this CPU, capped by the ATOM_CPU_ISA environment variable
+// (generic, avx2 or avx512vnni)
+CpuIsa DetectCpuIsa();
+
+// AVX-512F on this CPU, enough for f32 kernels where DetectCpuIsa() wants
+// VNNI too; false when ATOM_CPU_ISA caps below avx512vnni
+bool HasAvx512F();
+
+// Identifies the kernel build and runtime ISA; plans are only valid for the same one
+const char* KernelIsa();
+
+// GEMM left operands are stored as row panels: kPanelRows rows interleaved
+// per K step, last panel zero-padded. Weights are packed once at load.
+constexpr i64 kPanelRows = 4;
+
+i64 PackedMatrixSize(i64 m, i64 k);
+void PackMatrixA(const f32* a, i64 m, i64 k, f32* packed);
+
+// C[M,N] = A[M,K] * B[K,N] + row_bias[M], A packed by PackMatrixA
+void MatMul(const f32* a_packed, const f32* b, f32* c, i64 m, i64 n, i64 k,
+            const f32* row_bias, Activation activation,
+            GemmAlgorithm algorithm = GemmAlgorithm::Blocked, const Parallel& parallel = {});
+
+// Y[M,N] = X[M,K] * W[K,N] + bias[N]; W is the Gemm weight pre-transposed
+void Linear(const f32* x, const f32* w_transposed, f32* y, i64 m, i64 n, i64 k,
+            const f32* bias, Activation activation, const Parallel& parallel = {});
+
+void ApplyActivation(f32* data, i64 size, Activation activation);
+
+// Conv weights [OC, IC/group, KH, KW] packed per group as GEMM panels
+i64 PackedConvWeightSize(const Shape& weight_shape, i32 group);
+void PackConvWeights(const f32* weight, const Shape& weight_shape, i32 group, f32* packed);
+
+// Scratch floats Conv2D needs for im2col (0 for pointwise convolutions)
+i64 Conv2DScratchSize(const Shape& input, const Shape& weight, const Shape& output,
+                      const OpAttributes& attrs);
+
+void Conv2D(const f32* input, const Shape& input_shape,
+            const f32* packed_weight, const Shape& weight_shape, const f32* bias,
+            f32* output, const Shape& output_shape,
+            const OpAttributes& attrs, f32* scratch,
+            const KernelConfig& config = {}, const Parallel& parallel = {});
+
+void MaxPool(const f32* input, const Shape& input_shape,
+             f32* output, const Shape& output_shape, const OpAttributes& attrs,
+             const Parallel& parallel = {});
+
+void GlobalAvgPool(const f32* input, const Shape& input_shape, f32* output,
+                   const Parallel& parallel = {});
+
+// Elementwise with numpy broadcasting of rhs onto lhs_shape
+void Add(const f32* lhs, const Shape& lhs_shape, const f32* rhs, const Shape& rhs_shape,
+         f32* output, Activation activation);
+void Mul(const f32* lhs, const Shape& lhs_shape, const f32* rhs, const Shape& rhs_shape,
+         f32* output, Activation activation);
+
+void Concat(const std::vector<const f32*>& inputs, const std::vector<Shape>& input_shapes,
+            i32 axis, f32* output);
+void Split(const f32* input, const Shape& input_shape, i32 axis,
+           const std::vector<f32*>& outputs, const std::vector<Shape>& output_shapes);
+
+void UpsampleNearest(const f32* input, const Shape& input_shape, i32 scale, f32* output);
+
+// Softmax over the last dimension
+void Softmax(const f32* input, const Shape& shape, f32* output);
+
+} // namespace atom::inference::cpu::kernels
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../../core/types.hpp"
+#include <algorithm>
+#include <functional>
+
+namespace atom::scheduler {
+class ThreadPool;
+}
+
+namespace atom::inference::cpu {
+
+// Process-wide pool the CPU kernels and graph branches are split across.
+// Sized once, on first use, from Config::KEY_CPU_THREADS (default: all
+// hardware threads, one of which is always the calling thread). Null when
+// that leaves no helper threads.
+atom::scheduler::ThreadPool* ComputePool();
+
+// Threads one computation may use: the caller plus pool helpers
+size_t ComputeThreadCount();
+
+// Fork-join handle given to kernels. The calling thread always works on the
+// chunks itself and helpers only pick up what is left, so nesting (a kernel
+// split inside a graph branch running on a pool thread) cannot deadlock.
+class Parallel {
+public:
+    Parallel() = default;   // runs everything on the calling thread
+    Parallel(atom::scheduler::ThreadPool* pool, size_t width)
+        : pool_(pool), width_(pool ? std::max<size_t>(width, 1) : 1) {}
+
+    size_t Width() const { return width_; }
+
+    // body(begin, end) over [0, count) in chunks of at least `grain` items
+    template<typename F>
+    void For(atom::core::i64 count, atom::core::i64 grain, F&& body) const {
+        if (width_ <= 1 || count <= grain) {
+            if (count > 0) body(atom::core::i64{0}, count);
+            return;
+        }
+        Run(count, grain, std::function<void(atom::core::i64, atom::core::i64)>(std::forward<F>(body)));
+    }
+
+private:
+    atom::scheduler::ThreadPool* pool_{nullptr};
+    size_t width_{1};
+
+    void Run(atom::core::i64 count, atom::core::i64 grain,
+             const std::function<void(atom::core::i64, atom::core::i64)>& body) const;
+};
+
+} // namespace atom::inference::cpu
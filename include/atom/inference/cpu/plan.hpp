@@ -0,0 +1,100 @@
+#pragma once
+
+#include "graph.hpp"
+#include "../../core/mapped_file.hpp"
+#include <memory>
+#include <optional>
+
+namespace atom::inference::cpu {
+
+// How a weight's data is laid out for the kernels
+enum class WeightLayout : u32 {
+    Plain,        // as in the source graph
+    ConvPanels,   // Conv2D weights packed by kernels::PackConvWeights
+    Transposed,   // Gemm weights stored [K, M] for kernels::Linear
+    Int8Rows      // s8 rows for kernels::QConv2D / QLinear
+};
+
+struct PackedWeight {
+    WeightLayout layout{WeightLayout::Plain};
+    const void* data{nullptr};
+    u64 bytes{0};
+
+    const f32* Floats() const { return static_cast<const f32*>(data); }
+    const i8* Int8() const { return static_cast<const i8*>(data); }
+};
+
+// Int8 parameters of one quantized Conv2D/Gemm node
+struct QuantParams {
+    f32 input_scale{1.0f};
+    i32 input_zero_point{0};
+    std::vector<f32> weight_scales;    // per output channel
+    std::vector<i32> weight_sums;      // per output channel
+
+    bool IsQuantized() const { return !weight_scales.empty(); }
+};
+
+struct CalibrationTable;
+
+// Placement of every intermediate value in one arena. Values whose
+// lifetimes do not overlap share memory. With per_sample set every value is
+// proportional to the batch size, so offsets and size scale by the batch.
+struct MemoryPlan {
+    std::vector<Shape> input_shapes;    // shapes the plan was made for
+    std::vector<i64> offsets;           // floats, per value; -1 if not in the arena
+    i64 arena_size{0};                  // floats
+    bool per_sample{false};
+};
+
+// Lifetime-based first-fit placement for the given value shapes. With
+// concurrent set, two values only share memory when every reader of one is a
+// dependency of the other's producer, so any execution order the graph's
+// edges allow is safe (for running independent branches in parallel).
+MemoryPlan PlanMemory(const Graph& graph, const std::vector<Shape>& shapes, bool concurrent = false);
+
+// Executable form of a graph: activations fused into their producers,
+// weights repacked for the kernels and memory planned ahead of time. Plans
+// are saved to a versioned .atomp file that is mmapped on load, so weights
+// are used in place without parsing or copying.
+class Plan {
+public:
+    Plan() = default;
+
+    Plan(const Plan&) = delete;
+    Plan& operator=(const Plan&) = delete;
+
+    // With a calibration table, Conv2D and Gemm nodes whose input range was
+    // observed run on the int8 kernels; everything else stays float
+    static atom::core::Result<std::shared_ptr<const Plan>> Compile(
+        Graph graph, const CalibrationTable* calibration = nullptr);
+
+    // Rejects plans built for another kernel ISA, and, when model_path is
+    // given, plans built from a different version of that model
+    static atom::core::Result<std::shared_ptr<const Plan>> Load(
+        const std::string& plan_path, const std::optional<std::string>& model_path = std::nullopt);
+
+    // model_path identifies the source model the plan is checked against on load
+    atom::core::Result<void> Save(const std::string& plan_path, const std::string& model_path) const;
+
+    // Topology and weight shapes; weight data lives in GetWeight
+    const Graph& GetGraph() const { return graph_; }
+    const PackedWeight& GetWeight(i32 index) const { return weights_[index]; }
+    const MemoryPlan& GetMemoryPlan() const { return memory_; }
+
+    // Null for nodes that run in float
+    const QuantParams* GetQuantParams(size_t node) const;
+    bool IsQuantized() const { return !quant_.empty(); }
+
+    size_t GetWeightBytes() const;
+    bool IsMapped() const { return mapping_.IsOpen(); }
+
+private:
+    Graph graph_;
+    std::vector<PackedWeight> weights_;
+    std::vector<std::vector<f32>> storage_;    // weight data when compiled in-process
+    atom::core::MappedFile mapping_;           // weight data when loaded from a file
+    MemoryPlan memory_;
+    std::vector<QuantParams> quant_;           // per node, empty for float plans
+};
+
+} // namespace atom::inference::cpu
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "plan.hpp"
+#include "../../core/tensor.hpp"
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace atom::inference::cpu {
+
+struct ValueRange {
+    f32 min{std::numeric_limits<f32>::infinity()};
+    f32 max{-std::numeric_limits<f32>::infinity()};
+
+    bool IsValid() const { return min <= max; }
+    void Observe(const f32* data, i64 size);
+};
+
+// Activation ranges per graph value, observed by running representative
+// inputs through the float plan. Value indices match the source graph.
+struct CalibrationTable {
+    std::vector<ValueRange> ranges;
+    u64 samples{0};
+};
+
+// Accuracy of an int8 plan against its float plan on the same inputs
+struct QuantizationReport {
+    u64 samples{0};
+    size_t quantized_nodes{0};
+    size_t quantizable_nodes{0};     // Conv2D and Gemm nodes
+    f64 max_abs_error{0.0};
+    f64 mean_abs_error{0.0};
+    f64 snr_db{0.0};                 // output signal over quantization noise
+    f64 top1_agreement{0.0};         // rows of the first output whose argmax matches
+};
+
+// Each dataset entry is one set of graph inputs
+atom::core::Result<CalibrationTable> CollectActivationRanges(
+    const std::shared_ptr<const Plan>& float_plan,
+    const std::vector<std::vector<atom::core::Tensor>>& dataset);
+
+atom::core::Result<QuantizationReport> EvaluateQuantization(
+    const std::shared_ptr<const Plan>& float_plan,
+    const std::shared_ptr<const Plan>& quantized_plan,
+    const std::vector<std::vector<atom::core::Tensor>>& dataset);
+
+} // namespace atom::inference::cpu
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "kernels.hpp"
+
+namespace atom::inference::cpu::kernels {
+
+// Int8 kernels for post-training static quantization. Activations are
+// quantized per tensor to u8 with a zero point, weights per output channel
+// to symmetric s8. Products accumulate in int32; requantization to float,
+// bias and activation are fused into the GEMM epilogue.
+
+struct ActivationQuant {
+    f32 scale{1.0f};
+    i32 zero_point{0};
+};
+
+// Weights of one Conv2D/Gemm, s8 rows padded to QuantizedRows x QuantizedDepth
+// per group (zero padding contributes nothing to the dot products)
+struct QuantizedWeights {
+    const i8* data{nullptr};
+    const f32* scales{nullptr};     // per output channel
+    const i32* sums{nullptr};       // per output channel, for the zero-point correction
+};
+
+// Largest u8 activation code: 7 bits on AVX2, where maddubs pair sums would
+// otherwise saturate int16
+i32 ActivationQuantMax();
+ActivationQuant ChooseActivationQuant(f32 min_value, f32 max_value);
+
+i64 QuantizedRows(i64 m);
+i64 QuantizedDepth(i64 k);
+
+// One group of weight rows [M, K]
+void QuantizeWeightRows(const f32* weight, i64 m, i64 k, i8* out, f32* scales, i32* sums);
+
+i64 QConv2DScratchBytes(const Shape& input, const Shape& weight, const Shape& output,
+                        const OpAttributes& attrs);
+
+void QConv2D(const f32* input, const Shape& input_shape,
+             const QuantizedWeights& weights, const Shape& weight_shape, const f32* bias,
+             ActivationQuant input_quant, f32* output, const Shape& output_shape,
+             const OpAttributes& attrs, u8* scratch, const Parallel& parallel = {});
+
+i64 QLinearScratchBytes(i64 m, i64 k);
+
+// Y[M,N] = X[M,K] * W[N,K]^T + bias[N] with W quantized row-wise
+void QLinear(const f32* x, const QuantizedWeights& weights, f32* y, i64 m, i64 n, i64 k,
+             const f32* bias, ActivationQuant input_quant, Activation activation, u8* scratch,
+             const Parallel& parallel = {});
+
+} // namespace atom::inference::cpu::kernels
@@ -1,6 +1,14 @@
 #pragma once
 
 #include "backend.hpp"
+#include "execution_context_pool.hpp"
+#include "cpu/plan.hpp"
+#include "cpu/execution_context.hpp"
+#include "cpu/quantization.hpp"
+#include <atomic>
+#include <filesystem>
+#include <map>
+#include <shared_mutex>
 
 namespace atom::inference {
 
@@ -15,6 +23,7 @@ public:
     atom::core::Result<void> LoadModel(const std::string& model_path) override;
     void UnloadModel() override;
     
+    // Thread-safe: each call checks out its own execution context
     atom::core::Result<std::vector<atom::core::Tensor>> Execute(
         const std::vector<atom::core::Tensor>& inputs) override;
     
@@ -28,13 +37,79 @@ public:
     atom::core::Result<void> OptimizeForBatchSize(size_t batch_size) override;
     atom::core::Result<void> SetPrecision(atom::core::DataType precision) override;
     
+    atom::core::Result<void> SetExecutionContextCount(size_t count) override;
+    size_t GetExecutionContextCount() const override { return context_count_; }
+    
+    // Kernels and graph branches share the process-wide compute pool
+    // (cpu::ComputePool); this sets how much of it one Execute call uses
+    atom::core::Result<void> SetThreading(const atom::core::ThreadingOptions& threading) override;
+    const atom::core::ThreadingOptions& GetThreading() const { return threading_; }
+    
+    // Prepared shapes skip shape inference and memory planning on every
+    // context that switches to them
+    atom::core::Result<void> PrepareShapes(const std::vector<atom::core::Shape>& input_shapes) override;
+    void ReleaseShapes(const std::vector<atom::core::Shape>& input_shapes) override;
+    
+    std::vector<std::string> GetKernelVariants() const override;
+    atom::core::Result<void> SelectKernelVariant(const std::string& variant,
+                                                 std::optional<size_t> batch_size = std::nullopt) override;
+    
+    // CPU-specific
+    atom::core::Result<void> LoadGraph(cpu::Graph graph);
+    std::shared_ptr<const cpu::Plan> GetPlan() const { return plan_; }
+    size_t GetMemoryUsage() const;
+    
+    // Compiled plans are cached as "<model file>.atomp", next to the model
+    // unless a directory is set here or via Config::KEY_PLAN_CACHE_DIR.
+    // LoadModel also accepts a .atomp file directly.
+    atom::core::Result<void> SavePlan(const std::string& plan_path) const;
+    void SetPlanCacheDirectory(std::filesystem::path directory) { plan_cache_dir_ = std::move(directory); }
+    void EnablePlanCache(bool enable) { plan_cache_enabled_ = enable; }
+    
+    // Post-training static quantization: runs the dataset through the float
+    // plan to collect activation ranges, compiles an int8 plan from the source
+    // model and reports its accuracy against float on the same inputs.
+    // SetPrecision(Int8) then switches to it. The model must have been loaded
+    // from a graph file; int8 plans are not cached automatically (use SavePlan).
+    atom::core::Result<cpu::QuantizationReport> Calibrate(
+        const std::vector<std::vector<atom::core::Tensor>>& dataset);
+    
 private:
     bool initialized_{false};
-    bool model_loaded_{false};
+    std::atomic<bool> model_loaded_{false};
     atom::core::DeviceInfo device_;
     
-    // CPU-specific implementation details would go here
-    // Could use Intel MKL-DNN, ONNX Runtime CPU, or custom implementation
+    std::string model_path_;
+    std::filesystem::path plan_cache_dir_;
+    bool plan_cache_enabled_{true};
+    
+    // Immutable weights shared by every execution context; plan_ is
+    // whichever of the float and int8 plans is active
+    std::shared_ptr<const cpu::Plan> plan_;
+    std::shared_ptr<const cpu::Plan> float_plan_;
+    std::shared_ptr<const cpu::Plan> int8_plan_;
+    ExecutionContextPool<cpu::ExecutionContext> contexts_;
+    size_t context_count_{1};
+    atom::core::ThreadingOptions threading_;
+    
+    // Shape plans prepared for the active plan and branch layout
+    mutable std::shared_mutex shape_plans_mutex_;
+    std::map<std::vector<cpu::Shape>, std::shared_ptr<const cpu::ShapePlan>> shape_plans_;
+    
+    // Kernel choice per batch size, falling back to default_config_.
+    // Selecting a variant is safe while Execute is running.
+    mutable std::shared_mutex kernel_configs_mutex_;
+    cpu::kernels::KernelConfig default_config_;
+    std::map<size_t, cpu::kernels::KernelConfig> batch_configs_;
+    
+    void InstallPlan(std::shared_ptr<const cpu::Plan> plan);
+    void UsePlan(std::shared_ptr<const cpu::Plan> plan);
+    std::filesystem::path GetPlanCachePath(const std::string& model_path) const;
+    void CreateContexts();
+    void RebuildShapePlans();
+    std::shared_ptr<const cpu::ShapePlan> FindShapePlan(const std::vector<atom::core::Tensor>& inputs) const;
+    size_t IntraOpThreads() const;
+    cpu::kernels::KernelConfig GetKernelConfig(const std::vector<atom::core::Tensor>& inputs) const;
 };
 
 } // namespace atom::inference
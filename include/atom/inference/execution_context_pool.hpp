@@ -0,0 +1,139 @@
+#pragma once
+
+#include "../core/types.hpp"
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace atom::inference {
+
+// Fixed set of execution contexts handed out to concurrent Execute calls.
+// Checkout and return are lock-free (a tagged Treiber stack of slot indices);
+// a caller only parks, on an atomic wait, when every context is in use.
+template<typename Context>
+class ExecutionContextPool {
+public:
+    // RAII checkout; returns the context to the pool on destruction
+    class Lease {
+    public:
+        Lease() = default;
+        Lease(ExecutionContextPool* pool, atom::core::u32 slot) : pool_(pool), slot_(slot) {}
+        ~Lease() { Release(); }
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        Lease(Lease&& other) noexcept : pool_(other.pool_), slot_(other.slot_) { other.pool_ = nullptr; }
+        Lease& operator=(Lease&& other) noexcept {
+            if (this != &other) {
+                Release();
+                pool_ = other.pool_;
+                slot_ = other.slot_;
+                other.pool_ = nullptr;
+            }
+            return *this;
+        }
+
+        Context& operator*() const { return *pool_->contexts_[slot_]; }
+        Context* operator->() const { return pool_->contexts_[slot_].get(); }
+        atom::core::u32 GetSlot() const { return slot_; }
+        explicit operator bool() const { return pool_ != nullptr; }
+
+    private:
+        ExecutionContextPool* pool_{nullptr};
+        atom::core::u32 slot_{0};
+
+        void Release() {
+            if (pool_) {
+                pool_->Push(slot_);
+                pool_ = nullptr;
+            }
+        }
+    };
+
+    ExecutionContextPool() = default;
+
+    ExecutionContextPool(const ExecutionContextPool&) = delete;
+    ExecutionContextPool& operator=(const ExecutionContextPool&) = delete;
+
+    // Replaces the contexts. Not safe while leases are outstanding.
+    void Reset(std::vector<std::unique_ptr<Context>> contexts) {
+        contexts_ = std::move(contexts);
+        next_ = std::make_unique<std::atomic<atom::core::u32>[]>(contexts_.size());
+        head_.store(Pack(0, kEmpty));
+        available_.store(0);
+        for (atom::core::u32 i = 0; i < contexts_.size(); ++i) {
+            Push(i);
+        }
+    }
+
+    void Clear() { Reset({}); }
+
+    // Blocks while every context is checked out
+    Lease Acquire() {
+        while (true) {
+            if (auto slot = Pop()) {
+                return Lease(this, *slot);
+            }
+            auto seen = available_.load(std::memory_order_acquire);
+            if (seen <= 0) {
+                available_.wait(seen, std::memory_order_acquire);
+            }
+        }
+    }
+
+    std::optional<Lease> TryAcquire() {
+        if (auto slot = Pop()) {
+            return Lease(this, *slot);
+        }
+        return std::nullopt;
+    }
+
+    size_t Size() const { return contexts_.size(); }
+    size_t Available() const { return static_cast<size_t>(std::max<atom::core::i64>(available_.load(), 0)); }
+
+    // Direct access for setup work while no leases are outstanding
+    Context& operator[](size_t index) { return *contexts_[index]; }
+    const Context& operator[](size_t index) const { return *contexts_[index]; }
+
+private:
+    static constexpr atom::core::u32 kEmpty = 0xFFFFFFFFu;
+
+    std::vector<std::unique_ptr<Context>> contexts_;
+    std::unique_ptr<std::atomic<atom::core::u32>[]> next_;
+    // {tag:32, slot:32}; the tag changes on every update so a stale head never matches
+    std::atomic<atom::core::u64> head_{Pack(0, kEmpty)};
+    std::atomic<atom::core::i64> available_{0};
+
+    static constexpr atom::core::u64 Pack(atom::core::u64 tag, atom::core::u32 slot) {
+        return (tag << 32) | slot;
+    }
+
+    std::optional<atom::core::u32> Pop() {
+        auto head = head_.load(std::memory_order_acquire);
+        while (true) {
+            const auto slot = static_cast<atom::core::u32>(head);
+            if (slot == kEmpty) return std::nullopt;
+
+            const auto next = next_[slot].load(std::memory_order_relaxed);
+            if (head_.compare_exchange_weak(head, Pack((head >> 32) + 1, next),
+                                            std::memory_order_acq_rel, std::memory_order_acquire)) {
+                available_.fetch_sub(1, std::memory_order_relaxed);
+                return slot;
+            }
+        }
+    }
+
+    void Push(atom::core::u32 slot) {
+        auto head = head_.load(std::memory_order_relaxed);
+        do {
+            next_[slot].store(static_cast<atom::core::u32>(head), std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(head, Pack((head >> 32) + 1, slot),
+                                              std::memory_order_release, std::memory_order_relaxed));
+
+        available_.fetch_add(1, std::memory_order_release);
+        available_.notify_one();
+    }
+};
+
+} // namespace atom::inference
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "backend.hpp"
+#include <array>
+#include <list>
+#include <map>
+#include <mutex>
+
+namespace atom::inference {
+
+// Where a request sits inside the bucket it was padded to. Padding is added
+// after the data (extra samples at the end of the batch, extra rows and
+// columns at the bottom and right), so the valid region of every padded
+// input, and of spatial outputs scaled down from it, starts at the origin.
+struct BucketPadding {
+    atom::core::i64 bucket_batch{0};
+    atom::core::i64 bucket_height{0};     // 0 when resolutions are not bucketed
+    atom::core::i64 bucket_width{0};
+    atom::core::i64 batch{0};             // request extent
+    atom::core::i64 height{0};
+    atom::core::i64 width{0};
+
+    bool IsPadded() const {
+        return batch != bucket_batch || height != bucket_height || width != bucket_width;
+    }
+};
+
+// Outputs are cut back to the request's batch; spatial padding is left in
+// place and described by `padding`
+struct BucketedOutputs {
+    std::vector<atom::core::Tensor> outputs;
+    BucketPadding padding;
+};
+
+struct ShapeBucketStats {
+    atom::core::i64 batch{0};
+    atom::core::i64 height{0};
+    atom::core::i64 width{0};
+    atom::core::u64 requests{0};
+    atom::core::u64 plan_builds{0};       // requests that found no resident plan
+    atom::core::u64 evictions{0};
+    atom::core::u64 valid_elements{0};    // input elements the requests carried
+    atom::core::u64 padded_elements{0};   // input elements computed, padding included
+
+    atom::core::f64 HitRate() const {
+        return requests ? 1.0 - static_cast<atom::core::f64>(plan_builds) / requests : 0.0;
+    }
+    atom::core::f64 PaddingWaste() const {
+        return padded_elements ? 1.0 - static_cast<atom::core::f64>(valid_elements) / padded_elements : 0.0;
+    }
+};
+
+struct ShapeBucketReport {
+    std::vector<ShapeBucketStats> buckets;    // in bucket order, used buckets only
+    ShapeBucketStats total;
+    atom::core::u64 rejected{0};              // requests larger than every bucket
+    size_t resident_plans{0};
+};
+
+// Serves arbitrary input shapes from a fixed set of shape buckets. Each
+// request is padded to the smallest bucket that holds it, so the backend
+// only ever sees bucket shapes; the plan for a bucket is prepared on first
+// use and, with ShapeBucketOptions::max_plans, the least recently used plan
+// is released when the limit is reached. Batch is dimension 0 of every
+// input; resolutions apply to dimensions 2 and 3 of NCHW inputs.
+// Thread-safe.
+class ShapeBucketer {
+public:
+    ShapeBucketer(IBackend& backend, atom::core::ShapeBucketOptions options);
+
+    // Smallest bucket holding the shape, by padded element count
+    atom::core::Result<BucketPadding> SelectBucket(const atom::core::Shape& shape) const;
+    bool Fits(const atom::core::Shape& shape) const { return SelectBucket(shape).has_value(); }
+
+    atom::core::Result<BucketedOutputs> Execute(const std::vector<atom::core::Tensor>& inputs);
+
+    using BucketedCallback = std::function<void(atom::core::Result<BucketedOutputs>)>;
+    atom::core::Result<void> ExecuteAsync(std::vector<atom::core::Tensor> inputs, BucketedCallback callback);
+
+    // Prepares the plan of every bucket up front instead of on first use
+    atom::core::Result<void> PrepareAll(const std::vector<atom::core::Shape>& input_shapes);
+
+    ShapeBucketReport GetReport() const;
+    void ResetStats();
+
+    const atom::core::ShapeBucketOptions& GetOptions() const { return options_; }
+
+private:
+    using BucketKey = std::array<atom::core::i64, 3>;
+
+    IBackend& backend_;
+    atom::core::ShapeBucketOptions options_;      // buckets sorted ascending
+
+    mutable std::mutex mutex_;
+    std::list<std::vector<atom::core::Shape>> lru_;   // resident plans, most recent first
+    std::map<std::vector<atom::core::Shape>, std::list<std::vector<atom::core::Shape>>::iterator> resident_;
+    std::map<BucketKey, ShapeBucketStats> stats_;
+    atom::core::u64 rejected_{0};
+
+    // Pads the inputs to their bucket and makes sure its plan is resident.
+    // Plans are built under the lock, so each is built once.
+    atom::core::Result<std::vector<atom::core::Tensor>> Enter(const std::vector<atom::core::Tensor>& inputs,
+                                                              BucketPadding& padding);
+    atom::core::Result<void> Acquire(const std::vector<atom::core::Shape>& shapes, ShapeBucketStats* stats);
+    atom::core::Shape BucketShape(const atom::core::Shape& shape, const BucketPadding& padding) const;
+    atom::core::Result<atom::core::Tensor> Pad(const atom::core::Tensor& input, const BucketPadding& padding) const;
+    static atom::core::Result<BucketedOutputs> Crop(std::vector<atom::core::Tensor> outputs,
+                                                    const BucketPadding& padding);
+};
+
+} // namespace atom::inference
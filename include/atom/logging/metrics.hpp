@@ -4,8 +4,10 @@
 #include <string>
 #include <map>
 #include <atomic>
-#include <mutex>
 #include <chrono>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
 
 namespace atom::logging {
 
@@ -62,7 +64,8 @@ public:
     MetricsRegistry(MetricsRegistry&&) = delete;
     MetricsRegistry& operator=(MetricsRegistry&&) = delete;
     
-    // Register metrics
+    // Register metrics. Registering an existing name returns that metric, and
+    // references stay valid for the life of the process.
     Counter& RegisterCounter(const std::string& name);
     Gauge& RegisterGauge(const std::string& name);
     Histogram& RegisterHistogram(const std::string& name);
@@ -76,6 +79,7 @@ public:
     std::string ExportJSON() const;
     std::string ExportPrometheus() const;
     
+    // Zeroes every metric; registrations are kept
     void Clear();
     
 private:
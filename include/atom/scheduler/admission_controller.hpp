@@ -0,0 +1,89 @@
+#pragma once
+
+#include "../core/types.hpp"
+#include <array>
+#include <mutex>
+
+namespace atom::scheduler {
+
+// How the adaptive concurrency limit follows observed queueing
+enum class LimitAlgorithm {
+    None,           // only SchedulerConfig::max_queue_size applies
+    Aimd,           // +1 while the limit is in use, x backoff_ratio on a late or shed task
+    Gradient        // scaled by how far queueing inflates latency over execution time
+};
+
+// Admission control configuration
+struct AdmissionConfig {
+    LimitAlgorithm algorithm{LimitAlgorithm::None};
+    size_t initial_limit{64};
+    size_t min_limit{1};                    // raised to the worker count by the Scheduler
+    size_t max_limit{4096};
+
+    // Aimd: queue delay above the target cuts the limit, at most once per
+    // window of tasks admitted under the previous limit
+    atom::core::Duration target_queue_delay{std::chrono::milliseconds(5)};
+    double backoff_ratio{0.9};
+
+    // Gradient: the limit is scaled by tolerance * execution / (execution +
+    // queue delay), clamped to [0.5, 1], plus sqrt(limit) of queue headroom,
+    // and moved towards that by smoothing per completed task
+    double tolerance{2.0};
+    double smoothing{0.2};
+
+    // Fraction of the concurrency limit and of max_queue_size each priority
+    // (Low..Critical) may fill; the rest is kept for higher priorities
+    std::array<double, 4> priority_share{0.6, 0.8, 0.9, 1.0};
+};
+
+// Front door of the Scheduler. Counts admitted tasks that have not finished
+// (in flight) and those not yet started (queued), and fails a submission
+// with ErrorCode::QueueFull when either would exceed its priority's share of
+// the static queue cap or of the adaptive concurrency limit, so overload is
+// rejected up front instead of piling up as queueing delay. The limit is
+// driven by the queue delay of completed tasks, after Netflix's
+// concurrency-limits. Thread-safe.
+class AdmissionController {
+public:
+    AdmissionController(size_t max_queue_size, AdmissionConfig config);
+
+    // Reserves room for count tasks, or QueueFull. An otherwise empty
+    // scheduler always admits, so an oversized request cannot be starved.
+    atom::core::Result<void> Acquire(atom::core::Priority priority, size_t count = 1);
+
+    // An admitted task reached a worker
+    void OnStarted();
+
+    // Admitted tasks finished without a latency signal: failed submissions,
+    // cancellations, failures, graph nodes that never ran
+    void Release(size_t count, bool started);
+
+    // A task ran to completion after waiting queue_delay in the ready queue
+    void Release(atom::core::Duration queue_delay, atom::core::Duration execution_time);
+
+    // A task was shed for its deadline before starting: congestion
+    void ReleaseDropped();
+
+    size_t GetLimit() const;
+    size_t GetInFlight() const;
+    size_t GetQueued() const;
+    const AdmissionConfig& GetConfig() const { return config_; }
+
+private:
+    size_t max_queue_size_;
+    AdmissionConfig config_;
+
+    mutable std::mutex mutex_;
+    double limit_;
+    size_t in_flight_{0};
+    size_t queued_{0};
+    size_t cooldown_{0};                    // Aimd: releases until the next decrease
+    double queue_delay_ns_{0.0};            // Gradient: moving averages
+    double execution_ns_{0.0};
+    bool has_samples_{false};
+
+    void Decrease(double ratio);
+    void Clamp();
+};
+
+} // namespace atom::scheduler
@@ -0,0 +1,405 @@
+#pragma once
+
+#include "thread_pool.hpp"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace atom::scheduler {
+
+// Coroutines on top of the Scheduler and ThreadPool. A request chains its
+// stages without blocking a thread:
+//
+//     CoTask<Result<TaskResult>> Handle(Scheduler& scheduler, ModelPtr model, Tensor image) {
+//         auto result = co_await scheduler.Submit(model, {Preprocess(image)});
+//         ...                                     // continues on a scheduler worker
+//     }
+//
+// CoTask is lazy: it starts when awaited, or with Spawn or SyncWait, and
+// resumes its awaiter when it finishes. WhenAll awaits several at once. An
+// exception escaping a coroutine is rethrown where it is awaited.
+
+template<typename T = void>
+class CoTask;
+
+namespace detail {
+
+// Hands the finishing coroutine's thread straight to its awaiter
+struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+    template<typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+        auto continuation = handle.promise().GetContinuation();
+        return continuation ? continuation : std::noop_coroutine();
+    }
+    void await_resume() const noexcept {}
+};
+
+class CoTaskPromiseBase {
+public:
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+    void SetContinuation(std::coroutine_handle<> continuation) { continuation_ = continuation; }
+    std::coroutine_handle<> GetContinuation() const { return continuation_; }
+
+protected:
+    void RethrowIfFailed() const {
+        if (exception_) std::rethrow_exception(exception_);
+    }
+
+private:
+    std::coroutine_handle<> continuation_;
+    std::exception_ptr exception_;
+};
+
+template<typename T>
+class CoTaskPromise : public CoTaskPromiseBase {
+public:
+    CoTask<T> get_return_object() noexcept;
+
+    template<typename U>
+        requires std::convertible_to<U&&, T>
+    void return_value(U&& value) { value_.emplace(std::forward<U>(value)); }
+
+    T TakeResult() {
+        RethrowIfFailed();
+        return std::move(*value_);
+    }
+
+private:
+    std::optional<T> value_;
+};
+
+template<>
+class CoTaskPromise<void> : public CoTaskPromiseBase {
+public:
+    CoTask<void> get_return_object() noexcept;
+    void return_void() const noexcept {}
+    void TakeResult() const { RethrowIfFailed(); }
+};
+
+} // namespace detail
+
+// Lazily started coroutine producing a T. Move-only; destroying it destroys
+// the coroutine, so it must outlive its co_await (it does as a temporary).
+template<typename T>
+class [[nodiscard]] CoTask {
+public:
+    using promise_type = detail::CoTaskPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    CoTask() noexcept = default;
+    explicit CoTask(Handle handle) noexcept : handle_(handle) {}
+
+    CoTask(CoTask&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    CoTask& operator=(CoTask&& other) noexcept {
+        if (this != &other) {
+            Destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+
+    CoTask(const CoTask&) = delete;
+    CoTask& operator=(const CoTask&) = delete;
+
+    ~CoTask() { Destroy(); }
+
+    bool IsValid() const noexcept { return static_cast<bool>(handle_); }
+
+    // Starts the coroutine on the awaiting thread
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            Handle handle;
+
+            bool await_ready() const noexcept { return handle.done(); }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().SetContinuation(awaiting);
+                return handle;
+            }
+            T await_resume() { return handle.promise().TakeResult(); }
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    Handle handle_;
+
+    void Destroy() {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = {};
+        }
+    }
+};
+
+namespace detail {
+
+template<typename T>
+CoTask<T> CoTaskPromise<T>::get_return_object() noexcept {
+    return CoTask<T>(std::coroutine_handle<CoTaskPromise>::from_promise(*this));
+}
+
+inline CoTask<void> CoTaskPromise<void>::get_return_object() noexcept {
+    return CoTask<void>(std::coroutine_handle<CoTaskPromise>::from_promise(*this));
+}
+
+// What co_await on an A yields (member operator co_await or an awaiter)
+template<typename A>
+decltype(auto) GetAwaiter(A&& awaitable) {
+    if constexpr (requires { std::forward<A>(awaitable).operator co_await(); }) {
+        return std::forward<A>(awaitable).operator co_await();
+    } else {
+        return std::forward<A>(awaitable);
+    }
+}
+
+template<typename A>
+using AwaitResult = decltype(GetAwaiter(std::declval<A>()).await_resume());
+
+template<typename T>
+using Stored = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+template<typename T>
+struct Outcome {
+    std::optional<Stored<T>> value;
+    std::exception_ptr error;
+};
+
+// Counts down the coroutines started by WhenAll or SyncWait. The last
+// arrival resumes the waiting coroutine or, without one, wakes Wait.
+class Latch {
+public:
+    explicit Latch(size_t count) : count_(count) {}
+
+    Latch(const Latch&) = delete;
+    Latch& operator=(const Latch&) = delete;
+
+    void SetWaiter(std::coroutine_handle<> waiter) { waiter_ = waiter; }
+
+    // True for the arrival that brings the count to zero
+    bool Arrive() noexcept { return count_.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+
+    // Called by the last arrival; returns what it should resume
+    std::coroutine_handle<> Complete() noexcept {
+        if (waiter_) return waiter_;
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_ = true;
+        cv_.notify_all();
+        return std::noop_coroutine();
+    }
+
+    void Wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return done_; });
+    }
+
+private:
+    std::atomic<size_t> count_;
+    std::coroutine_handle<> waiter_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool done_{false};
+};
+
+// Coroutine that awaits one awaitable for a Latch and arrives when done
+class LatchTask {
+public:
+    struct promise_type {
+        Latch* latch{nullptr};
+
+        LatchTask get_return_object() noexcept {
+            return LatchTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        auto final_suspend() const noexcept {
+            struct ArriveAwaiter {
+                bool await_ready() const noexcept { return false; }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                    // The frame may be destroyed as soon as the latch completes
+                    Latch& latch = *handle.promise().latch;
+                    return latch.Arrive() ? latch.Complete() : std::noop_coroutine();
+                }
+                void await_resume() const noexcept {}
+            };
+            return ArriveAwaiter{};
+        }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }   // AwaitInto catches
+    };
+
+    explicit LatchTask(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+    LatchTask(LatchTask&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    LatchTask& operator=(LatchTask&&) = delete;
+    ~LatchTask() {
+        if (handle_) handle_.destroy();
+    }
+
+    void Start(Latch& latch) {
+        handle_.promise().latch = &latch;
+        handle_.resume();
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+template<typename A>
+LatchTask AwaitInto(A awaitable, Outcome<AwaitResult<A>>& outcome) {
+    try {
+        if constexpr (std::is_void_v<AwaitResult<A>>) {
+            co_await std::move(awaitable);
+            outcome.value.emplace();
+        } else {
+            outcome.value.emplace(co_await std::move(awaitable));
+        }
+    } catch (...) {
+        outcome.error = std::current_exception();
+    }
+}
+
+// Starts every task and suspends until all have arrived; the extra count is
+// the awaiting coroutine's own, so it only suspends if something is left
+class StartAll {
+public:
+    explicit StartAll(std::span<LatchTask> tasks) : tasks_(tasks), latch_(tasks.size() + 1) {}
+
+    bool await_ready() const noexcept { return tasks_.empty(); }
+    bool await_suspend(std::coroutine_handle<> waiter) {
+        latch_.SetWaiter(waiter);
+        for (auto& task : tasks_) {
+            task.Start(latch_);
+        }
+        return !latch_.Arrive();
+    }
+    void await_resume() const noexcept {}
+
+private:
+    std::span<LatchTask> tasks_;
+    Latch latch_;
+};
+
+template<typename T>
+Stored<T> TakeOutcome(Outcome<T>& outcome) {
+    if (outcome.error) std::rethrow_exception(outcome.error);
+    return std::move(*outcome.value);
+}
+
+template<typename T>
+using WhenAllResult = std::conditional_t<std::is_void_v<T>, void, std::vector<T>>;
+
+// Self-destroying coroutine behind Spawn
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() noexcept {
+            return Detached{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept {}   // dropped, as by ThreadPool::Post
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+inline Detached Detach(CoTask<void> task) {
+    co_await std::move(task);
+}
+
+} // namespace detail
+
+// Awaits every awaitable (CoTasks, Scheduler::Submit, ...) concurrently:
+// each starts on the awaiting thread and runs until it first suspends, and
+// the awaiting coroutine resumes on whichever thread finishes the last one.
+// Yields the results in order (nothing for void); the first exception, in
+// order, is rethrown once all are done.
+template<typename A>
+auto WhenAll(std::vector<A> awaitables) -> CoTask<detail::WhenAllResult<detail::AwaitResult<A>>> {
+    using T = detail::AwaitResult<A>;
+    std::vector<detail::Outcome<T>> outcomes(awaitables.size());
+    std::vector<detail::LatchTask> tasks;
+    tasks.reserve(awaitables.size());
+    for (size_t i = 0; i < awaitables.size(); ++i) {
+        tasks.push_back(detail::AwaitInto(std::move(awaitables[i]), outcomes[i]));
+    }
+
+    co_await detail::StartAll(tasks);
+
+    if constexpr (std::is_void_v<T>) {
+        for (auto& outcome : outcomes) {
+            detail::TakeOutcome(outcome);
+        }
+    } else {
+        std::vector<T> results;
+        results.reserve(outcomes.size());
+        for (auto& outcome : outcomes) {
+            results.push_back(detail::TakeOutcome(outcome));
+        }
+        co_return results;
+    }
+}
+
+// Fixed set of awaitables of any types; void results become std::monostate
+template<typename... As>
+    requires(sizeof...(As) > 0)
+auto WhenAll(As... awaitables) -> CoTask<std::tuple<detail::Stored<detail::AwaitResult<As>>...>> {
+    std::tuple<detail::Outcome<detail::AwaitResult<As>>...> outcomes;
+    auto tasks = std::apply([&](auto&... outcome) {
+        return std::array<detail::LatchTask, sizeof...(As)>{
+            detail::AwaitInto(std::move(awaitables), outcome)...
+        };
+    }, outcomes);
+
+    co_await detail::StartAll(tasks);
+
+    co_return std::apply([](auto&... outcome) {
+        return std::tuple<detail::Stored<detail::AwaitResult<As>>...>{detail::TakeOutcome(outcome)...};
+    }, outcomes);
+}
+
+// Blocks the calling (non-worker) thread until the awaitable finishes and
+// returns its result. One thread can drive any number of inferences this
+// way: SyncWait(WhenAll(std::move(requests))).
+template<typename A>
+auto SyncWait(A awaitable) -> detail::AwaitResult<A> {
+    using T = detail::AwaitResult<A>;
+    detail::Outcome<T> outcome;
+    detail::Latch latch(1);
+    auto task = detail::AwaitInto(std::move(awaitable), outcome);
+    task.Start(latch);
+    latch.Wait();
+
+    if constexpr (std::is_void_v<T>) {
+        detail::TakeOutcome(outcome);
+    } else {
+        return detail::TakeOutcome(outcome);
+    }
+}
+
+// Runs the coroutine on a pool worker without waiting for it. The frame
+// frees itself when done; an exception escaping it is dropped, as with
+// ThreadPool::Post. Throws if the pool is stopped.
+inline void Spawn(ThreadPool& pool, CoTask<void> task, int node = -1) {
+    auto handle = detail::Detach(std::move(task)).handle;
+    try {
+        pool.Post([handle]() { handle.resume(); }, node);
+    } catch (...) {
+        handle.destroy();
+        throw;
+    }
+}
+
+} // namespace atom::scheduler
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "../core/types.hpp"
+#include "../core/tensor.hpp"
+#include "../core/model_interface.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace atom::scheduler {
+
+// Dynamic batching configuration
+// Batch sizes count rows along dim 0, summed over the requests in a batch;
+// a request larger than max_batch_size runs alone.
+struct BatchingConfig {
+    size_t max_batch_size{8};
+    atom::core::Duration max_queue_delay{std::chrono::milliseconds(2)};
+    // Batch sizes the model runs best at; a batch is dispatched as soon as the
+    // largest one is reached and otherwise rounded down to one of them
+    std::vector<size_t> preferred_batch_sizes;
+    size_t max_queue_size{1024};
+    // Batches on the model at once; while they run, requests keep queueing
+    // and form the next batch
+    size_t max_in_flight{2};
+};
+
+// Accumulates compatible requests for one model and runs them as a single
+// batched Infer. Requests are compatible when every input agrees on data
+// type, device and all dimensions but the batch dimension.
+class DynamicBatcher {
+public:
+    using Completion = std::function<void(atom::core::Result<std::vector<atom::core::Tensor>>)>;
+
+    DynamicBatcher(atom::core::ModelPtr model, BatchingConfig config);
+    ~DynamicBatcher();
+
+    DynamicBatcher(const DynamicBatcher&) = delete;
+    DynamicBatcher& operator=(const DynamicBatcher&) = delete;
+    DynamicBatcher(DynamicBatcher&&) = delete;
+    DynamicBatcher& operator=(DynamicBatcher&&) = delete;
+
+    // Lifecycle. Stop dispatches what is still queued and returns once every
+    // batch has completed, so no completion outlives the batcher.
+    void Start();
+    void Stop();
+    bool IsRunning() const { return running_; }
+
+    // Queues one request. The completion receives this request's slice of the
+    // batched outputs and runs on the model's inference thread.
+    atom::core::Result<void> Enqueue(std::vector<atom::core::Tensor> inputs, Completion completion);
+
+    const BatchingConfig& GetConfig() const { return config_; }
+    size_t GetQueuedCount() const;
+
+    // Statistics
+    struct Statistics {
+        std::atomic<uint64_t> total_requests{0};
+        std::atomic<uint64_t> total_batches{0};
+        std::atomic<uint64_t> failed_batches{0};
+        std::atomic<uint64_t> total_queue_delay_ns{0};
+        std::atomic<uint64_t> max_queue_delay_ns{0};
+        // batch_size_histogram[n] counts dispatched batches of n rows
+        std::vector<std::atomic<uint64_t>> batch_size_histogram;
+        atom::core::TimePoint start_time{std::chrono::high_resolution_clock::now()};
+
+        double GetAverageBatchSize() const {
+            auto batches = total_batches.load();
+            if (batches == 0) return 0.0;
+            return static_cast<double>(total_requests.load()) / batches;
+        }
+
+        double GetAverageQueueDelayMs() const {
+            auto count = total_requests.load();
+            if (count == 0) return 0.0;
+            return (total_queue_delay_ns.load() / 1000000.0) / count;
+        }
+
+        // Requests per second since start or the last reset
+        double GetThroughput() const {
+            auto elapsed = std::chrono::duration<double>(
+                std::chrono::high_resolution_clock::now() - start_time).count();
+            if (elapsed <= 0.0) return 0.0;
+            return total_requests.load() / elapsed;
+        }
+    };
+
+    const Statistics& GetStatistics() const { return stats_; }
+    std::vector<uint64_t> GetBatchSizeHistogram() const;
+    void ResetStatistics();
+
+private:
+    struct Request {
+        std::vector<atom::core::Tensor> inputs;
+        Completion completion;
+        atom::core::TimePoint enqueue_time;
+        size_t rows;                        // dim 0 of the first input
+    };
+
+    atom::core::ModelPtr model_;
+    BatchingConfig config_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Request> queue_;
+    size_t queued_rows_{0};
+    std::atomic<bool> running_{false};
+    std::thread batch_thread_;
+    size_t in_flight_{0};                   // dispatched batches not yet completed
+    std::condition_variable idle_cv_;
+
+    Statistics stats_;
+
+    void BatchLoop();
+    std::vector<Request> TakeBatch(size_t target_rows);
+    size_t ChooseBatchSize(size_t available) const;
+    void Dispatch(std::vector<Request> batch);
+    void Deliver(std::vector<Completion>& completions, const std::vector<atom::core::i64>& batch_sizes,
+                 atom::core::Result<std::vector<atom::core::Tensor>> result);
+    void FailAll(std::vector<Completion>& completions, const atom::core::Error& error);
+    void FinishBatch();
+
+    static bool IsCompatible(const Request& a, const Request& b);
+};
+
+} // namespace atom::scheduler
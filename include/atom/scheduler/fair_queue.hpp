@@ -0,0 +1,96 @@
+#pragma once
+
+#include "task.hpp"
+#include "../core/types.hpp"
+#include <array>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace atom::scheduler {
+
+// Order of ready tasks within one tenant
+enum class SchedulingPolicy {
+    Priority,                   // submission order
+    EarliestDeadlineFirst       // earliest deadline, then submission order
+};
+
+// Ready queue of the Scheduler. Priority classes are served strictly, except
+// that a non-empty class left unserved for aging_interval goes next, so Low
+// is delayed but never starved. Within a class, tenants (Task::GetTenant(),
+// or the model name) share dispatches by weight with start-time fair
+// queuing: each backlogged tenant carries a virtual finish tag advanced by
+// 1 / weight per dispatch, and the smallest tag goes first. A tenant that
+// floods the queue therefore only lengthens its own backlog. An idle tenant
+// is forgotten once virtual time passes its tag (or its class drains), when
+// it has no credit or debt left to remember.
+//
+// Push and Pop are O(log tenants + log tasks of the tenant). Not thread-safe.
+class FairQueue {
+public:
+    explicit FairQueue(SchedulingPolicy policy = SchedulingPolicy::EarliestDeadlineFirst,
+                       atom::core::Duration aging_interval = std::chrono::seconds(1));
+
+    void Push(TaskPtr task);
+
+    // nullptr when empty
+    TaskPtr Pop();
+
+    // Weight 1 by default; applies to tasks pushed after the call
+    void SetWeight(const std::string& tenant, double weight);
+
+    size_t Size() const { return size_; }
+    bool Empty() const { return size_ == 0; }
+
+private:
+    struct Tenant {
+        std::vector<TaskPtr> tasks;         // heap, best on top
+        double weight{1.0};
+        double tag{0.0};                    // virtual finish of the next (or last) dispatch
+        const std::string* key{nullptr};    // its key in Class::tenants
+        bool idle_listed{false};            // has an entry in Class::idle
+    };
+
+    struct IdleEntry {
+        double tag;
+        Tenant* tenant;
+    };
+
+    struct HeapEntry {
+        double tag;
+        atom::core::u64 sequence;           // FIFO among equal tags
+        Tenant* tenant;
+    };
+
+    using TenantMap = std::unordered_map<std::string, Tenant>;
+
+    struct Class {
+        TenantMap tenants;
+        std::vector<TenantMap::node_type> spare;    // forgotten tenants' nodes, reused by Push
+        std::vector<HeapEntry> backlogged;  // min-heap on (tag, sequence)
+        std::vector<IdleEntry> idle;        // min-heap on tag, one entry per idle tenant
+        double virtual_time{0.0};
+        size_t size{0};
+        atom::core::TimePoint waiting_since{};
+    };
+
+    static constexpr size_t kClassCount = static_cast<size_t>(atom::core::Priority::Critical) + 1;
+    static constexpr size_t kSpareTenants = 64;    // per class
+
+    SchedulingPolicy policy_;
+    atom::core::Duration aging_interval_;
+    std::array<Class, kClassCount> classes_;
+    std::map<std::string, double> weights_;
+    atom::core::u64 sequence_{0};
+    size_t size_{0};
+
+    bool TaskLess(const TaskPtr& a, const TaskPtr& b) const;
+    void Activate(Class& cls, Tenant& tenant, double tag);
+    void RetireIdle(Class& cls);
+    TenantMap::iterator FindTenant(Class& cls, const std::string& key);
+    void Forget(Class& cls, TenantMap::iterator it);
+    size_t PickClass(atom::core::TimePoint now) const;
+};
+
+} // namespace atom::scheduler
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace atom::scheduler {
+
+// Move-only callable with small-buffer storage: callables up to Capacity
+// bytes (that move without throwing) live inline, larger ones on the heap.
+// Unlike std::function it accepts move-only callables such as
+// std::packaged_task, and it never allocates for the typical lambda
+// capturing a few pointers. The signature defaults to void().
+template<size_t Capacity, typename Signature = void()>
+class InlineFunction;
+
+template<size_t Capacity, typename R, typename... Args>
+class InlineFunction<Capacity, R(Args...)> {
+public:
+    InlineFunction() noexcept = default;
+    InlineFunction(std::nullptr_t) noexcept {}   // NOLINT: implicit like std::function
+
+    template<typename F, typename D = std::decay_t<F>>
+        requires(!std::is_same_v<D, InlineFunction> && std::is_invocable_r_v<R, D&, Args...>)
+    InlineFunction(F&& f) {   // NOLINT: implicit like std::function
+        if constexpr (kNullable<D>) {
+            if (!f) return;   // an empty std::function or null pointer stays empty
+        }
+        if constexpr (kFitsInline<D>) {
+            ::new (static_cast<void*>(storage_)) D(std::forward<F>(f));
+            ops_ = &kInlineOps<D>;
+        } else {
+            *reinterpret_cast<D**>(storage_) = new D(std::forward<F>(f));
+            ops_ = &kHeapOps<D>;
+        }
+    }
+
+    InlineFunction(InlineFunction&& other) noexcept : ops_(other.ops_) {
+        if (ops_) {
+            ops_->relocate(storage_, other.storage_);
+            other.ops_ = nullptr;
+        }
+    }
+
+    InlineFunction& operator=(InlineFunction&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            ops_ = other.ops_;
+            if (ops_) {
+                ops_->relocate(storage_, other.storage_);
+                other.ops_ = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    InlineFunction(const InlineFunction&) = delete;
+    InlineFunction& operator=(const InlineFunction&) = delete;
+
+    ~InlineFunction() { Reset(); }
+
+    R operator()(Args... args) { return ops_->invoke(storage_, std::forward<Args>(args)...); }
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    void Reset() noexcept {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        R (*invoke)(void*, Args&&...);
+        void (*relocate)(void* to, void* from) noexcept;   // move-construct, then destroy the source
+        void (*destroy)(void*) noexcept;
+    };
+
+    template<typename D>
+    static constexpr bool kNullable = std::is_pointer_v<D> || std::is_member_pointer_v<D> ||
+                                      std::is_same_v<D, std::function<R(Args...)>>;
+
+    template<typename D>
+    static constexpr bool kFitsInline = sizeof(D) <= Capacity && alignof(D) <= alignof(std::max_align_t) &&
+                                        std::is_nothrow_move_constructible_v<D>;
+
+    template<typename D>
+    static constexpr Ops kInlineOps{
+        [](void* self, Args&&... args) -> R {
+            return std::invoke(*static_cast<D*>(self), std::forward<Args>(args)...);
+        },
+        [](void* to, void* from) noexcept {
+            ::new (to) D(std::move(*static_cast<D*>(from)));
+            static_cast<D*>(from)->~D();
+        },
+        [](void* self) noexcept { static_cast<D*>(self)->~D(); }};
+
+    template<typename D>
+    static constexpr Ops kHeapOps{
+        [](void* self, Args&&... args) -> R {
+            return std::invoke(**static_cast<D**>(self), std::forward<Args>(args)...);
+        },
+        [](void* to, void* from) noexcept { *static_cast<D**>(to) = *static_cast<D**>(from); },
+        [](void* self) noexcept { delete *static_cast<D**>(self); }};
+
+    alignas(std::max_align_t) std::byte storage_[Capacity];
+    const Ops* ops_{nullptr};
+};
+
+} // namespace atom::scheduler
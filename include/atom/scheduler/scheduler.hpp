@@ -1,21 +1,60 @@
 #pragma once
 
 #include "task.hpp"
+#include "admission_controller.hpp"
 #include "thread_pool.hpp"
-#include "dependency_graph.hpp"
+#include "dynamic_batcher.hpp"
+#include "fair_queue.hpp"
+#include "task_graph.hpp"
+#include "task_pool.hpp"
 #include "../core/types.hpp"
+#include <array>
 #include <queue>
 #include <map>
 #include <atomic>
+#include <shared_mutex>
+#include <coroutine>
 
 namespace atom::scheduler {
 
 // Scheduler configuration
 struct SchedulerConfig {
     size_t num_threads{std::thread::hardware_concurrency()};
-    size_t max_queue_size{1000};
+    size_t max_queue_size{1000};                // admitted tasks not yet started, 0 = unbounded
     bool enable_profiling{false};
-    atom::core::Duration task_timeout{std::chrono::seconds(30)};
+    atom::core::Duration task_timeout{std::chrono::seconds(30)};   // default deadline, <= 0 = none
+    SchedulingPolicy policy{SchedulingPolicy::EarliestDeadlineFirst};
+
+    // Fair sharing (see FairQueue): relative weights per tenant (default 1),
+    // and how long a lower priority class may wait before it is served anyway
+    std::map<std::string, double> tenant_weights;
+    atom::core::Duration aging_interval{std::chrono::seconds(1)};
+
+    // Fail tasks with ErrorCode::Timeout instead of running them once their
+    // deadline has passed, or when the model's median execution time (after
+    // min_latency_samples runs) says they cannot finish in time
+    bool shed_late_tasks{true};
+    size_t min_latency_samples{8};
+
+    // How long a finished task's result stays available to WaitForTask and
+    // GetTaskStatus when nobody takes it; taking it retires the task at once
+    atom::core::Duration result_retention{std::chrono::seconds(10)};
+
+    // Submissions beyond max_queue_size or the adaptive concurrency limit
+    // fail at once with ErrorCode::QueueFull (see AdmissionController)
+    AdmissionConfig admission;
+
+    // Worker pinning (see ThreadPool). Once workers are grouped by NUMA
+    // node, a task runs on the node of SubmitOptions::numa_node, else of
+    // its model (SetModelNumaNode), else of its first input's memory.
+    atom::core::AffinityPolicy worker_affinity{atom::core::AffinityPolicy::None};
+};
+
+// Per-submission options
+struct SubmitOptions {
+    std::optional<atom::core::Duration> timeout{};  // deadline from now; default config task_timeout
+    std::string tenant{};                           // fair-share identity; empty = the model's name
+    std::optional<int> numa_node{};                 // workers to run on; default see worker_affinity
 };
 
 // Scheduler for parallel task execution
@@ -40,7 +79,8 @@ public:
         atom::core::ModelPtr model,
         std::vector<atom::core::Tensor> inputs,
         atom::core::Priority priority = atom::core::Priority::Normal,
-        Task::Callback callback = nullptr
+        Task::Callback callback = nullptr,
+        const SubmitOptions& options = {}
     );
     
     atom::core::Result<TaskId> SubmitTaskWithDependencies(
@@ -48,16 +88,86 @@ public:
         std::vector<atom::core::Tensor> inputs,
         std::vector<TaskId> dependencies,
         atom::core::Priority priority = atom::core::Priority::Normal,
-        Task::Callback callback = nullptr
+        Task::Callback callback = nullptr,
+        const SubmitOptions& options = {}
     );
     
-    // Batch submission
+    // Awaitable submission for coroutines (see coroutine.hpp). co_await
+    // suspends without holding a thread and resumes on a worker once the
+    // task finished, yielding its result. The result is handed over rather
+    // than kept for result_retention, so WaitForTask does not know the task.
+    // A task that is not admitted yields the error without suspending.
+    class SubmitAwaiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle);
+        atom::core::Result<TaskResult> await_resume();
+        
+    private:
+        friend class Scheduler;
+        SubmitAwaiter(Scheduler& scheduler, atom::core::ModelPtr model, std::vector<atom::core::Tensor> inputs,
+                      atom::core::Priority priority, SubmitOptions options);
+        
+        Scheduler* scheduler_;
+        atom::core::ModelPtr model_;
+        std::vector<atom::core::Tensor> inputs_;
+        atom::core::Priority priority_;
+        SubmitOptions options_;
+        std::optional<TaskResult> result_;
+        std::optional<atom::core::Error> error_;
+    };
+    
+    // Overloads rather than a defaulted SubmitOptions: GCC 12 destroys
+    // class-type default arguments of a co_await operand twice
+    SubmitAwaiter Submit(
+        atom::core::ModelPtr model,
+        std::vector<atom::core::Tensor> inputs,
+        atom::core::Priority priority = atom::core::Priority::Normal
+    );
+    SubmitAwaiter Submit(
+        atom::core::ModelPtr model,
+        std::vector<atom::core::Tensor> inputs,
+        atom::core::Priority priority,
+        SubmitOptions options
+    );
+    
+    // Batch submission, all or nothing: if a task is refused, those already
+    // submitted are cancelled (or, if running, their results dropped)
     atom::core::Result<std::vector<TaskId>> SubmitBatch(
         const std::vector<std::pair<atom::core::ModelPtr, std::vector<atom::core::Tensor>>>& batch,
-        atom::core::Priority priority = atom::core::Priority::Normal
+        atom::core::Priority priority = atom::core::Priority::Normal,
+        const SubmitOptions& options = {}
     );
     
-    // Task control
+    // Runs a compiled task graph with the given inputs at its roots. Nodes
+    // are scheduled like tasks (priority, tenant, deadline from options; the
+    // tenant defaults to the graph's name) but are not visible to
+    // WaitForTask or CancelTask; the callback receives the sink outputs once
+    // every node has finished, or the first failure once the rest drained.
+    atom::core::Result<void> SubmitGraph(
+        const TaskGraphPtr& graph,
+        std::vector<atom::core::Tensor> inputs,
+        GraphRun::Callback callback,
+        const SubmitOptions& options = {}
+    );
+    
+    // NUMA node holding the model's replica; its tasks are routed there
+    // unless submitted with a node. -1 removes the mapping.
+    void SetModelNumaNode(const atom::core::ModelPtr& model, int node);
+    
+    // Relative share of dispatches for a tenant within each priority class
+    void SetTenantWeight(const std::string& tenant, double weight);
+    
+    // Dynamic batching: tasks for this model are accumulated and run as one
+    // batched Infer instead of one Infer per task
+    atom::core::Result<void> EnableBatching(atom::core::ModelPtr model, BatchingConfig config);
+    void DisableBatching(const atom::core::ModelPtr& model);
+    const DynamicBatcher* GetBatcher(const atom::core::ModelPtr& model) const;
+    
+    // Task control. Task ids are generation-tagged slots of a recycled pool:
+    // WaitForTask hands the result over and retires the id (concurrent
+    // waiters all receive it), so does result_retention passing unclaimed,
+    // and a retired id is reported as unknown.
     atom::core::Result<void> CancelTask(TaskId task_id);
     atom::core::Result<TaskResult> WaitForTask(TaskId task_id, 
         std::optional<atom::core::Duration> timeout = std::nullopt);
@@ -70,6 +180,11 @@ public:
     size_t GetQueuedTaskCount() const;
     size_t GetRunningTaskCount() const;
     size_t GetCompletedTaskCount() const;
+    size_t GetTrackedTaskCount() const { return task_pool_.GetLiveCount(); }   // submitted, not yet retired
+    size_t GetConcurrencyLimit() const { return admission_.GetLimit(); }
+    
+    // Median execution time over the model's recent tasks
+    std::optional<atom::core::Duration> GetObservedLatency(const atom::core::ModelPtr& model) const;
     
     // Statistics
     struct Statistics {
@@ -78,6 +193,9 @@ public:
         std::atomic<uint64_t> failed_tasks{0};
         std::atomic<uint64_t> cancelled_tasks{0};
         std::atomic<uint64_t> total_execution_time_ns{0};
+        std::atomic<uint64_t> shed_tasks{0};          // failed with Timeout before running
+        std::atomic<uint64_t> deadline_misses{0};     // completed after their deadline
+        std::atomic<uint64_t> rejected_tasks{0};      // refused with QueueFull, not in total_tasks
         
         double GetAverageExecutionTimeMs() const {
             auto count = completed_tasks.load();
@@ -92,36 +210,72 @@ public:
 private:
     SchedulerConfig config_;
     std::unique_ptr<ThreadPool> thread_pool_;
-    DependencyGraph dependency_graph_;
+    TaskPool task_pool_;
+    AdmissionController admission_;
     
     std::atomic<bool> running_{false};
-    std::atomic<TaskId> next_task_id_{1};
+    std::atomic<atom::core::u64> next_sequence_{1};
+    std::atomic<size_t> running_count_{0};      // decremented under queue_mutex_, for idle_cv_
+    std::condition_variable idle_cv_;
+    
+    // Shared so a worker's lookup keeps a batcher alive across DisableBatching
+    mutable std::shared_mutex batchers_mutex_;
+    std::map<const atom::core::IModel*, std::shared_ptr<DynamicBatcher>> batchers_;
     
-    mutable std::shared_mutex mutex_;
-    std::map<TaskId, TaskPtr> all_tasks_;
-    std::map<TaskId, std::promise<TaskResult>> task_promises_;
+    mutable std::shared_mutex model_nodes_mutex_;
+    std::map<const atom::core::IModel*, int> model_nodes_;
     
-    // Priority queue for ready tasks
-    using PriorityQueue = std::priority_queue<TaskPtr, std::vector<TaskPtr>, 
-        std::function<bool(const TaskPtr&, const TaskPtr&)>>;
-    PriorityQueue ready_queue_;
-    std::mutex queue_mutex_;
+    FairQueue ready_queue_;
+    mutable std::mutex queue_mutex_;
     std::condition_variable queue_cv_;
+    size_t dispatched_count_{0};
     
     Statistics stats_;
     
+    // Recent execution times per model, for shedding
+    struct LatencyWindow {
+        std::array<atom::core::i64, 64> samples{};
+        size_t count{0};
+        size_t next{0};
+    };
+    mutable std::mutex latency_mutex_;
+    std::map<const atom::core::IModel*, LatencyWindow> latencies_;
+    
     // Worker thread
     std::thread scheduler_thread_;
     void SchedulerLoop();
     
+    atom::core::Result<TaskId> EnqueueTask(
+        atom::core::ModelPtr model,
+        std::vector<atom::core::Tensor> inputs,
+        std::vector<TaskId> dependencies,
+        atom::core::Priority priority,
+        Task::Callback callback,
+        TaskAwaiter awaiter,
+        const SubmitOptions& options);
+    
     // Task execution
     void ExecuteTask(TaskPtr task);
     void OnTaskCompleted(TaskPtr task, const TaskResult& result);
     void OnTaskFailed(TaskPtr task, const atom::core::Error& error);
+    void FinishTask(TaskPtr task, TaskResult result);
+    void FinishGraphNode(GraphRun& run, const TaskPtr& task, TaskResult result);
+    void FinishGraphRun(GraphRun& run);
+    void ResumeAwaiter(std::coroutine_handle<> handle, int node);
+    TaskPtr FindTask(TaskId task_id) const;
+    std::optional<atom::core::Error> CheckDeadline(const Task& task) const;
+    void ShedTask(TaskPtr task, atom::core::Error error);
+    void ReleaseAdmission(const Task& task, const TaskResult& result);
+    void RecordLatency(const atom::core::IModel* model, atom::core::Duration latency);
+    std::optional<atom::core::Duration> ObservedLatency(const atom::core::IModel* model, size_t min_samples) const;
     
     // Helper methods
-    TaskId GenerateTaskId() { return next_task_id_++; }
-    void EnqueueReadyTasks();
+    atom::core::u64 NextSequence() { return next_sequence_++; }
+    void PushReady(TaskPtr task);
+    bool TakeContinuation(const TaskPtr& task);
+    std::shared_ptr<DynamicBatcher> FindBatcher(const atom::core::IModel* model) const;
+    int ResolveNumaNode(const atom::core::IModel* model, const std::vector<atom::core::Tensor>& inputs,
+                        const SubmitOptions& options) const;
 };
 
 } // namespace atom::scheduler
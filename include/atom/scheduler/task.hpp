@@ -3,15 +3,20 @@
 #include "../core/types.hpp"
 #include "../core/tensor.hpp"
 #include "../core/model_interface.hpp"
+#include "inline_function.hpp"
+#include <atomic>
+#include <coroutine>
 #include <functional>
 #include <future>
 #include <vector>
-#include <set>
+#include <string>
 
 namespace atom::scheduler {
 
 using TaskId = atom::core::u64;
 
+class GraphRun;
+
 // Task status
 enum class TaskStatus {
     Pending,
@@ -30,10 +35,19 @@ struct TaskResult {
     std::optional<atom::core::Error> error;
 };
 
+// Coroutine suspended on a task (Scheduler::Submit): it is handed the
+// result in place of the task record and resumed on a worker
+struct TaskAwaiter {
+    std::coroutine_handle<> handle;
+    std::optional<TaskResult>* result{nullptr};
+    
+    explicit operator bool() const { return static_cast<bool>(handle); }
+};
+
 // Task definition
 class Task {
 public:
-    using Callback = std::function<void(const TaskResult&)>;
+    using Callback = InlineFunction<48, void(const TaskResult&)>;
     
     Task(TaskId id, 
          atom::core::ModelPtr model,
@@ -44,25 +58,63 @@ public:
     
     // Accessors
     TaskId GetId() const { return id_; }
+    atom::core::u64 GetSequence() const { return sequence_; }    // submission order, = id unless set
+    void SetSequence(atom::core::u64 sequence) { sequence_ = sequence; }
     atom::core::Priority GetPriority() const { return priority_; }
     TaskStatus GetStatus() const { return status_; }
     const std::vector<atom::core::Tensor>& GetInputs() const { return inputs_; }
+    std::vector<atom::core::Tensor> TakeInputs() { return std::move(inputs_); }
+    void SetInputs(std::vector<atom::core::Tensor> inputs) { inputs_ = std::move(inputs); }
     atom::core::ModelPtr GetModel() const { return model_; }
     
     // Dependencies
     void AddDependency(TaskId dep_id);
     void RemoveDependency(TaskId dep_id);
-    const std::set<TaskId>& GetDependencies() const { return dependencies_; }
-    bool HasDependencies() const { return !dependencies_; }
+    const std::vector<TaskId>& GetDependencies() const { return dependencies_; }
+    bool HasDependencies() const { return !dependencies_.empty(); }
     
     // Callbacks
     void SetCallback(Callback callback) { callback_ = std::move(callback); }
     void InvokeCallback(const TaskResult& result);
+    void SetAwaiter(TaskAwaiter awaiter) { awaiter_ = awaiter; }
+    TaskAwaiter TakeAwaiter() { return std::exchange(awaiter_, TaskAwaiter{}); }
     
     // Execution
     void SetStatus(TaskStatus status) { status_ = status; }
+    // Atomically moves expected -> desired; false if another thread moved it first
+    bool TryUpdateStatus(TaskStatus expected, TaskStatus desired) {
+        return status_.compare_exchange_strong(expected, desired);
+    }
     void SetStartTime(atom::core::TimePoint time) { start_time_ = time; }
     void SetEndTime(atom::core::TimePoint time) { end_time_ = time; }
+    void SetReadyTime(atom::core::TimePoint time) { ready_time_ = time; }
+    bool HasStarted() const { return start_time_.has_value(); }
+    
+    // Reuses a pooled task for another submission: new id and inputs, back
+    // to Pending, timings, deadline and result cleared. The second form also
+    // replaces the model and priority and drops callback, awaiter,
+    // dependencies and NUMA node.
+    void Reset(TaskId id, std::vector<atom::core::Tensor> inputs);
+    void Reset(TaskId id, atom::core::ModelPtr model, std::vector<atom::core::Tensor> inputs,
+               atom::core::Priority priority);
+    
+    // Node of a task graph run; the scheduler completes such tasks into the
+    // run instead of a promise
+    void SetGraphNode(GraphRun* run, atom::core::u32 node) { graph_run_ = run; graph_node_ = node; }
+    GraphRun* GetGraphRun() const { return graph_run_; }
+    atom::core::u32 GetGraphNode() const { return graph_node_; }
+    
+    // Fair-share identity in the scheduler; empty = the model's name
+    void SetTenant(std::string tenant) { tenant_ = std::move(tenant); }
+    const std::string& GetTenant() const { return tenant_; }
+    
+    // NUMA node whose workers should run the task, -1 = any
+    void SetNumaNode(int node) { numa_node_ = node; }
+    int GetNumaNode() const { return numa_node_; }
+    
+    // Absolute time by which the task must have finished; none = no deadline
+    void SetDeadline(std::optional<atom::core::TimePoint> deadline) { deadline_ = deadline; }
+    const std::optional<atom::core::TimePoint>& GetDeadline() const { return deadline_; }
     
     atom::core::Duration GetExecutionTime() const {
         if (start_time_ && end_time_) {
@@ -71,6 +123,11 @@ public:
         return atom::core::Duration::zero();
     }
     
+    // Time from entering the ready queue to starting
+    atom::core::Duration GetQueueDelay() const {
+        return start_time_ ? *start_time_ - ready_time_ : atom::core::Duration::zero();
+    }
+    
     // Result management
     void SetResult(TaskResult result) { result_ = std::move(result); }
     const std::optional<TaskResult>& GetResult() const { return result_; }
@@ -80,19 +137,39 @@ public:
         return priority_ < other.priority_;
     }
     
+    // Earliest deadline first within a priority class, then submission order
+    static bool DeadlineLess(const Task& a, const Task& b) {
+        if (a.priority_ != b.priority_) return a.priority_ < b.priority_;
+        if (a.deadline_ != b.deadline_) {
+            if (!a.deadline_) return true;
+            if (!b.deadline_) return false;
+            return *a.deadline_ > *b.deadline_;
+        }
+        return a.sequence_ > b.sequence_;
+    }
+    
 private:
     TaskId id_;
+    atom::core::u64 sequence_;
     atom::core::ModelPtr model_;
     std::vector<atom::core::Tensor> inputs_;
     atom::core::Priority priority_;
-    TaskStatus status_{TaskStatus::Pending};
+    std::atomic<TaskStatus> status_{TaskStatus::Pending};
     
-    std::set<TaskId> dependencies_;
+    std::vector<TaskId> dependencies_;
     Callback callback_;
+    TaskAwaiter awaiter_;
     
     std::optional<atom::core::TimePoint> start_time_;
     std::optional<atom::core::TimePoint> end_time_;
+    atom::core::TimePoint ready_time_{};
+    std::optional<atom::core::TimePoint> deadline_;
+    std::string tenant_;
+    int numa_node_{-1};
     std::optional<TaskResult> result_;
+    
+    GraphRun* graph_run_{nullptr};
+    atom::core::u32 graph_node_{0};
 };
 
 using TaskPtr = std::shared_ptr<Task>;
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "task.hpp"
+#include "../core/types.hpp"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace atom::scheduler {
+
+class Scheduler;
+class TaskGraphTemplate;
+
+// Outcome of one run of a task graph
+struct GraphResult {
+    TaskStatus status;                                     // Completed, or that of the first node to fail
+    std::vector<std::vector<atom::core::Tensor>> outputs;  // per sink, in GetSinks() order
+    atom::core::Duration execution_time;                   // submission to last node
+    std::optional<atom::core::Error> error;
+};
+
+// One in-flight instance of a template: a reusable Task per node, the
+// per-node dependency counters and the outputs handed from node to node.
+// Runs are pooled by their template, so a submission after warm-up only
+// resets them.
+class GraphRun {
+public:
+    using Callback = std::function<void(GraphResult)>;
+
+    explicit GraphRun(const TaskGraphTemplate& graph);
+
+    GraphRun(const GraphRun&) = delete;
+    GraphRun& operator=(const GraphRun&) = delete;
+
+private:
+    friend class Scheduler;
+    friend class TaskGraphTemplate;
+
+    std::shared_ptr<const TaskGraphTemplate> graph_;        // held only while running
+    std::vector<TaskPtr> tasks_;
+    std::unique_ptr<std::atomic<atom::core::u32>[]> pending_;   // unfinished predecessors
+    std::unique_ptr<std::atomic<atom::core::u32>[]> readers_;   // consumers yet to take the outputs
+    std::vector<std::vector<atom::core::Tensor>> outputs_;
+
+    std::atomic<atom::core::u32> in_flight_{0};             // queued or running nodes
+    std::atomic<atom::core::u32> finished_{0};
+    std::atomic<bool> failed_{false};
+    TaskStatus status_{TaskStatus::Completed};
+    std::optional<atom::core::Error> error_;                // written by the first failure only
+    Callback callback_;
+    atom::core::TimePoint submitted_{};
+};
+
+// A multi-model workflow (e.g. preprocess -> detect -> crop -> classify)
+// defined and validated once, then run per frame with Scheduler::SubmitGraph.
+// Root nodes receive the run's inputs; every other node receives the
+// outputs of its predecessors, concatenated in the order the edges were
+// added. A node is either a model or a Transform, a CPU step run on a
+// scheduler worker like any model.
+//
+// Compile() checks the topology once and freezes the template. Runs then
+// skip the per-task bookkeeping of SubmitTaskWithDependencies (task map,
+// promise, dependency graph) and draw their tasks and counters from a pool,
+// like a CUDA graph instantiated once and relaunched.
+class TaskGraphTemplate {
+public:
+    using NodeId = atom::core::u32;
+    using Transform = std::function<atom::core::Result<std::vector<atom::core::Tensor>>(
+        const std::vector<atom::core::Tensor>&)>;
+
+    explicit TaskGraphTemplate(std::string name);
+    ~TaskGraphTemplate();
+
+    TaskGraphTemplate(const TaskGraphTemplate&) = delete;
+    TaskGraphTemplate& operator=(const TaskGraphTemplate&) = delete;
+
+    // Construction, before Compile; both fail on a compiled template, whose
+    // pooled runs are sized for its nodes
+    atom::core::Result<NodeId> AddNode(std::string name, atom::core::ModelPtr model,
+                                       atom::core::Priority priority = atom::core::Priority::Normal);
+    atom::core::Result<NodeId> AddNode(std::string name, Transform transform,
+                                       atom::core::Priority priority = atom::core::Priority::Normal);
+
+    // to consumes the outputs of from
+    atom::core::Result<void> AddEdge(NodeId from, NodeId to);
+
+    // Validates the graph (non-empty, every node runnable, acyclic) and freezes it
+    atom::core::Result<void> Compile();
+    bool IsCompiled() const { return compiled_; }
+
+    // Query
+    const std::string& GetName() const { return name_; }
+    size_t GetNodeCount() const { return nodes_.size(); }
+    const std::string& GetNodeName(NodeId node) const { return nodes_[node].name; }
+    const std::vector<NodeId>& GetRoots() const { return roots_; }
+    const std::vector<NodeId>& GetSinks() const { return sinks_; }
+    const std::vector<NodeId>& GetTopologicalOrder() const { return order_; }
+    size_t GetPooledRunCount() const;
+
+private:
+    friend class Scheduler;
+    friend class GraphRun;
+
+    struct Node {
+        std::string name;
+        atom::core::ModelPtr model;                 // a Transform is wrapped as a model
+        atom::core::Priority priority;
+        std::vector<NodeId> predecessors;           // in edge order
+        std::vector<NodeId> successors;
+    };
+
+    std::string name_;
+    std::vector<Node> nodes_;
+    std::vector<NodeId> roots_;
+    std::vector<NodeId> sinks_;
+    std::vector<NodeId> order_;
+    bool compiled_{false};
+
+    mutable std::mutex pool_mutex_;
+    mutable std::vector<std::unique_ptr<GraphRun>> free_runs_;
+
+    std::unique_ptr<GraphRun> AcquireRun() const;
+    void ReleaseRun(std::unique_ptr<GraphRun> run) const;
+};
+
+using TaskGraphPtr = std::shared_ptr<TaskGraphTemplate>;
+
+} // namespace atom::scheduler
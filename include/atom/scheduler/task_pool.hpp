@@ -0,0 +1,106 @@
+#pragma once
+
+#include "task.hpp"
+#include "../core/types.hpp"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace atom::scheduler {
+
+// Slab of task records for the Scheduler. A TaskId is the record's slot in
+// the low 32 bits and its generation in the high 32 bits; retiring a record
+// bumps the generation, so stale ids stop resolving and the slot, its Task
+// object and its buffers are reused by the next submission. Slots are
+// allocated in fixed chunks that never move, so lookups take no pool lock.
+//
+// A finished record is retired once its result has been consumed, or when
+// it has waited out the retention window unconsumed, and only when nothing
+// else (a ready queue entry, a worker) still holds its Task.
+class TaskPool {
+public:
+    struct Record {
+        std::mutex mutex;
+        std::condition_variable cv;
+        atom::core::u32 generation{1};              // guarded by mutex
+        TaskPtr task;                               // reused across generations
+        bool finished{false};                       // status is final
+        bool consumed{false};
+        atom::core::u32 waiters{0};
+        std::optional<TaskResult> result;           // set once finished and published
+        atom::core::TimePoint finished_at{};
+        std::vector<TaskId> dependents;             // tasks waiting for this one
+        std::atomic<atom::core::u32> pending{0};    // unfinished dependencies
+    };
+
+    static constexpr size_t kChunkSize = 1024;
+    static constexpr size_t kMaxChunks = 4096;      // 4M live tasks
+
+    explicit TaskPool(atom::core::Duration retention);
+    ~TaskPool();
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    static TaskId MakeId(atom::core::u32 slot, atom::core::u32 generation) {
+        return (static_cast<TaskId>(generation) << 32) | slot;
+    }
+    static atom::core::u32 SlotOf(TaskId id) { return static_cast<atom::core::u32>(id); }
+    static atom::core::u32 GenerationOf(TaskId id) { return static_cast<atom::core::u32>(id >> 32); }
+
+    // A free record and its id, recycling retired records first; nullptr
+    // when the pool is exhausted
+    Record* Acquire(TaskId& id);
+
+    // Record for the id's slot, or nullptr. The generation must still be
+    // checked against the id under the record's mutex.
+    Record* Find(TaskId id) const;
+
+    // Queue a finished record for retirement once the retention window ends
+    void Retire(TaskId id);
+
+    // The record's result was taken; retire it as soon as it is unused
+    void Consume(TaskId id);
+
+    // Returns a record that never got published (a failed submission)
+    void Discard(TaskId id);
+
+    // Live records, and the slots allocated so far
+    size_t GetLiveCount() const { return live_count_.load(std::memory_order_relaxed); }
+    size_t GetCapacity() const;
+
+    template<typename F>
+    void ForEach(F&& f) const {
+        const size_t count = GetCapacity();
+        for (size_t slot = 0; slot < count; ++slot) {
+            f(*Find(static_cast<TaskId>(slot)));
+        }
+    }
+
+private:
+    struct RetireEntry {
+        atom::core::u32 slot;
+        atom::core::u32 generation;
+    };
+
+    atom::core::Duration retention_;
+    std::array<std::atomic<Record*>, kMaxChunks> chunks_{};
+
+    mutable std::mutex mutex_;
+    size_t chunk_count_{0};
+    std::vector<atom::core::u32> free_;
+    std::vector<RetireEntry> retiring_;             // ring in finish order
+    size_t retiring_head_{0};
+    size_t retiring_size_{0};
+    std::atomic<size_t> live_count_{0};
+
+    void Reclaim(atom::core::TimePoint now);
+    bool Recycle(Record& record, atom::core::u32 slot);
+    void PushRetiring(RetireEntry entry);
+};
+
+} // namespace atom::scheduler
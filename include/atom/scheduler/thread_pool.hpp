@@ -1,74 +1,162 @@
 #pragma once
 
 #include "../core/types.hpp"
+#include "../core/numa.hpp"
+#include "inline_function.hpp"
+#include "work_stealing_deque.hpp"
 #include <vector>
 #include <thread>
-#include <queue>
 #include <functional>
 #include <mutex>
-#include <condition_variable>
 #include <future>
 #include <atomic>
+#include <coroutine>
+#include <memory>
 
 namespace atom::scheduler {
 
+// Work-stealing pool. Each worker owns a Chase-Lev deque: tasks posted from
+// a worker go to its own deque (newest first, so nested work stays cache
+// hot), tasks from other threads go to a shared injection queue, and idle
+// workers steal the oldest task of a random victim. Idle workers spin a
+// little, adapting how long to how often spinning paid off, then park on a
+// futex. Tasks are move-only with small-buffer storage, so posting a small
+// lambda allocates nothing but its (recycled) queue node.
+//
+// With an affinity policy, workers are pinned and grouped by NUMA node.
+// Tasks posted for a node go to its group's queue; a worker takes work from
+// its own deque, its group's queue, the shared queue and its group's other
+// workers, and only reaches into another node when it is about to park.
+// Sleepers of the task's node are woken first. Remote work is still taken
+// rather than left waiting behind a busy node.
 class ThreadPool {
 public:
-    using Task = std::function<void()>;
-    
-    explicit ThreadPool(size_t num_threads = std::thread::hardware_concurrency());
+    using Task = InlineFunction<48>;
+
+    explicit ThreadPool(size_t num_threads = std::thread::hardware_concurrency(),
+                        atom::core::AffinityPolicy affinity = atom::core::AffinityPolicy::None);
     ~ThreadPool();
-    
+
     // Delete copy/move
     ThreadPool(const ThreadPool&) = delete;
     ThreadPool& operator=(const ThreadPool&) = delete;
     ThreadPool(ThreadPool&&) = delete;
     ThreadPool& operator=(ThreadPool&&) = delete;
-    
+
+    // Fire-and-forget submission without a future. An exception escaping
+    // the task is dropped; use Submit to receive it. node >= 0 prefers the
+    // workers pinned to that NUMA node, when there are any.
+    void Post(Task task, int node = -1);
+
     // Task submission
     template<typename F, typename... Args>
     auto Submit(F&& f, Args&&... args) -> std::future<decltype(f(args...))> {
         using ReturnType = decltype(f(args...));
-        
-        auto task = std::make_shared<std::packaged_task<ReturnType()>>(
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-        );
-        
-        auto future = task->get_future();
-        
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            if (stopped_) {
-                throw std::runtime_error("ThreadPool is stopped");
+
+        std::packaged_task<ReturnType()> task(
+            [f = std::forward<F>(f), ... args = std::forward<Args>(args)]() mutable -> ReturnType {
+                return std::invoke(f, args...);
             }
-            tasks_.emplace([task]() { (*task)(); });
-        }
-        
-        condition_.notify_one();
+        );
+
+        auto future = task.get_future();
+        Post(std::move(task));
         return future;
     }
-    
+
+    // Executor for coroutines: co_await pool.Schedule() continues the
+    // calling coroutine on a worker (of the NUMA node, when pinned). On a
+    // stopped pool the co_await throws.
+    class ScheduleAwaiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) {
+            pool_->Post([handle]() { handle.resume(); }, node_);
+        }
+        void await_resume() const noexcept {}
+
+    private:
+        friend class ThreadPool;
+        ScheduleAwaiter(ThreadPool& pool, int node) : pool_(&pool), node_(node) {}
+
+        ThreadPool* pool_;
+        int node_;
+    };
+
+    ScheduleAwaiter Schedule(int node = -1) { return ScheduleAwaiter(*this, node); }
+
     // Control
     void Stop();
     void WaitAll();
-    
+
     // Query
     size_t GetThreadCount() const { return workers_.size(); }
     size_t GetQueuedTaskCount() const;
     size_t GetActiveTaskCount() const { return active_count_.load(); }
-    
+    size_t GetNodeGroupCount() const { return groups_.size(); }     // 1 unless pinned per node
+    int GetWorkerNode(size_t worker) const { return workers_[worker]->placement.node; }
+
 private:
-    std::vector<std::thread> workers_;
-    std::queue<Task> tasks_;
-    
-    mutable std::mutex queue_mutex_;
-    std::condition_variable condition_;
-    std::condition_variable wait_condition_;
-    
+    struct TaskNode {
+        Task task;
+        TaskNode* next{nullptr};
+    };
+
+    struct Worker {
+        WorkStealingDeque<TaskNode*> deque;
+        std::thread thread;
+        atom::core::u64 rng;
+        atom::core::u32 spin_limit;
+        atom::core::WorkerPlacement placement;
+        size_t group;
+    };
+
+    // Tasks handed in from outside a worker's deque, a FIFO linked through
+    // the nodes
+    struct Injector {
+        std::mutex mutex;
+        TaskNode* head{nullptr};
+        TaskNode* tail{nullptr};
+        std::atomic<size_t> count{0};
+    };
+
+    // Workers of one NUMA node (all workers when unpinned), contiguous in
+    // workers_. Parking: sleepers wait for wake_epoch to move. At most one
+    // wake-up per group is in flight; the woken worker wakes the next if it
+    // finds more work.
+    struct Group {
+        int node{-1};
+        size_t begin{0};
+        size_t end{0};
+        Injector injector;                              // tasks posted for this node
+        alignas(64) std::atomic<atom::core::u32> wake_epoch{0};
+        alignas(64) std::atomic<atom::core::u32> sleepers{0};
+        std::atomic<bool> waking{false};
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::unique_ptr<Group>> groups_;
+    Injector injector_;                                 // tasks for any node
+
     std::atomic<bool> stopped_{false};
+    alignas(64) std::atomic<size_t> pending_{0};      // posted, not finished
     std::atomic<size_t> active_count_{0};
-    
-    void WorkerThread();
+
+    void WorkerThread(size_t index);
+    TaskNode* FindTask(Worker& self, bool remote);
+    TaskNode* TakeInjected(Injector& injector, size_t group);
+    TaskNode* Steal(Worker& self, size_t begin, size_t end);
+    void Execute(TaskNode* node);
+    void Notify(size_t group);
+    size_t GroupOfNode(int node) const;
+
+    // Per-thread free list of task nodes, balanced through a shared one
+    struct NodeCache;
+    struct SpareNodes;
+    static NodeCache& LocalNodeCache();
+    static SpareNodes& Spares();
+    static TaskNode* AcquireNode(Task&& task);
+    static void ReleaseNode(TaskNode* node);
 };
 
 } // namespace atom::scheduler
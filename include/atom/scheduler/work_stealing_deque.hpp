@@ -0,0 +1,117 @@
+#pragma once
+
+#include "../core/types.hpp"
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace atom::scheduler {
+
+// Chase-Lev work-stealing deque (Le, Pop, Cohen, Zappa Nardelli, "Correct
+// and Efficient Work-Stealing for Weak Memory Models", PPoPP 2013). The
+// owning thread pushes and pops at the bottom without contention; other
+// threads steal from the top with one CAS. T must be a pointer-like
+// trivially copyable type; Pop and Steal return T{} when they get nothing.
+// Grown buffers are kept until the deque is destroyed, since a thief may
+// still be reading the old one.
+template<typename T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+    explicit WorkStealingDeque(atom::core::i64 capacity = 256) {
+        atom::core::i64 size = 1;
+        while (size < capacity) size <<= 1;
+        auto buffer = std::make_unique<Buffer>(size);
+        buffer_.store(buffer.get(), std::memory_order_relaxed);
+        buffers_.push_back(std::move(buffer));
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Owner only
+    void Push(T item) {
+        const atom::core::i64 b = bottom_.load(std::memory_order_relaxed);
+        const atom::core::i64 t = top_.load(std::memory_order_acquire);
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        if (b - t > buffer->mask) buffer = Grow(buffer, t, b);
+        buffer->Put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // Owner only; newest first
+    T Pop() {
+        const atom::core::i64 b = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        atom::core::i64 t = top_.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return T{};
+        }
+        T item = buffer->Get(b);
+        if (t == b) {
+            // Last item: race the thieves for it
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                item = T{};
+            }
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // Any thread; oldest first
+    T Steal() {
+        atom::core::i64 t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const atom::core::i64 b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) return T{};
+
+        T item = buffer_.load(std::memory_order_acquire)->Get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return T{};
+        }
+        return item;
+    }
+
+    // Approximate when called concurrently
+    atom::core::i64 Size() const {
+        const atom::core::i64 b = bottom_.load(std::memory_order_relaxed);
+        const atom::core::i64 t = top_.load(std::memory_order_relaxed);
+        return b > t ? b - t : 0;
+    }
+
+    bool Empty() const { return Size() == 0; }
+
+private:
+    struct Buffer {
+        explicit Buffer(atom::core::i64 size) : mask(size - 1), slots(new std::atomic<T>[size]) {}
+
+        T Get(atom::core::i64 index) const { return slots[index & mask].load(std::memory_order_relaxed); }
+        void Put(atom::core::i64 index, T item) { slots[index & mask].store(item, std::memory_order_relaxed); }
+
+        atom::core::i64 mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+    };
+
+    Buffer* Grow(Buffer* buffer, atom::core::i64 top, atom::core::i64 bottom) {
+        auto grown = std::make_unique<Buffer>((buffer->mask + 1) * 2);
+        for (atom::core::i64 i = top; i < bottom; ++i) grown->Put(i, buffer->Get(i));
+        Buffer* raw = grown.get();
+        buffers_.push_back(std::move(grown));
+        buffer_.store(raw, std::memory_order_release);
+        return raw;
+    }
+
+    alignas(64) std::atomic<atom::core::i64> top_{0};
+    alignas(64) std::atomic<atom::core::i64> bottom_{0};
+    std::atomic<Buffer*> buffer_{nullptr};
+    std::vector<std::unique_ptr<Buffer>> buffers_;   // owner only
+};
+
+} // namespace atom::scheduler
@@ -0,0 +1,47 @@
+#include "detect_classify.hpp"
+
+namespace atom::models {
+
+atom::core::Result<void> DetectClassifyCascade::Classify(const cv::Mat& frame,
+                                                         std::span<const Detection> detections,
+                                                         CascadeResult& result) {
+    result.detections.clear();
+    rois_.clear();
+    for (const auto& detection : detections) {
+        if (detection.score < config_.min_detection_score) continue;
+        const atom::core::f32 dx = (detection.x2 - detection.x1) * config_.box_margin;
+        const atom::core::f32 dy = (detection.y2 - detection.y1) * config_.box_margin;
+        rois_.push_back({detection.x1 - dx, detection.y1 - dy, detection.x2 + dx, detection.y2 + dy});
+        result.detections.push_back(detection);
+    }
+
+    if (rois_.empty()) {
+        result.labels.indices.clear();
+        result.labels.scores.clear();
+        result.labels.k = classifier_.GetTopKConfig().k;
+        return {};
+    }
+
+    crops_.resize(1);
+    auto cropped = atom::data::CropResizeBatch(frame, rois_, config_.crop, crops_[0]);
+    if (!cropped) return cropped;
+    return classifier_.Classify(crops_, result.labels);
+}
+
+atom::core::Result<CascadeResult> DetectClassifyCascade::Run(YOLOv8& detector, const cv::Mat& frame,
+                                                             const std::vector<atom::core::Tensor>& detector_inputs,
+                                                             const LetterboxInfo& letterbox) {
+    auto detections = detector.Detect(detector_inputs, std::span<const LetterboxInfo>(&letterbox, 1));
+    if (!detections) return std::unexpected(detections.error());
+    if (detections->ImageCount() != 1) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Cascade runs one frame at a time"));
+    }
+
+    CascadeResult result;
+    auto classified = Classify(frame, (*detections)[0], result);
+    if (!classified) return std::unexpected(classified.error());
+    return result;
+}
+
+} // namespace atom::models
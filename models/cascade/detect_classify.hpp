@@ -0,0 +1,50 @@
+#pragma once
+
+#include "../detection/yolo/yolov8.hpp"
+#include "../classification/resnet/resnet50.hpp"
+#include <atom/data/roi_align.hpp>
+
+namespace atom::models {
+
+struct CascadeConfig {
+    // Crop size and normalization of the classifier input
+    atom::data::PreprocessConfig crop{cv::Size(224, 224)};
+    atom::core::f32 min_detection_score{0.0f};   // lower-scored boxes are not classified
+    atom::core::f32 box_margin{0.0f};            // added on each side, as a fraction of the box size
+};
+
+// Classified boxes of one frame: labels row i belongs to detections[i]
+struct CascadeResult {
+    std::vector<Detection> detections;
+    ClassificationBatch labels;
+};
+
+// Detection followed by classification of every detected box. All crops of
+// a frame are cut, resized and normalized in one pass into a single
+// [K, 3, H, W] batch, so the classifier runs once per frame instead of once
+// per box. Buffers are kept between calls; use one cascade per thread.
+class DetectClassifyCascade {
+public:
+    explicit DetectClassifyCascade(ResNet50& classifier, CascadeConfig config = {})
+        : classifier_(classifier), config_(std::move(config)) {}
+
+    // Second stage only, for detections in `frame` pixels
+    atom::core::Result<void> Classify(const cv::Mat& frame, std::span<const Detection> detections,
+                                      CascadeResult& result);
+
+    // Both stages on one frame; `detector_inputs` is the preprocessed frame
+    // and `letterbox` maps the detector's boxes back to `frame`
+    atom::core::Result<CascadeResult> Run(YOLOv8& detector, const cv::Mat& frame,
+                                          const std::vector<atom::core::Tensor>& detector_inputs,
+                                          const LetterboxInfo& letterbox);
+
+    const CascadeConfig& GetConfig() const { return config_; }
+
+private:
+    ResNet50& classifier_;
+    CascadeConfig config_;
+    std::vector<atom::data::RoiBox> rois_;
+    std::vector<atom::core::Tensor> crops_;      // the classifier's single input
+};
+
+} // namespace atom::models
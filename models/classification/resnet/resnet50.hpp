@@ -2,6 +2,9 @@
 
 #include <atom/core/model_interface.hpp>
 #include <atom/inference/tensorrt_backend.hpp>
+#include <atom/inference/autotuner.hpp>
+#include <atom/inference/shape_buckets.hpp>
+#include "topk_postprocess.hpp"
 
 namespace atom::models {
 
@@ -20,13 +23,37 @@ public:
     
     atom::core::Result<void> Initialize(const std::string& model_path, 
                                        const atom::core::InferenceOptions& options) override {
-        backend_ = std::make_unique<atom::inference::TensorRTBackend>();
+        if (options.autotune.enabled) {
+            // Fastest registered backend and kernel variant, loaded and selected
+            atom::inference::BackendAutotuner tuner(options.autotune);
+            auto decision = tuner.Tune(model_path, options.device,
+                                       metadata_.input_shapes, metadata_.input_types);
+            if (!decision) return std::unexpected(decision.error());
+            backend_ = std::move(decision->backend);
+        } else {
+            backend_ = std::make_unique<atom::inference::TensorRTBackend>();
+            
+            auto init_result = backend_->Initialize(options.device);
+            if (!init_result) return std::unexpected(init_result.error());
+            
+            auto load_result = backend_->LoadModel(model_path);
+            if (!load_result) return std::unexpected(load_result.error());
+        }
+        
+        if (options.execution_contexts > 1) {
+            auto ctx_result = backend_->SetExecutionContextCount(options.execution_contexts);
+            if (!ctx_result) return std::unexpected(ctx_result.error());
+        }
         
-        auto init_result = backend_->Initialize(options.device);
-        if (!init_result) return std::unexpected(init_result.error());
+        if (options.threading != atom::core::ThreadingOptions{}) {
+            auto threading_result = backend_->SetThreading(options.threading);
+            if (!threading_result) return std::unexpected(threading_result.error());
+        }
         
-        auto load_result = backend_->LoadModel(model_path);
-        if (!load_result) return std::unexpected(load_result.error());
+        if (options.shape_buckets.IsEnabled()) {
+            shape_buckets_ = options.shape_buckets;
+            bucketer_ = std::make_unique<atom::inference::ShapeBucketer>(*backend_, options.shape_buckets);
+        }
         
         initialized_ = true;
         device_ = options.device;
@@ -51,7 +78,9 @@ public:
     }
     
     void Shutdown() override {
+        bucketer_.reset();
         if (backend_) {
+            backend_->DrainAsync();
             backend_->Shutdown();
         }
         initialized_ = false;
@@ -65,24 +94,71 @@ public:
                 "Invalid inputs"));
         }
         
+        if (bucketer_) {
+            auto result = bucketer_->Execute(inputs);
+            if (!result) return std::unexpected(result.error());
+            return std::move(result->outputs);
+        }
         return backend_->Execute(inputs);
     }
     
-    atom::core::Result<std::vector<atom::core::Tensor>> InferAsync(
-        const std::vector<atom::core::Tensor>& inputs) override {
-        return Infer(inputs);
+    using ModelBase::InferAsync;
+    
+    atom::core::Result<void> InferAsync(std::vector<atom::core::Tensor> inputs,
+                                        InferCallback callback) override {
+        if (!initialized_) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+                "Model not initialized"));
+        }
+        if (!ValidateInputs(inputs)) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+                "Invalid inputs"));
+        }
+        
+        if (bucketer_) {
+            return bucketer_->ExecuteAsync(std::move(inputs),
+                [callback = std::move(callback)](atom::core::Result<atom::inference::BucketedOutputs> result) {
+                    if (!result) {
+                        callback(std::unexpected(result.error()));
+                        return;
+                    }
+                    callback(std::move(result->outputs));
+                });
+        }
+        return backend_->ExecuteAsync(std::move(inputs), std::move(callback));
     }
     
+    // Inference followed by top-k; `result` is reused across calls
+    atom::core::Result<void> Classify(const std::vector<atom::core::Tensor>& inputs, ClassificationBatch& result) {
+        auto outputs = Infer(inputs);
+        if (!outputs) return std::unexpected(outputs.error());
+        return postprocessor_.Process(outputs->front(), result);
+    }
+    
+    // A stage running this model's top-k off the inference thread; feed it Infer outputs
+    std::unique_ptr<ClassificationStage> MakePostprocessStage(size_t num_workers = 1) const {
+        return MakeTopKStage(postprocessor_, num_workers);
+    }
+    
+    void SetTopKConfig(const TopKConfig& config) { postprocessor_.SetConfig(config); }
+    const TopKConfig& GetTopKConfig() const { return postprocessor_.GetConfig(); }
+    
+    // The backend Initialize chose (TensorRT, or CPU if the autotuner picked it)
     atom::core::BackendType GetBackendType() const override {
-        return atom::core::BackendType::TensorRT;
+        return backend_ ? backend_->GetType() : atom::core::BackendType::TensorRT;
     }
     
     size_t GetMemoryUsage() const override {
         return 98 * 1024 * 1024; // ~98 MB for ResNet50
     }
     
+    // Bucket hit rates and padding waste; null unless shape buckets are configured
+    const atom::inference::ShapeBucketer* GetShapeBuckets() const { return bucketer_.get(); }
+    
 private:
-    std::unique_ptr<atom::inference::TensorRTBackend> backend_;
+    atom::inference::UniqueBackendPtr backend_;
+    std::unique_ptr<atom::inference::ShapeBucketer> bucketer_;
+    TopKPostprocessor postprocessor_;
 };
 
 } // namespace atom::models
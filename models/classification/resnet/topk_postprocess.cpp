@@ -0,0 +1,198 @@
+#include "topk_postprocess.hpp"
+#include <atom/inference/cpu/kernels.hpp>
+#include <atom/inference/cpu/parallel.hpp>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define ATOM_X86_KERNELS 1
+#endif
+
+namespace atom::models {
+
+using atom::core::f32;
+using atom::core::i32;
+using atom::core::i64;
+
+namespace {
+
+// Rows per parallel chunk; smaller batches run on the calling thread and
+// never allocate
+constexpr i64 kRowGrain = 32;
+
+// Largest logit and sum of exp(logit - max) over a row
+struct RowStats {
+    f32 max;
+    f32 denominator;
+};
+
+// Sorted insert into the row's k slots, dropping the last when full. Equal
+// values go after the ones already there, so lower indices win ties.
+inline void Insert(f32 value, i32 index, size_t& count, size_t k, i32* indices, f32* values) {
+    size_t pos = count < k ? count++ : k - 1;
+    while (pos > 0 && values[pos - 1] < value) {
+        values[pos] = values[pos - 1];
+        indices[pos] = indices[pos - 1];
+        --pos;
+    }
+    values[pos] = value;
+    indices[pos] = index;
+}
+
+RowStats SelectRow(const f32* x, i64 classes, size_t k, i32* indices, f32* values, bool denominator) {
+    size_t count = 0;
+    for (i64 c = 0; c < classes; ++c) {
+        if (count < k || x[c] > values[k - 1]) Insert(x[c], static_cast<i32>(c), count, k, indices, values);
+    }
+    RowStats stats{values[0], 0.0f};
+    if (denominator) {
+        for (i64 c = 0; c < classes; ++c) stats.denominator += std::exp(x[c] - stats.max);
+    }
+    return stats;
+}
+
+#ifdef ATOM_X86_KERNELS
+
+// exp for softmax sums, Cephes polynomial; inputs below -87 flush to ~0
+__attribute__((target("avx2,fma")))
+inline __m256 Exp256(__m256 x) {
+    x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(-87.0f)), _mm256_set1_ps(88.0f));
+    const __m256 fx = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(1.44269504088896341f)),
+                                      _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(0.693359375f), x);
+    x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(-2.12194440e-4f), x);
+    __m256 p = _mm256_set1_ps(1.9875691500e-4f);
+    p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(1.3981999507e-3f));
+    p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(8.3334519073e-3f));
+    p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(4.1665795894e-2f));
+    p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(1.6666665459e-1f));
+    p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(5.0000001201e-1f));
+    const __m256 y = _mm256_add_ps(_mm256_fmadd_ps(_mm256_mul_ps(p, x), x, x), _mm256_set1_ps(1.0f));
+    const __m256i exponent = _mm256_slli_epi32(
+        _mm256_add_epi32(_mm256_cvtps_epi32(fx), _mm256_set1_epi32(127)), 23);
+    return _mm256_mul_ps(y, _mm256_castsi256_ps(exponent));
+}
+
+// One pass: lanes that beat the current k-th best are inserted in index
+// order, while every lane keeps its own running max and rescaled exp sum
+__attribute__((target("avx2,fma")))
+RowStats SelectRowAvx2(const f32* x, i64 classes, size_t k, i32* indices, f32* values, bool denominator) {
+    size_t count = 0;
+    __m256 lane_max = _mm256_set1_ps(-3.0e38f);
+    __m256 lane_sum = _mm256_setzero_ps();
+    i64 c = 0;
+    for (; c + 8 <= classes; c += 8) {
+        const __m256 v = _mm256_loadu_ps(x + c);
+        if (denominator) {
+            const __m256 new_max = _mm256_max_ps(lane_max, v);
+            lane_sum = _mm256_add_ps(_mm256_mul_ps(lane_sum, Exp256(_mm256_sub_ps(lane_max, new_max))),
+                                     Exp256(_mm256_sub_ps(v, new_max)));
+            lane_max = new_max;
+        }
+        const f32 threshold = count < k ? -INFINITY : values[k - 1];
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(v, _mm256_set1_ps(threshold), _CMP_GT_OQ));
+        for (; mask; mask &= mask - 1) {
+            const i64 lane = c + __builtin_ctz(mask);
+            if (count < k || x[lane] > values[k - 1]) Insert(x[lane], static_cast<i32>(lane), count, k, indices, values);
+        }
+    }
+    for (i64 tail = c; tail < classes; ++tail) {
+        if (count < k || x[tail] > values[k - 1]) Insert(x[tail], static_cast<i32>(tail), count, k, indices, values);
+    }
+
+    RowStats stats{values[0], 0.0f};
+    if (denominator) {
+        alignas(32) f32 maxima[8];
+        alignas(32) f32 sums[8];
+        _mm256_store_ps(maxima, lane_max);
+        _mm256_store_ps(sums, lane_sum);
+        for (int lane = 0; lane < 8; ++lane) {
+            if (sums[lane] > 0.0f) stats.denominator += sums[lane] * std::exp(maxima[lane] - stats.max);
+        }
+        for (i64 tail = c; tail < classes; ++tail) stats.denominator += std::exp(x[tail] - stats.max);
+    }
+    return stats;
+}
+
+#endif
+
+using SelectFunc = RowStats (*)(const f32*, i64, size_t, i32*, f32*, bool);
+
+SelectFunc SelectKernel() {
+#ifdef ATOM_X86_KERNELS
+    if (atom::inference::cpu::kernels::DetectCpuIsa() >= atom::inference::cpu::kernels::CpuIsa::Avx2) {
+        return SelectRowAvx2;
+    }
+#endif
+    return SelectRow;
+}
+
+} // namespace
+
+atom::core::Result<void> TopKPostprocessor::Process(const atom::core::Tensor& logits,
+                                                    ClassificationBatch& result) const {
+    const auto& shape = logits.GetShape();
+    if (logits.GetDataType() != atom::core::DataType::Float32 ||
+        logits.GetDevice().type != atom::core::DeviceType::CPU || shape.size() < 2 || shape.back() <= 0) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Top-k expects float32 host logits shaped [N, ..., classes]"));
+    }
+    if (config_.k == 0) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Top-k needs k of at least 1"));
+    }
+
+    const i64 classes = shape.back();
+    const i64 rows = static_cast<i64>(logits.GetSize()) / classes;
+    const size_t k = std::min<size_t>(config_.k, classes);
+    result.k = k;
+    result.indices.resize(rows * k);
+    result.scores.resize(rows * k);
+
+    static const SelectFunc select = SelectKernel();
+    const auto* data = static_cast<const f32*>(logits.GetData());
+    const auto normalization = config_.normalization;
+    const auto run = [&](i64 begin, i64 end) {
+        for (i64 row = begin; row < end; ++row) {
+            i32* indices = result.indices.data() + row * k;
+            f32* scores = result.scores.data() + row * k;
+            const auto stats = select(data + row * classes, classes, k, indices, scores,
+                                      normalization == TopKNormalization::Full);
+            if (normalization == TopKNormalization::None) continue;
+
+            f32 denominator = stats.denominator;
+            for (size_t i = 0; i < k; ++i) scores[i] = std::exp(scores[i] - stats.max);
+            if (normalization == TopKNormalization::TopK) {
+                denominator = 0.0f;
+                for (size_t i = 0; i < k; ++i) denominator += scores[i];
+            }
+            for (size_t i = 0; i < k; ++i) scores[i] /= denominator;
+        }
+    };
+    atom::inference::cpu::Parallel(atom::inference::cpu::ComputePool(),
+                                   atom::inference::cpu::ComputeThreadCount()).For(rows, kRowGrain, run);
+    return {};
+}
+
+atom::core::Result<ClassificationBatch> TopKPostprocessor::Process(const atom::core::Tensor& logits) const {
+    ClassificationBatch result;
+    auto processed = Process(logits, result);
+    if (!processed) return std::unexpected(processed.error());
+    return result;
+}
+
+std::unique_ptr<ClassificationStage> MakeTopKStage(TopKPostprocessor postprocessor, size_t num_workers) {
+    return std::make_unique<ClassificationStage>("topk",
+        [postprocessor = std::move(postprocessor)](const std::vector<atom::core::Tensor>& outputs)
+            -> atom::core::Result<ClassificationBatch> {
+            if (outputs.empty()) {
+                return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+                    "No model outputs"));
+            }
+            return postprocessor.Process(outputs[0]);
+        },
+        num_workers);
+}
+
+} // namespace atom::models
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atom/core/types.hpp>
+#include <atom/core/tensor.hpp>
+#include <atom/data/pipeline.hpp>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace atom::models {
+
+enum class TopKNormalization {
+    Full,       // softmax probabilities over every class
+    TopK,       // softmax over the k selected logits only
+    None        // raw logits
+};
+
+struct TopKConfig {
+    size_t k{5};
+    TopKNormalization normalization{TopKNormalization::Full};
+};
+
+// Best k labels of every row, best first; row n is [n * k, (n + 1) * k)
+struct ClassificationBatch {
+    std::vector<atom::core::i32> indices;
+    std::vector<atom::core::f32> scores;
+    size_t k{0};
+
+    size_t Size() const { return k ? indices.size() / k : 0; }
+    std::span<const atom::core::i32> Indices(size_t row) const {
+        return std::span<const atom::core::i32>(indices).subspan(row * k, k);
+    }
+    std::span<const atom::core::f32> Scores(size_t row) const {
+        return std::span<const atom::core::f32>(scores).subspan(row * k, k);
+    }
+};
+
+// Top-k over [N, classes] logits without a full sort or a full softmax. One
+// pass per row keeps the current k best with a SIMD threshold test, so only
+// the few logits that beat the k-th best are inserted, and folds the softmax
+// denominator into the same pass (a per-lane running max and rescaled sum).
+// Only the k winners are exponentiated for their scores. Ties keep the lower
+// class index first.
+class TopKPostprocessor {
+public:
+    explicit TopKPostprocessor(TopKConfig config = {}) : config_(config) {}
+
+    // Writes into `result`, whose buffers are reused: once they have held a
+    // batch this large, later calls do not allocate
+    atom::core::Result<void> Process(const atom::core::Tensor& logits, ClassificationBatch& result) const;
+    atom::core::Result<ClassificationBatch> Process(const atom::core::Tensor& logits) const;
+
+    const TopKConfig& GetConfig() const { return config_; }
+    void SetConfig(const TopKConfig& config) { config_ = config; }
+
+private:
+    TopKConfig config_;
+};
+
+// Runs top-k on its own worker threads: push the model's outputs, pop results
+using ClassificationStage = atom::data::PipelineStage<std::vector<atom::core::Tensor>, ClassificationBatch>;
+std::unique_ptr<ClassificationStage> MakeTopKStage(TopKPostprocessor postprocessor, size_t num_workers = 1);
+
+} // namespace atom::models
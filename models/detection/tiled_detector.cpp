@@ -0,0 +1,147 @@
+#include "tiled_detector.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace atom::models {
+
+using atom::core::f32;
+using atom::core::i64;
+
+namespace {
+
+// Evenly spaced tile origins along one axis; the last tile ends at the frame edge
+void TileOrigins(i64 frame, i64 tile, f32 overlap, std::vector<i64>& origins) {
+    origins.clear();
+    if (frame <= tile) {
+        origins.push_back(0);
+        return;
+    }
+    const f32 stride = std::max(1.0f, static_cast<f32>(tile) * (1.0f - overlap));
+    const i64 count = static_cast<i64>(std::ceil(static_cast<f32>(frame - tile) / stride)) + 1;
+    for (i64 i = 0; i < count; ++i) {
+        origins.push_back((frame - tile) * i / (count - 1));
+    }
+}
+
+f32 Area(const Detection& d) {
+    return std::max(0.0f, d.x2 - d.x1) * std::max(0.0f, d.y2 - d.y1);
+}
+
+} // namespace
+
+TiledDetector::TiledDetector(atom::core::IModel& model, DetectionDecoder decoder, TilingConfig config)
+    : model_(model), decoder_(std::move(decoder)), config_(std::move(config)), batch_(1) {
+    const auto metadata = model_.GetMetadata();
+    if (!metadata.input_shapes.empty() && metadata.input_shapes[0].size() == 4) {
+        tile_height_ = metadata.input_shapes[0][2];
+        tile_width_ = metadata.input_shapes[0][3];
+    }
+    config_.preprocess.target_size = cv::Size(static_cast<int>(tile_width_), static_cast<int>(tile_height_));
+    config_.overlap = std::clamp(config_.overlap, 0.0f, 0.9f);
+}
+
+TiledDetector::TiledDetector(YOLOv8& model, TilingConfig config)
+    : TiledDetector(model,
+                    [&model](const std::vector<atom::core::Tensor>& outputs, std::span<const LetterboxInfo> letterbox) {
+                        return YOLOv8Postprocessor(model.GetPostprocessConfig()).Process(outputs, letterbox);
+                    },
+                    std::move(config)) {}
+
+std::vector<atom::data::RoiBox> TiledDetector::PlanTiles(i64 frame_width, i64 frame_height) const {
+    std::vector<atom::data::RoiBox> tiles;
+    if (tile_width_ <= 0 || tile_height_ <= 0 || frame_width <= 0 || frame_height <= 0) return tiles;
+
+    std::vector<i64> xs;
+    std::vector<i64> ys;
+    TileOrigins(frame_width, tile_width_, config_.overlap, xs);
+    TileOrigins(frame_height, tile_height_, config_.overlap, ys);
+    tiles.reserve(xs.size() * ys.size() + 1);
+    for (const i64 y : ys) {
+        for (const i64 x : xs) {
+            tiles.push_back({static_cast<f32>(x), static_cast<f32>(y),
+                             static_cast<f32>(x + tile_width_), static_cast<f32>(y + tile_height_)});
+        }
+    }
+
+    if (config_.include_full_frame && tiles.size() > 1) {
+        // Whole frame at one scale, extended right or down to the tile's aspect
+        const f32 s = std::max(static_cast<f32>(frame_width) / static_cast<f32>(tile_width_),
+                               static_cast<f32>(frame_height) / static_cast<f32>(tile_height_));
+        tiles.push_back({0.0f, 0.0f, s * static_cast<f32>(tile_width_), s * static_cast<f32>(tile_height_)});
+    }
+    return tiles;
+}
+
+atom::core::Result<std::vector<Detection>> TiledDetector::Detect(const cv::Mat& frame) {
+    if (tile_width_ <= 0 || tile_height_ <= 0) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Tiling needs a model with a fixed NCHW input shape"));
+    }
+
+    const auto tiles = PlanTiles(frame.cols, frame.rows);
+    if (tiles.empty()) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument, "Empty frame"));
+    }
+
+    // Tile boxes map to frame pixels as frame = (tile - pad) / scale
+    letterbox_.clear();
+    for (const auto& tile : tiles) {
+        const f32 scale = static_cast<f32>(tile_width_) / (tile.x2 - tile.x1);
+        letterbox_.push_back({scale, -tile.x1 * scale, -tile.y1 * scale,
+                              static_cast<f32>(frame.cols), static_cast<f32>(frame.rows)});
+    }
+
+    auto cropped = atom::data::CropResizeBatch(frame, tiles, config_.preprocess, batch_[0]);
+    if (!cropped) return std::unexpected(cropped.error());
+
+    auto outputs = model_.Infer(batch_);
+    if (!outputs) return std::unexpected(outputs.error());
+
+    auto decoded = decoder_(*outputs, letterbox_);
+    if (!decoded) return std::unexpected(decoded.error());
+
+    std::vector<Detection> detections = std::move(decoded->detections);
+    Merge(detections);
+    return detections;
+}
+
+void TiledDetector::Merge(std::vector<Detection>& detections) const {
+    // Greedy NMS over all tiles. Besides IoU, a box mostly inside a better
+    // one of the same class goes too: that is the piece of an object cut off
+    // at a tile seam, which has a low IoU with the whole box.
+    std::stable_sort(detections.begin(), detections.end(), [this](const Detection& a, const Detection& b) {
+        if (!config_.class_agnostic && a.class_id != b.class_id) return a.class_id < b.class_id;
+        return a.score > b.score;
+    });
+
+    std::vector<Detection> kept;
+    kept.reserve(detections.size());
+    size_t group_begin = 0;
+    for (const auto& candidate : detections) {
+        if (!kept.empty() && !config_.class_agnostic && kept.back().class_id != candidate.class_id) {
+            group_begin = kept.size();
+        }
+        const f32 area = Area(candidate);
+        bool suppressed = false;
+        for (size_t i = group_begin; i < kept.size() && !suppressed; ++i) {
+            const auto& other = kept[i];
+            const f32 w = std::min(candidate.x2, other.x2) - std::max(candidate.x1, other.x1);
+            const f32 h = std::min(candidate.y2, other.y2) - std::max(candidate.y1, other.y1);
+            if (w <= 0.0f || h <= 0.0f) continue;
+            const f32 inter = w * h;
+            const f32 other_area = Area(other);
+            const f32 smaller = std::min(area, other_area);
+            suppressed = inter > config_.merge_iou_threshold * (area + other_area - inter) ||
+                         (smaller > 0.0f && inter > config_.merge_ios_threshold * smaller);
+        }
+        if (!suppressed) kept.push_back(candidate);
+    }
+
+    std::stable_sort(kept.begin(), kept.end(), [](const Detection& a, const Detection& b) {
+        return a.score > b.score;
+    });
+    if (kept.size() > config_.max_detections) kept.resize(config_.max_detections);
+    detections = std::move(kept);
+}
+
+} // namespace atom::models
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "yolo/yolov8.hpp"
+#include <atom/data/roi_align.hpp>
+#include <functional>
+
+namespace atom::models {
+
+struct TilingConfig {
+    atom::core::f32 overlap{0.2f};              // share of a tile covered by its neighbour
+    bool include_full_frame{true};              // one extra downscaled pass for objects larger than a tile
+    atom::core::f32 merge_iou_threshold{0.5f};
+    atom::core::f32 merge_ios_threshold{0.8f};  // intersection over the smaller box, for boxes cut at tile seams
+    bool class_agnostic{false};
+    size_t max_detections{1000};
+    // Tile pixels as the detector expects them; target_size comes from the model
+    atom::data::PreprocessConfig preprocess{.normalize = false};
+};
+
+// Decodes one batch of tile outputs; letterbox has an entry per tile mapping
+// its boxes to frame pixels
+using DetectionDecoder = std::function<atom::core::Result<DetectionBatch>(
+    const std::vector<atom::core::Tensor>& outputs, std::span<const LetterboxInfo> letterbox)>;
+
+// High-resolution detection by tiling. The frame is split into overlapping
+// tiles of the model's input size (from its metadata), all cropped in one
+// pass into a single batch and run with one Infer; tile detections are then
+// moved to frame coordinates and merged across tiles with NMS that also
+// drops boxes mostly contained in a better one. Works with any model whose
+// metadata gives an NCHW input and whose outputs `decoder` understands.
+// Buffers are kept between calls; use one detector per thread.
+class TiledDetector {
+public:
+    TiledDetector(atom::core::IModel& model, DetectionDecoder decoder, TilingConfig config = {});
+    // Decodes with the model's own post-processing settings
+    explicit TiledDetector(YOLOv8& model, TilingConfig config = {});
+
+    atom::core::Result<std::vector<Detection>> Detect(const cv::Mat& frame);
+
+    // Tiles covering a frame, in frame pixels, full-frame pass last
+    std::vector<atom::data::RoiBox> PlanTiles(atom::core::i64 frame_width, atom::core::i64 frame_height) const;
+
+    const TilingConfig& GetConfig() const { return config_; }
+
+private:
+    atom::core::IModel& model_;
+    DetectionDecoder decoder_;
+    TilingConfig config_;
+    atom::core::i64 tile_height_{0};
+    atom::core::i64 tile_width_{0};
+
+    std::vector<atom::core::Tensor> batch_;
+    std::vector<LetterboxInfo> letterbox_;
+
+    void Merge(std::vector<Detection>& detections) const;
+};
+
+} // namespace atom::models
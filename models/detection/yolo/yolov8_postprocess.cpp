@@ -0,0 +1,426 @@
+#include "yolov8_postprocess.hpp"
+#include <atom/inference/cpu/kernels.hpp>
+#include <atom/inference/cpu/parallel.hpp>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define ATOM_X86_KERNELS 1
+#endif
+
+namespace atom::models {
+
+using atom::core::f32;
+using atom::core::i32;
+using atom::core::i64;
+using atom::core::u32;
+
+namespace {
+
+// Anchors per step of the planar class scan; a few vectors wide so each
+// class row is read in whole cache lines
+constexpr i64 kAnchorBlock = 32;
+
+struct Candidate {
+    f32 score;
+    u32 anchor;
+    i32 class_id;
+};
+
+// Where one image's boxes and scores live. Anchor-major data has the values
+// of one anchor next to each other; planar data has one row per channel.
+struct ImageView {
+    const f32* boxes;
+    const f32* scores;
+    i64 anchors;
+    i64 classes;
+    bool planar;
+};
+
+// Candidate boxes of one image as corner arrays, for vectorized IoU
+struct BoxSet {
+    std::vector<f32> x1, y1, x2, y2, area;
+
+    void Resize(size_t size) {
+        x1.resize(size); y1.resize(size); x2.resize(size); y2.resize(size); area.resize(size);
+    }
+};
+
+void ScanAnchorMajor(const ImageView& view, f32 threshold, std::vector<Candidate>& out) {
+    for (i64 a = 0; a < view.anchors; ++a) {
+        const f32* s = view.scores + a * view.classes;
+        const f32* best = std::max_element(s, s + view.classes);
+        if (*best >= threshold) {
+            out.push_back({*best, static_cast<u32>(a), static_cast<i32>(best - s)});
+        }
+    }
+}
+
+// Anchors from `first` on
+void ScanPlanarFrom(const ImageView& view, i64 first, f32 threshold, std::vector<Candidate>& out) {
+    f32 best[kAnchorBlock];
+    i32 best_class[kAnchorBlock];
+    for (i64 a0 = first; a0 < view.anchors; a0 += kAnchorBlock) {
+        const i64 n = std::min(kAnchorBlock, view.anchors - a0);
+        std::copy_n(view.scores + a0, n, best);
+        std::fill_n(best_class, n, 0);
+        for (i64 c = 1; c < view.classes; ++c) {
+            const f32* row = view.scores + c * view.anchors + a0;
+            for (i64 i = 0; i < n; ++i) {
+                if (row[i] > best[i]) {
+                    best[i] = row[i];
+                    best_class[i] = static_cast<i32>(c);
+                }
+            }
+        }
+        for (i64 i = 0; i < n; ++i) {
+            if (best[i] >= threshold) out.push_back({best[i], static_cast<u32>(a0 + i), best_class[i]});
+        }
+    }
+}
+
+void ScanPlanar(const ImageView& view, f32 threshold, std::vector<Candidate>& out) {
+    ScanPlanarFrom(view, 0, threshold, out);
+}
+
+void IoURow(const BoxSet& b, size_t i, size_t begin, size_t end, f32* out) {
+    for (size_t j = begin; j < end; ++j) {
+        const f32 w = std::max(0.0f, std::min(b.x2[i], b.x2[j]) - std::max(b.x1[i], b.x1[j]));
+        const f32 h = std::max(0.0f, std::min(b.y2[i], b.y2[j]) - std::max(b.y1[i], b.y1[j]));
+        const f32 inter = w * h;
+        out[j - begin] = inter / std::max(b.area[i] + b.area[j] - inter, 1e-9f);
+    }
+}
+
+#ifdef ATOM_X86_KERNELS
+
+__attribute__((target("avx2,fma")))
+inline f32 HorizontalMax(__m256 v) {
+    __m128 m = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+    m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+    return _mm_cvtss_f32(m);
+}
+
+// Vector max first; only anchors that pass the threshold look for the argmax
+__attribute__((target("avx2,fma")))
+void ScanAnchorMajorAvx2(const ImageView& view, f32 threshold, std::vector<Candidate>& out) {
+    const i64 vector_classes = view.classes & ~i64{7};
+    for (i64 a = 0; a < view.anchors; ++a) {
+        const f32* s = view.scores + a * view.classes;
+        __m256 m = _mm256_set1_ps(-INFINITY);
+        for (i64 c = 0; c < vector_classes; c += 8) {
+            m = _mm256_max_ps(m, _mm256_loadu_ps(s + c));
+        }
+        f32 best = HorizontalMax(m);
+        for (i64 c = vector_classes; c < view.classes; ++c) best = std::max(best, s[c]);
+        if (best >= threshold) {
+            const i32 best_class = static_cast<i32>(std::find(s, s + view.classes, best) - s);
+            out.push_back({best, static_cast<u32>(a), best_class});
+        }
+    }
+}
+
+// Running max and argmax across class rows, eight anchors per lane group
+__attribute__((target("avx2,fma")))
+void ScanPlanarAvx2(const ImageView& view, f32 threshold, std::vector<Candidate>& out) {
+    constexpr i64 kVectors = kAnchorBlock / 8;
+    const __m256 limit = _mm256_set1_ps(threshold);
+    i64 a0 = 0;
+    for (; a0 + kAnchorBlock <= view.anchors; a0 += kAnchorBlock) {
+        __m256 best[kVectors];
+        __m256i best_class[kVectors];
+        for (i64 v = 0; v < kVectors; ++v) {
+            best[v] = _mm256_loadu_ps(view.scores + a0 + v * 8);
+            best_class[v] = _mm256_setzero_si256();
+        }
+        for (i64 c = 1; c < view.classes; ++c) {
+            const f32* row = view.scores + c * view.anchors + a0;
+            const __m256i class_id = _mm256_set1_epi32(static_cast<i32>(c));
+            for (i64 v = 0; v < kVectors; ++v) {
+                const __m256 s = _mm256_loadu_ps(row + v * 8);
+                const __m256 greater = _mm256_cmp_ps(s, best[v], _CMP_GT_OQ);
+                best[v] = _mm256_max_ps(s, best[v]);
+                best_class[v] = _mm256_castps_si256(_mm256_blendv_ps(
+                    _mm256_castsi256_ps(best_class[v]), _mm256_castsi256_ps(class_id), greater));
+            }
+        }
+        for (i64 v = 0; v < kVectors; ++v) {
+            int mask = _mm256_movemask_ps(_mm256_cmp_ps(best[v], limit, _CMP_GE_OQ));
+            if (mask == 0) continue;
+            alignas(32) f32 scores[8];
+            alignas(32) i32 classes[8];
+            _mm256_store_ps(scores, best[v]);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(classes), best_class[v]);
+            for (; mask; mask &= mask - 1) {
+                const int lane = __builtin_ctz(mask);
+                out.push_back({scores[lane], static_cast<u32>(a0 + v * 8 + lane), classes[lane]});
+            }
+        }
+    }
+    ScanPlanarFrom(view, a0, threshold, out);
+}
+
+__attribute__((target("avx2,fma")))
+void IoURowAvx2(const BoxSet& b, size_t i, size_t begin, size_t end, f32* out) {
+    const __m256 ax1 = _mm256_set1_ps(b.x1[i]);
+    const __m256 ay1 = _mm256_set1_ps(b.y1[i]);
+    const __m256 ax2 = _mm256_set1_ps(b.x2[i]);
+    const __m256 ay2 = _mm256_set1_ps(b.y2[i]);
+    const __m256 area = _mm256_set1_ps(b.area[i]);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 epsilon = _mm256_set1_ps(1e-9f);
+    size_t j = begin;
+    for (; j + 8 <= end; j += 8) {
+        const __m256 w = _mm256_max_ps(zero, _mm256_sub_ps(_mm256_min_ps(ax2, _mm256_loadu_ps(&b.x2[j])),
+                                                           _mm256_max_ps(ax1, _mm256_loadu_ps(&b.x1[j]))));
+        const __m256 h = _mm256_max_ps(zero, _mm256_sub_ps(_mm256_min_ps(ay2, _mm256_loadu_ps(&b.y2[j])),
+                                                           _mm256_max_ps(ay1, _mm256_loadu_ps(&b.y1[j]))));
+        const __m256 inter = _mm256_mul_ps(w, h);
+        const __m256 uni = _mm256_sub_ps(_mm256_add_ps(area, _mm256_loadu_ps(&b.area[j])), inter);
+        _mm256_storeu_ps(out + (j - begin), _mm256_div_ps(inter, _mm256_max_ps(uni, epsilon)));
+    }
+    IoURow(b, i, j, end, out + (j - begin));
+}
+
+#endif
+
+struct Kernels {
+    void (*scan_anchor_major)(const ImageView&, f32, std::vector<Candidate>&) = ScanAnchorMajor;
+    void (*scan_planar)(const ImageView&, f32, std::vector<Candidate>&) = ScanPlanar;
+    void (*iou_row)(const BoxSet&, size_t, size_t, size_t, f32*) = IoURow;
+};
+
+const Kernels& SelectKernels() {
+    static const Kernels kernels = [] {
+        Kernels k;
+#ifdef ATOM_X86_KERNELS
+        if (atom::inference::cpu::kernels::DetectCpuIsa() >= atom::inference::cpu::kernels::CpuIsa::Avx2) {
+            k.scan_anchor_major = ScanAnchorMajorAvx2;
+            k.scan_planar = ScanPlanarAvx2;
+            k.iou_row = IoURowAvx2;
+        }
+#endif
+        return k;
+    }();
+    return kernels;
+}
+
+// NMS over one class group [begin, end) of score-sorted boxes. Returns the
+// kept indices; Matrix NMS rewrites `scores` with the decayed values.
+void SuppressGroup(const BoxSet& boxes, std::vector<f32>& scores, size_t begin, size_t end,
+                   const YOLOv8PostprocessConfig& config, std::vector<f32>& row,
+                   std::vector<size_t>& kept) {
+    const auto& kernels = SelectKernels();
+    const size_t n = end - begin;
+    row.resize(n);
+
+    switch (config.nms) {
+        case NmsMethod::Greedy: {
+            std::vector<unsigned char> suppressed(n, 0);
+            size_t kept_here = 0;
+            for (size_t i = 0; i < n && kept_here < config.max_detections; ++i) {
+                if (suppressed[i]) continue;
+                kept.push_back(begin + i);
+                ++kept_here;
+                kernels.iou_row(boxes, begin + i, begin + i + 1, end, row.data());
+                for (size_t j = i + 1; j < n; ++j) {
+                    suppressed[j] |= row[j - i - 1] > config.iou_threshold;
+                }
+            }
+            break;
+        }
+        case NmsMethod::Fast: {
+            std::vector<f32> max_iou(n, 0.0f);
+            for (size_t i = 0; i + 1 < n; ++i) {
+                kernels.iou_row(boxes, begin + i, begin + i + 1, end, row.data());
+                for (size_t j = i + 1; j < n; ++j) {
+                    max_iou[j] = std::max(max_iou[j], row[j - i - 1]);
+                }
+            }
+            for (size_t i = 0; i < n; ++i) {
+                if (max_iou[i] <= config.iou_threshold) kept.push_back(begin + i);
+            }
+            break;
+        }
+        case NmsMethod::Matrix: {
+            // How much each box is itself suppressed, then the decay it applies
+            std::vector<f32> compensate(n, 0.0f);
+            for (size_t i = 0; i + 1 < n; ++i) {
+                kernels.iou_row(boxes, begin + i, begin + i + 1, end, row.data());
+                for (size_t j = i + 1; j < n; ++j) {
+                    compensate[j] = std::max(compensate[j], row[j - i - 1]);
+                }
+            }
+            std::vector<f32> decay(n, 1.0f);
+            const f32 sigma = config.matrix_sigma;
+            for (size_t i = 0; i + 1 < n; ++i) {
+                kernels.iou_row(boxes, begin + i, begin + i + 1, end, row.data());
+                for (size_t j = i + 1; j < n; ++j) {
+                    const f32 iou = row[j - i - 1];
+                    const f32 d = sigma > 0.0f
+                        ? std::exp(-sigma * (iou * iou - compensate[i] * compensate[i]))
+                        : (1.0f - iou) / std::max(1.0f - compensate[i], 1e-6f);
+                    decay[j] = std::min(decay[j], d);
+                }
+            }
+            for (size_t i = 0; i < n; ++i) {
+                scores[begin + i] *= decay[i];
+                if (scores[begin + i] >= config.confidence_threshold) kept.push_back(begin + i);
+            }
+            break;
+        }
+    }
+}
+
+void ProcessImage(const ImageView& view, const LetterboxInfo& letterbox,
+                  const YOLOv8PostprocessConfig& config, std::vector<Detection>& out) {
+    const auto& kernels = SelectKernels();
+
+    std::vector<Candidate> candidates;
+    (view.planar ? kernels.scan_planar : kernels.scan_anchor_major)(view, config.confidence_threshold, candidates);
+    if (candidates.empty()) return;
+
+    // Best first within each class (or overall when class-agnostic), ties by anchor
+    const auto by_score = [](const Candidate& a, const Candidate& b) {
+        return a.score > b.score || (a.score == b.score && a.anchor < b.anchor);
+    };
+    if (candidates.size() > config.max_candidates) {
+        std::nth_element(candidates.begin(), candidates.begin() + config.max_candidates,
+                         candidates.end(), by_score);
+        candidates.resize(config.max_candidates);
+    }
+    std::sort(candidates.begin(), candidates.end(), [&](const Candidate& a, const Candidate& b) {
+        if (!config.class_agnostic && a.class_id != b.class_id) return a.class_id < b.class_id;
+        return by_score(a, b);
+    });
+
+    const size_t count = candidates.size();
+    BoxSet boxes;
+    boxes.Resize(count);
+    std::vector<f32> scores(count);
+    const f32 inverse_scale = letterbox.scale > 0.0f ? 1.0f / letterbox.scale : 1.0f;
+    const f32 max_x = letterbox.image_width > 0.0f ? letterbox.image_width : INFINITY;
+    const f32 max_y = letterbox.image_height > 0.0f ? letterbox.image_height : INFINITY;
+    for (size_t i = 0; i < count; ++i) {
+        const i64 a = candidates[i].anchor;
+        f32 cx, cy, w, h;
+        if (view.planar) {
+            cx = view.boxes[a];
+            cy = view.boxes[view.anchors + a];
+            w = view.boxes[2 * view.anchors + a];
+            h = view.boxes[3 * view.anchors + a];
+        } else {
+            const f32* box = view.boxes + a * 4;
+            cx = box[0]; cy = box[1]; w = box[2]; h = box[3];
+        }
+        boxes.x1[i] = std::clamp((cx - 0.5f * w - letterbox.pad_x) * inverse_scale, 0.0f, max_x);
+        boxes.y1[i] = std::clamp((cy - 0.5f * h - letterbox.pad_y) * inverse_scale, 0.0f, max_y);
+        boxes.x2[i] = std::clamp((cx + 0.5f * w - letterbox.pad_x) * inverse_scale, 0.0f, max_x);
+        boxes.y2[i] = std::clamp((cy + 0.5f * h - letterbox.pad_y) * inverse_scale, 0.0f, max_y);
+        boxes.area[i] = (boxes.x2[i] - boxes.x1[i]) * (boxes.y2[i] - boxes.y1[i]);
+        scores[i] = candidates[i].score;
+    }
+
+    std::vector<size_t> kept;
+    std::vector<f32> row;
+    for (size_t begin = 0; begin < count;) {
+        size_t end = begin + 1;
+        if (config.class_agnostic) {
+            end = count;
+        } else {
+            while (end < count && candidates[end].class_id == candidates[begin].class_id) ++end;
+        }
+        SuppressGroup(boxes, scores, begin, end, config, row, kept);
+        begin = end;
+    }
+
+    std::sort(kept.begin(), kept.end(), [&](size_t a, size_t b) {
+        return scores[a] > scores[b] || (scores[a] == scores[b] && candidates[a].anchor < candidates[b].anchor);
+    });
+    if (kept.size() > config.max_detections) kept.resize(config.max_detections);
+
+    out.reserve(kept.size());
+    for (size_t i : kept) {
+        out.push_back({boxes.x1[i], boxes.y1[i], boxes.x2[i], boxes.y2[i], scores[i], candidates[i].class_id});
+    }
+}
+
+bool IsHostFloat(const atom::core::Tensor& tensor) {
+    return tensor.GetDataType() == atom::core::DataType::Float32 &&
+           tensor.GetDevice().type == atom::core::DeviceType::CPU;
+}
+
+} // namespace
+
+atom::core::Result<DetectionBatch> YOLOv8Postprocessor::Process(
+    const std::vector<atom::core::Tensor>& outputs, std::span<const LetterboxInfo> letterbox) const {
+
+    if (outputs.empty() || !IsHostFloat(outputs[0]) || outputs[0].GetShape().size() != 3) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "YOLOv8 post-processing expects float32 host outputs of rank 3"));
+    }
+
+    // Split outputs: boxes [N, A, 4] and scores [N, A, C]; raw: [N, 4 + C, A]
+    const auto& first = outputs[0].GetShape();
+    const bool split = outputs.size() > 1 && first[2] == 4;
+    i64 batch = first[0];
+    i64 anchors = 0;
+    i64 classes = 0;
+    const f32* box_data = static_cast<const f32*>(outputs[0].GetData());
+    const f32* score_data = nullptr;
+    i64 box_stride = 0;
+    i64 score_stride = 0;
+    if (split) {
+        const auto& scores = outputs[1].GetShape();
+        if (!IsHostFloat(outputs[1]) || scores.size() != 3 || scores[0] != batch || scores[1] != first[1]) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+                "YOLOv8 score output does not match the box output"));
+        }
+        anchors = first[1];
+        classes = scores[2];
+        score_data = static_cast<const f32*>(outputs[1].GetData());
+        box_stride = anchors * 4;
+        score_stride = anchors * classes;
+    } else {
+        anchors = first[2];
+        classes = first[1] - 4;
+        score_data = box_data + 4 * anchors;
+        box_stride = score_stride = first[1] * anchors;
+    }
+    if (classes <= 0 || anchors <= 0) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "YOLOv8 outputs have no classes or anchors"));
+    }
+    if (letterbox.size() > 1 && static_cast<i64>(letterbox.size()) != batch) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Letterbox entries do not match the batch"));
+    }
+
+    std::vector<std::vector<Detection>> per_image(batch);
+    const LetterboxInfo identity;
+    const auto run = [&](i64 begin, i64 end) {
+        for (i64 n = begin; n < end; ++n) {
+            const ImageView view{box_data + n * box_stride, score_data + n * score_stride,
+                                 anchors, classes, !split};
+            const auto& info = letterbox.empty() ? identity : letterbox[letterbox.size() == 1 ? 0 : n];
+            ProcessImage(view, info, config_, per_image[n]);
+        }
+    };
+    atom::inference::cpu::Parallel(atom::inference::cpu::ComputePool(),
+                                   atom::inference::cpu::ComputeThreadCount()).For(batch, 1, run);
+
+    DetectionBatch result;
+    size_t total = 0;
+    for (const auto& image : per_image) total += image.size();
+    result.detections.reserve(total);
+    result.offsets.reserve(batch + 1);
+    for (const auto& image : per_image) {
+        result.detections.insert(result.detections.end(), image.begin(), image.end());
+        result.offsets.push_back(static_cast<u32>(result.detections.size()));
+    }
+    return result;
+}
+
+} // namespace atom::models
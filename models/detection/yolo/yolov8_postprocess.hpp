@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atom/core/types.hpp>
+#include <atom/core/tensor.hpp>
+#include <span>
+#include <vector>
+
+namespace atom::models {
+
+enum class NmsMethod {
+    Greedy,     // drop boxes overlapping a higher-scored kept box
+    Fast,       // drop boxes overlapping any higher-scored box, kept or not (YOLACT)
+    Matrix      // decay scores by overlap instead of dropping (SOLOv2)
+};
+
+// How an image was fit into the network input: resized by `scale`, then
+// offset by the padding. Boxes are mapped back and clipped to the image.
+struct LetterboxInfo {
+    atom::core::f32 scale{1.0f};
+    atom::core::f32 pad_x{0.0f};
+    atom::core::f32 pad_y{0.0f};
+    atom::core::f32 image_width{0.0f};    // 0 = no clipping
+    atom::core::f32 image_height{0.0f};
+};
+
+struct YOLOv8PostprocessConfig {
+    atom::core::f32 confidence_threshold{0.25f};
+    atom::core::f32 iou_threshold{0.45f};
+    size_t max_candidates{30000};         // best-scoring boxes per image that reach NMS
+    size_t max_detections{300};           // per image
+    bool class_agnostic{false};
+    NmsMethod nms{NmsMethod::Greedy};
+    atom::core::f32 matrix_sigma{2.0f};   // Matrix NMS gaussian decay, 0 = linear decay
+};
+
+struct Detection {
+    atom::core::f32 x1, y1, x2, y2;       // image pixels
+    atom::core::f32 score;
+    atom::core::i32 class_id;
+};
+
+// Detections of a whole batch in one array, best first within each image
+struct DetectionBatch {
+    std::vector<Detection> detections;
+    std::vector<atom::core::u32> offsets{0};   // image i owns [offsets[i], offsets[i + 1])
+
+    size_t ImageCount() const { return offsets.size() - 1; }
+    std::span<const Detection> operator[](size_t image) const {
+        return std::span<const Detection>(detections).subspan(offsets[image], offsets[image + 1] - offsets[image]);
+    }
+};
+
+// Turns raw YOLOv8 outputs into detections: a SIMD max over classes drops
+// anchors below the confidence threshold before anything else is touched,
+// survivors are decoded from center/size to corners and un-letterboxed,
+// then NMS runs per class on score-sorted candidates, computing IoU rows a
+// SIMD block at a time. Images of a batch run in parallel on the compute pool.
+//
+// Accepts the model's split outputs (boxes [N, A, 4] as cx, cy, w, h and
+// class scores [N, A, C]; further outputs are ignored) or the raw export
+// layout, one [N, 4 + C, A] tensor. Scores are probabilities.
+class YOLOv8Postprocessor {
+public:
+    explicit YOLOv8Postprocessor(YOLOv8PostprocessConfig config = {}) : config_(config) {}
+
+    // letterbox holds one entry per image, one for every image, or none
+    atom::core::Result<DetectionBatch> Process(const std::vector<atom::core::Tensor>& outputs,
+                                               std::span<const LetterboxInfo> letterbox = {}) const;
+
+    const YOLOv8PostprocessConfig& GetConfig() const { return config_; }
+    void SetConfig(const YOLOv8PostprocessConfig& config) { config_ = config; }
+
+private:
+    YOLOv8PostprocessConfig config_;
+};
+
+} // namespace atom::models
@@ -0,0 +1,206 @@
+#include "byte_tracker.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace atom::models {
+
+using atom::core::f32;
+using atom::core::u32;
+
+namespace {
+
+// Noise as fractions of the box height (the ByteTrack / SORT defaults)
+constexpr f32 kPositionWeight = 1.0f / 20.0f;
+constexpr f32 kVelocityWeight = 1.0f / 160.0f;
+
+f32 IoU(const Detection& a, const Detection& b) {
+    const f32 w = std::min(a.x2, b.x2) - std::max(a.x1, b.x1);
+    const f32 h = std::min(a.y2, b.y2) - std::max(a.y1, b.y1);
+    if (w <= 0.0f || h <= 0.0f) return 0.0f;
+    const f32 inter = w * h;
+    const f32 area_a = (a.x2 - a.x1) * (a.y2 - a.y1);
+    const f32 area_b = (b.x2 - b.x1) * (b.y2 - b.y1);
+    return inter / (area_a + area_b - inter);
+}
+
+} // namespace
+
+ByteTracker::ByteTracker(TrackerConfig config) : config_(config) {
+    config_.max_interval = std::max<u32>(config_.max_interval, 1);
+    config_.new_object_interval = std::clamp<u32>(config_.new_object_interval, 1, config_.max_interval);
+}
+
+void ByteTracker::Reset() {
+    entries_.clear();
+    output_.clear();
+    stats_ = {};
+    next_id_ = 1;
+    frames_since_detection_ = 0;
+    births_pending_ = false;
+}
+
+void ByteTracker::PredictEntries() {
+    for (auto& entry : entries_) {
+        const f32 h = std::max(entry.axes[3].x, 1.0f);
+        const f32 q_position = (kPositionWeight * h) * (kPositionWeight * h);
+        const f32 q_velocity = (kVelocityWeight * h) * (kVelocityWeight * h);
+        for (auto& a : entry.axes) {
+            a.x += a.v;
+            a.p00 += 2.0f * a.p01 + a.p11 + q_position;
+            a.p01 += a.p11;
+            a.p11 += q_velocity;
+        }
+        entry.axes[2].x = std::max(entry.axes[2].x, 1.0f);
+        entry.axes[3].x = std::max(entry.axes[3].x, 1.0f);
+
+        auto& track = entry.track;
+        track.box.x1 = entry.axes[0].x - 0.5f * entry.axes[2].x;
+        track.box.y1 = entry.axes[1].x - 0.5f * entry.axes[3].x;
+        track.box.x2 = entry.axes[0].x + 0.5f * entry.axes[2].x;
+        track.box.y2 = entry.axes[1].x + 0.5f * entry.axes[3].x;
+        track.confidence *= config_.confidence_decay;
+        ++track.frames_since_match;
+    }
+}
+
+void ByteTracker::Correct(Entry& entry, const Detection& detection) const {
+    const f32 z[4] = {0.5f * (detection.x1 + detection.x2), 0.5f * (detection.y1 + detection.y2),
+                      detection.x2 - detection.x1, detection.y2 - detection.y1};
+    const f32 r = (kPositionWeight * z[3]) * (kPositionWeight * z[3]);
+    for (int i = 0; i < 4; ++i) {
+        auto& a = entry.axes[i];
+        const f32 s = a.p00 + r;
+        const f32 k0 = a.p00 / s;
+        const f32 k1 = a.p01 / s;
+        const f32 innovation = z[i] - a.x;
+        a.x += k0 * innovation;
+        a.v += k1 * innovation;
+        a.p11 -= k1 * a.p01;
+        a.p00 *= 1.0f - k0;
+        a.p01 *= 1.0f - k0;
+    }
+
+    auto& track = entry.track;
+    track.box = detection;
+    track.confidence = detection.score;
+    track.frames_since_match = 0;
+    ++track.hits;
+    if (track.state == TrackState::Lost || track.hits >= config_.min_hits) {
+        track.state = TrackState::Tracked;
+    }
+}
+
+void ByteTracker::Start(const Detection& detection) {
+    Entry entry;
+    const f32 h = std::max(detection.y2 - detection.y1, 1.0f);
+    const f32 p_position = (2.0f * kPositionWeight * h) * (2.0f * kPositionWeight * h);
+    const f32 p_velocity = (10.0f * kVelocityWeight * h) * (10.0f * kVelocityWeight * h);
+    const f32 z[4] = {0.5f * (detection.x1 + detection.x2), 0.5f * (detection.y1 + detection.y2),
+                      detection.x2 - detection.x1, detection.y2 - detection.y1};
+    for (int i = 0; i < 4; ++i) {
+        entry.axes[i] = {z[i], 0.0f, p_position, 0.0f, p_velocity};
+    }
+    // Tracks present on the very first frame are trusted right away
+    const bool confirmed = stats_.frames == 1 || config_.min_hits <= 1;
+    entry.track = {next_id_++, detection, confirmed ? TrackState::Tracked : TrackState::Tentative,
+                   detection.score, 1, 0};
+    entries_.push_back(entry);
+    ++stats_.tracks_started;
+}
+
+void ByteTracker::Associate(std::span<const Detection> detections, f32 min_score, f32 max_score,
+                            bool lost_too) {
+    matches_.clear();
+    for (u32 i = 0; i < entries_.size(); ++i) {
+        const auto& track = entries_[i].track;
+        if (entry_matched_[i] || (!lost_too && track.state != TrackState::Tracked)) continue;
+        for (u32 j = 0; j < detections.size(); ++j) {
+            const auto& detection = detections[j];
+            if (detection_matched_[j] || detection.score < min_score || detection.score >= max_score) continue;
+            if (config_.class_aware && detection.class_id != track.box.class_id) continue;
+            const f32 iou = IoU(track.box, detection);
+            if (iou >= config_.match_iou) matches_.push_back({iou, i, j});
+        }
+    }
+
+    std::sort(matches_.begin(), matches_.end(), [](const Match& a, const Match& b) { return a.iou > b.iou; });
+    for (const auto& match : matches_) {
+        if (entry_matched_[match.entry] || detection_matched_[match.detection]) continue;
+        entry_matched_[match.entry] = 1;
+        detection_matched_[match.detection] = 1;
+        Correct(entries_[match.entry], detections[match.detection]);
+    }
+}
+
+std::span<const Track> ByteTracker::Update(std::span<const Detection> detections) {
+    ++stats_.frames;
+    ++stats_.detected_frames;
+    frames_since_detection_ = 0;
+    PredictEntries();
+
+    entry_matched_.assign(entries_.size(), 0);
+    detection_matched_.assign(detections.size(), 0);
+    Associate(detections, config_.high_threshold, std::numeric_limits<f32>::infinity(), true);
+    Associate(detections, config_.low_threshold, config_.high_threshold, false);
+
+    // Unmatched: new tracks are dropped, confirmed ones go lost until they age out
+    size_t kept = 0;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        auto& track = entries_[i].track;
+        if (!entry_matched_[i]) {
+            if (track.state == TrackState::Tentative) continue;
+            track.state = TrackState::Lost;
+            if (track.frames_since_match > config_.max_lost_frames) continue;
+        }
+        if (kept != i) entries_[kept] = entries_[i];
+        ++kept;
+    }
+    entries_.resize(kept);
+
+    births_pending_ = false;
+    for (size_t j = 0; j < detections.size(); ++j) {
+        if (!detection_matched_[j] && detections[j].score >= config_.new_track_threshold) {
+            Start(detections[j]);
+            births_pending_ = true;
+        }
+    }
+
+    Publish();
+    return output_;
+}
+
+std::span<const Track> ByteTracker::Predict() {
+    ++stats_.frames;
+    ++frames_since_detection_;
+    PredictEntries();
+    std::erase_if(entries_, [this](const Entry& entry) {
+        return entry.track.state == TrackState::Lost && entry.track.frames_since_match > config_.max_lost_frames;
+    });
+    Publish();
+    return output_;
+}
+
+bool ByteTracker::NeedsDetection() const {
+    const u32 next = frames_since_detection_ + 1;
+    if (stats_.detected_frames == 0 || next >= config_.max_interval) return true;
+
+    bool unsettled = births_pending_;
+    for (const auto& entry : entries_) {
+        const auto& track = entry.track;
+        if (track.state != TrackState::Tracked) {
+            unsettled = true;
+        } else if (track.confidence * config_.confidence_decay < config_.min_confidence) {
+            return true;
+        }
+    }
+    return unsettled && next >= config_.new_object_interval;
+}
+
+void ByteTracker::Publish() {
+    output_.clear();
+    for (const auto& entry : entries_) {
+        if (entry.track.state == TrackState::Tracked) output_.push_back(entry.track);
+    }
+}
+
+} // namespace atom::models
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "../detection/yolo/yolov8_postprocess.hpp"
+
+namespace atom::models {
+
+struct TrackerConfig {
+    // Association (ByteTrack): confident detections are matched first, the
+    // low-scored ones only to tracks left over, and only confident ones start tracks
+    atom::core::f32 high_threshold{0.5f};
+    atom::core::f32 low_threshold{0.1f};
+    atom::core::f32 new_track_threshold{0.6f};
+    atom::core::f32 match_iou{0.3f};
+    bool class_aware{true};                     // match only boxes of the same class
+    atom::core::u32 min_hits{2};                // matches before a new track is reported
+    atom::core::u32 max_lost_frames{30};        // frames a track survives unmatched
+
+    // Frame skipping: detection runs at least every max_interval frames,
+    // sooner when a track's confidence decays below min_confidence, and every
+    // new_object_interval frames while tracks are new or lost. 1 = every frame.
+    atom::core::u32 max_interval{1};
+    atom::core::u32 new_object_interval{2};
+    atom::core::f32 min_confidence{0.3f};
+    atom::core::f32 confidence_decay{0.9f};     // per frame without a detection
+};
+
+enum class TrackState : atom::core::u8 {
+    Tentative,      // too few matches yet
+    Tracked,
+    Lost            // unmatched, kept for re-identification
+};
+
+struct Track {
+    atom::core::u64 id;
+    Detection box;                               // last estimate; score is the latest detection's
+    TrackState state;
+    atom::core::f32 confidence;                  // detection score decayed since the last match
+    atom::core::u32 hits;
+    atom::core::u32 frames_since_match;
+};
+
+struct TrackerStats {
+    atom::core::u64 frames{0};
+    atom::core::u64 detected_frames{0};
+    atom::core::u64 tracks_started{0};
+
+    double DetectionRate() const {
+        return frames == 0 ? 0.0 : static_cast<double>(detected_frames) / static_cast<double>(frames);
+    }
+};
+
+// Multi-object tracker in the ByteTrack style for one stream. Each track
+// carries a constant-velocity Kalman filter per box coordinate (center,
+// size); detections are associated by greedy IoU against the predicted
+// boxes. In between detections, Predict() moves tracks by their velocity
+// alone, so the detector can run only on the frames NeedsDetection() asks
+// for while IDs stay stable. Buffers are reused; steady-state calls do not
+// allocate. Not thread-safe: use one tracker per stream.
+class ByteTracker {
+public:
+    explicit ByteTracker(TrackerConfig config = {});
+
+    // Frame with detections
+    std::span<const Track> Update(std::span<const Detection> detections);
+    // Frame without detections: motion prediction only
+    std::span<const Track> Predict();
+
+    // Whether the next frame should be detected
+    bool NeedsDetection() const;
+
+    // Confirmed tracks (Tracked state) as of the last frame
+    std::span<const Track> GetTracks() const { return output_; }
+
+    void Reset();
+
+    const TrackerConfig& GetConfig() const { return config_; }
+    const TrackerStats& GetStats() const { return stats_; }
+
+private:
+    // Position and velocity of one coordinate with its 2x2 covariance
+    struct KalmanAxis {
+        atom::core::f32 x, v;
+        atom::core::f32 p00, p01, p11;
+    };
+
+    struct Entry {
+        Track track;
+        KalmanAxis axes[4];                      // cx, cy, w, h
+    };
+
+    struct Match {
+        atom::core::f32 iou;
+        atom::core::u32 entry;
+        atom::core::u32 detection;
+    };
+
+    TrackerConfig config_;
+    TrackerStats stats_;
+    atom::core::u64 next_id_{1};
+    atom::core::u32 frames_since_detection_{0};
+    bool births_pending_{false};
+
+    std::vector<Entry> entries_;
+    std::vector<Track> output_;
+    std::vector<Match> matches_;
+    std::vector<atom::core::u8> entry_matched_;
+    std::vector<atom::core::u8> detection_matched_;
+
+    void PredictEntries();
+    void Associate(std::span<const Detection> detections, atom::core::f32 min_score,
+                   atom::core::f32 max_score, bool lost_too);
+    void Correct(Entry& entry, const Detection& detection) const;
+    void Start(const Detection& detection);
+    void Publish();
+};
+
+} // namespace atom::models
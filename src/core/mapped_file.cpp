@@ -0,0 +1,64 @@
+#include "atom/core/mapped_file.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+namespace atom::core {
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+Result<MappedFile> MappedFile::Open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return std::unexpected(ATOM_ERROR(ErrorCode::InvalidArgument,
+            "Cannot open " + path + ": " + std::strerror(errno)));
+    }
+    
+    struct stat info{};
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return std::unexpected(ATOM_ERROR(ErrorCode::InvalidArgument,
+            "Cannot map empty or unreadable file: " + path));
+    }
+    
+    void* data = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // the mapping keeps its own reference
+    if (data == MAP_FAILED) {
+        return std::unexpected(ATOM_ERROR(ErrorCode::OutOfMemory,
+            "mmap failed for " + path + ": " + std::strerror(errno)));
+    }
+    
+    MappedFile file;
+    file.data_ = static_cast<const byte_t*>(data);
+    file.size_ = static_cast<size_t>(info.st_size);
+    return file;
+}
+
+void MappedFile::Close() {
+    if (data_) {
+        ::munmap(const_cast<byte_t*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+} // namespace atom::core
@@ -0,0 +1,226 @@
+#include "atom/core/numa.hpp"
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace atom::core {
+
+namespace {
+
+// From <numaif.h>, which needs libnuma's headers
+constexpr int kMpolPreferred = 1;
+constexpr int kMpolFNode = 1;
+constexpr int kMpolFAddr = 2;
+constexpr size_t kMaxNodes = 1024;
+
+// Set by PinCurrentThread
+thread_local int t_home_node = -1;
+
+// "0-3,8,10-11"
+std::vector<int> ParseCpuList(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream stream(text);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        const char* begin = range.c_str();
+        char* end = nullptr;
+        const int first = static_cast<int>(std::strtol(begin, &end, 10));
+        if (end == begin) continue;
+        int last = first;
+        if (*end == '-') {
+            last = static_cast<int>(std::strtol(end + 1, nullptr, 10));
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+std::vector<int> AllowedCpus() {
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+        }
+    }
+    if (cpus.empty()) {
+        const int count = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        for (int cpu = 0; cpu < count; ++cpu) cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+} // namespace
+
+const NumaTopology& NumaTopology::Instance() {
+    static const NumaTopology topology = Detect();
+    return topology;
+}
+
+NumaTopology NumaTopology::Detect(const std::string& sysfs_root) {
+    const std::vector<int> allowed = AllowedCpus();
+    NumaTopology topology;
+
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(sysfs_root, ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name.size() <= 4 || name.compare(0, 4, "node") != 0 ||
+            !std::all_of(name.begin() + 4, name.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+            continue;
+        }
+
+        std::ifstream file(entry.path() / "cpulist");
+        std::string list;
+        if (!std::getline(file, list)) continue;
+
+        // Memory-only nodes and nodes outside our cpuset have no usable CPUs
+        NumaNode node{std::stoi(name.substr(4)), {}};
+        for (int cpu : ParseCpuList(list)) {
+            if (std::binary_search(allowed.begin(), allowed.end(), cpu)) {
+                node.cpus.push_back(cpu);
+            }
+        }
+        if (!node.cpus.empty()) {
+            topology.nodes_.push_back(std::move(node));
+        }
+    }
+
+    if (topology.nodes_.empty()) {
+        topology.nodes_.push_back(NumaNode{0, allowed});
+    }
+    std::sort(topology.nodes_.begin(), topology.nodes_.end(),
+        [](const NumaNode& a, const NumaNode& b) { return a.id < b.id; });
+
+    for (const auto& node : topology.nodes_) {
+        for (int cpu : node.cpus) {
+            if (static_cast<size_t>(cpu) >= topology.cpu_to_node_.size()) {
+                topology.cpu_to_node_.resize(cpu + 1, -1);
+            }
+            topology.cpu_to_node_[cpu] = node.id;
+        }
+    }
+    return topology;
+}
+
+size_t NumaTopology::GetCpuCount() const {
+    size_t count = 0;
+    for (const auto& node : nodes_) count += node.cpus.size();
+    return count;
+}
+
+int NumaTopology::NodeOfCpu(int cpu) const {
+    if (cpu < 0 || static_cast<size_t>(cpu) >= cpu_to_node_.size()) return -1;
+    return cpu_to_node_[cpu];
+}
+
+std::vector<WorkerPlacement> NumaTopology::PlaceWorkers(size_t count, AffinityPolicy policy, int node) const {
+    std::vector<WorkerPlacement> placements(count);
+    if (policy == AffinityPolicy::None || count == 0) return placements;
+
+    std::vector<const NumaNode*> candidates;
+    for (const auto& candidate : nodes_) {
+        if (node < 0 || candidate.id == node) candidates.push_back(&candidate);
+    }
+    if (candidates.empty()) {
+        for (const auto& candidate : nodes_) candidates.push_back(&candidate);
+    }
+
+    if (policy == AffinityPolicy::NumaNode) {
+        // Shares by CPU count, the remainder to the first nodes
+        size_t total = 0;
+        for (const auto* candidate : candidates) total += candidate->cpus.size();
+        std::vector<size_t> shares;
+        size_t assigned = 0;
+        for (const auto* candidate : candidates) {
+            shares.push_back(count * candidate->cpus.size() / total);
+            assigned += shares.back();
+        }
+        for (size_t i = 0; assigned < count; i = (i + 1) % shares.size(), ++assigned) {
+            shares[i]++;
+        }
+
+        size_t worker = 0;
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            for (size_t n = 0; n < shares[i]; ++n, ++worker) {
+                placements[worker] = WorkerPlacement{candidates[i]->id, candidates[i]->cpus};
+            }
+        }
+        return placements;
+    }
+
+    // Core: CPUs in node order, wrapping when there are more workers
+    std::vector<std::pair<int, int>> cpus;
+    for (const auto* candidate : candidates) {
+        for (int cpu : candidate->cpus) cpus.emplace_back(candidate->id, cpu);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        const auto& [id, cpu] = cpus[i % cpus.size()];
+        placements[i] = WorkerPlacement{id, {cpu}};
+    }
+    std::stable_sort(placements.begin(), placements.end(),
+        [](const WorkerPlacement& a, const WorkerPlacement& b) { return a.node < b.node; });
+    return placements;
+}
+
+Result<void> PinCurrentThread(const WorkerPlacement& placement) {
+    if (placement.cpus.empty()) return {};
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : placement.cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+    }
+    const int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (err != 0) {
+        return std::unexpected(ATOM_ERROR(ErrorCode::InvalidArgument,
+            "Failed to set thread affinity: " + std::string(std::strerror(err))));
+    }
+    t_home_node = placement.node;
+    return {};
+}
+
+int CurrentNumaNode() {
+    if (t_home_node >= 0) return t_home_node;
+    const auto& topology = NumaTopology::Instance();
+    if (!topology.IsNuma()) return topology.GetNodes().front().id;
+    const int node = topology.NodeOfCpu(sched_getcpu());
+    return node >= 0 ? node : topology.GetNodes().front().id;
+}
+
+int NumaNodeOfAddress(const void* addr) {
+    if (!addr) return -1;
+    int node = -1;
+    if (syscall(SYS_get_mempolicy, &node, nullptr, 0, const_cast<void*>(addr), kMpolFNode | kMpolFAddr) != 0) {
+        return -1;
+    }
+    return node;
+}
+
+void* AllocateOnNode(size_t bytes, int node) {
+    const auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t size = std::max<size_t>((bytes + page - 1) / page * page, page);
+    if (node < 0 || static_cast<size_t>(node) + 1 >= kMaxNodes) return std::malloc(bytes);
+
+    void* data = std::aligned_alloc(page, size);
+    if (!data) return nullptr;
+
+    // Preferred rather than bound: a full node spills instead of failing.
+    // Pages already touched (reused heap memory) keep their placement.
+    unsigned long mask[kMaxNodes / (8 * sizeof(unsigned long))] = {};
+    mask[node / (8 * sizeof(unsigned long))] = 1ul << (node % (8 * sizeof(unsigned long)));
+    syscall(SYS_mbind, data, size, kMpolPreferred, mask, kMaxNodes, 0);
+    return data;
+}
+
+} // namespace atom::core
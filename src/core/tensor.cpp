@@ -1,9 +1,19 @@
 #include "atom/core/tensor.hpp"
+#include "atom/core/numa.hpp"
+#include <algorithm>
 #include <cstring>
 #include <stdexcept>
 
 namespace atom::core {
 
+namespace {
+
+// Smaller buffers come from the allocating thread's malloc arena, which
+// first touch already keeps on its node
+constexpr size_t kNodeLocalThreshold = 64 * 1024;
+
+} // namespace
+
 Tensor::Tensor(Shape shape, DataType dtype, DeviceInfo device)
     : shape_(std::move(shape)), dtype_(dtype), device_(device), owns_data_(true) {
     size_ = ComputeSize(shape_);
@@ -113,7 +123,13 @@ Result<void> Tensor::Allocate() {
     const size_t byte_size = GetByteSize();
     
     if (device_.type == DeviceType::CPU) {
-        data_ = std::malloc(byte_size);
+        // On a NUMA machine large buffers go to the allocating thread's node,
+        // which for pinned scheduler and pipeline workers is their own
+        if (byte_size >= kNodeLocalThreshold && NumaTopology::Instance().IsNuma()) {
+            data_ = AllocateOnNode(byte_size, CurrentNumaNode());
+        } else {
+            data_ = std::malloc(byte_size);
+        }
         if (!data_) {
             return std::unexpected(ATOM_ERROR(ErrorCode::OutOfMemory, 
                 "Failed to allocate CPU memory"));
@@ -238,4 +254,98 @@ Result<void> Tensor::Reshape(Shape new_shape) {
     return {};
 }
 
+namespace {
+
+Result<void> CopyBytes(void* dst, const void* src, size_t bytes, DeviceInfo dst_device, DeviceInfo src_device) {
+    if (dst_device.type == DeviceType::CPU && src_device.type == DeviceType::CPU) {
+        std::memcpy(dst, src, bytes);
+        return {};
+    }
+    
+    cudaError_t err = cudaMemcpy(dst, src, bytes, cudaMemcpyDefault);
+    if (err != cudaSuccess) {
+        return std::unexpected(ATOM_ERROR(ErrorCode::CudaError, 
+            "CUDA copy failed: " + std::string(cudaGetErrorString(err))));
+    }
+    return {};
+}
+
+} // namespace
+
+Result<Tensor> Tensor::ConcatBatch(std::span<const Tensor* const> tensors) {
+    if (tensors.empty()) {
+        return std::unexpected(ATOM_ERROR(ErrorCode::InvalidArgument, 
+            "ConcatBatch requires at least one tensor"));
+    }
+    
+    const Tensor& first = *tensors.front();
+    if (first.shape_.empty()) {
+        return std::unexpected(ATOM_ERROR(ErrorCode::InvalidArgument, 
+            "ConcatBatch requires tensors with a batch dimension"));
+    }
+    
+    i64 total_batch = 0;
+    for (const Tensor* tensor : tensors) {
+        if (tensor->dtype_ != first.dtype_ || !(tensor->device_ == first.device_) ||
+            tensor->shape_.size() != first.shape_.size() ||
+            !std::equal(tensor->shape_.begin() + 1, tensor->shape_.end(), first.shape_.begin() + 1)) {
+            return std::unexpected(ATOM_ERROR(ErrorCode::InvalidArgument, 
+                "ConcatBatch tensors are not compatible"));
+        }
+        total_batch += tensor->shape_[0];
+    }
+    
+    Shape shape = first.shape_;
+    shape[0] = total_batch;
+    auto result = Create(std::move(shape), first.dtype_, first.device_);
+    if (!result) return std::unexpected(result.error());
+    
+    auto* dst = static_cast<byte_t*>(result->data_);
+    for (const Tensor* tensor : tensors) {
+        const size_t bytes = tensor->GetByteSize();
+        auto copied = CopyBytes(dst, tensor->data_, bytes, first.device_, tensor->device_);
+        if (!copied) return std::unexpected(copied.error());
+        dst += bytes;
+    }
+    
+    return result;
+}
+
+Result<std::vector<Tensor>> Tensor::SplitBatch(std::span<const i64> batch_sizes) const {
+    if (shape_.empty()) {
+        return std::unexpected(ATOM_ERROR(ErrorCode::InvalidArgument, 
+            "SplitBatch requires a batch dimension"));
+    }
+    
+    i64 total_batch = 0;
+    for (i64 batch : batch_sizes) {
+        total_batch += batch;
+    }
+    if (total_batch != shape_[0]) {
+        return std::unexpected(ATOM_ERROR(ErrorCode::InvalidArgument, 
+            "SplitBatch sizes do not sum to the batch dimension"));
+    }
+    
+    const size_t item_bytes = shape_[0] > 0 ? GetByteSize() / shape_[0] : 0;
+    const auto* src = static_cast<const byte_t*>(data_);
+    
+    std::vector<Tensor> parts;
+    parts.reserve(batch_sizes.size());
+    for (i64 batch : batch_sizes) {
+        Shape shape = shape_;
+        shape[0] = batch;
+        auto part = Create(std::move(shape), dtype_, device_);
+        if (!part) return std::unexpected(part.error());
+        
+        const size_t bytes = item_bytes * batch;
+        auto copied = CopyBytes(part->data_, src, bytes, device_, device_);
+        if (!copied) return std::unexpected(copied.error());
+        src += bytes;
+        
+        parts.push_back(std::move(*part));
+    }
+    
+    return parts;
+}
+
 } // namespace atom::core
@@ -0,0 +1,715 @@
+#include "atom/data/embedding_index.hpp"
+#include "atom/inference/cpu/binary_io.hpp"
+#include "atom/inference/cpu/kernels.hpp"
+#include "atom/inference/cpu/parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <mutex>
+#include <utility>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define ATOM_X86_KERNELS 1
+#endif
+
+namespace atom::data {
+
+using atom::core::byte_t;
+using atom::core::f32;
+using atom::core::i16;
+using atom::core::i32;
+using atom::core::i64;
+using atom::core::i8;
+using atom::core::u32;
+using atom::core::u64;
+
+namespace {
+
+constexpr char kIndexMagic[8] = {'A', 'T', 'O', 'M', 'E', 'M', 'B', 'D'};
+constexpr u32 kIndexVersion = 1;
+constexpr u64 kSectionAlignment = 4096;   // bytes; rows start on a page
+constexpr i64 kRowAlignment = 64;         // elements; whole SIMD registers, no tails
+constexpr i64 kScanBlock = 64;            // rows scored against every query of a batch at once
+constexpr size_t kRowsPerTask = 4096;
+
+struct IndexHeader {
+    char magic[8];
+    u32 version;
+    u32 storage;              // DataType
+    u32 metric;
+    u32 partitions;           // 0 = untrained
+    i64 dimension;
+    i64 padded;
+    u64 count;
+    u64 rows_offset;
+    u64 scales_offset;
+    u64 ids_offset;
+    u64 centroids_offset;
+    u64 lists_offset;         // partitions + 1 offsets, then the row numbers
+    u64 file_size;
+};
+
+u64 AlignUp(u64 value, u64 alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+atom::core::Error IndexError(const std::string& what) {
+    return ATOM_ERROR(atom::core::ErrorCode::InvalidArgument, what);
+}
+
+// --- dot products over padded rows ---
+
+f32 DotF32(const f32* a, const f32* b, i64 n) {
+    f32 sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (i64 i = 0; i < n; i += 4) {
+        for (int j = 0; j < 4; ++j) sum[j] += a[i + j] * b[i + j];
+    }
+    return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+i32 DotI8(const i16* query, const i8* row, i64 n) {
+    i32 sum = 0;
+    for (i64 i = 0; i < n; ++i) sum += static_cast<i32>(query[i]) * row[i];
+    return sum;
+}
+
+#ifdef ATOM_X86_KERNELS
+__attribute__((target("avx2,fma")))
+f32 DotF32Avx2(const f32* a, const f32* b, i64 n) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps();
+    __m256 acc3 = _mm256_setzero_ps();
+    for (i64 i = 0; i < n; i += 32) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+        acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16), acc2);
+        acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24), acc3);
+    }
+    const __m256 acc = _mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3));
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+    return _mm_cvtss_f32(sum);
+}
+
+__attribute__((target("avx2")))
+i32 DotI8Avx2(const i16* query, const i8* row, i64 n) {
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    for (i64 i = 0; i < n; i += 32) {
+        const __m256i r0 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i)));
+        const __m256i r1 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i + 16)));
+        acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(r0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(query + i))));
+        acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(r1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(query + i + 16))));
+    }
+    const __m256i acc = _mm256_add_epi32(acc0, acc1);
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4e));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xb1));
+    return _mm_cvtsi128_si32(sum);
+}
+
+__attribute__((target("avx512f")))
+f32 DotF32Avx512(const f32* a, const f32* b, i64 n) {
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    for (i64 i = 0; i < n; i += 32) {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+        acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), acc1);
+    }
+    return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+}
+
+__attribute__((target("avx512f,avx512bw,avx512vnni")))
+i32 DotI8Vnni(const i16* query, const i8* row, i64 n) {
+    __m512i acc0 = _mm512_setzero_si512();
+    __m512i acc1 = _mm512_setzero_si512();
+    for (i64 i = 0; i < n; i += 64) {
+        const __m512i r0 = _mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i)));
+        const __m512i r1 = _mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i + 32)));
+        acc0 = _mm512_dpwssd_epi32(acc0, r0, _mm512_loadu_si512(query + i));
+        acc1 = _mm512_dpwssd_epi32(acc1, r1, _mm512_loadu_si512(query + i + 32));
+    }
+    return _mm512_reduce_add_epi32(_mm512_add_epi32(acc0, acc1));
+}
+#endif
+
+struct Kernels {
+    f32 (*dot_f32)(const f32*, const f32*, i64) = DotF32;
+    i32 (*dot_i8)(const i16*, const i8*, i64) = DotI8;
+};
+
+const Kernels& SelectKernels() {
+    static const Kernels kernels = [] {
+        Kernels k;
+#ifdef ATOM_X86_KERNELS
+        using atom::inference::cpu::kernels::CpuIsa;
+        const CpuIsa isa = atom::inference::cpu::kernels::DetectCpuIsa();
+        if (isa >= CpuIsa::Avx2) {
+            k.dot_f32 = DotF32Avx2;
+            k.dot_i8 = DotI8Avx2;
+        }
+        if (atom::inference::cpu::kernels::HasAvx512F()) {
+            k.dot_f32 = DotF32Avx512;
+        }
+        if (isa >= CpuIsa::Avx512Vnni) {
+            k.dot_i8 = DotI8Vnni;
+        }
+#endif
+        return k;
+    }();
+    return kernels;
+}
+
+// --- top-k ---
+
+struct Candidate {
+    f32 score;
+    u32 row;
+};
+
+// Min-heap of the best k seen so far
+class TopK {
+public:
+    void Reset(size_t k) {
+        k_ = k;
+        heap_.clear();
+        heap_.reserve(k);
+    }
+
+    void Push(f32 score, u32 row) {
+        if (heap_.size() < k_) {
+            heap_.push_back({score, row});
+            std::push_heap(heap_.begin(), heap_.end(), Worse);
+        } else if (score > heap_.front().score) {
+            std::pop_heap(heap_.begin(), heap_.end(), Worse);
+            heap_.back() = {score, row};
+            std::push_heap(heap_.begin(), heap_.end(), Worse);
+        }
+    }
+
+    const std::vector<Candidate>& Items() const { return heap_; }
+
+private:
+    static bool Worse(const Candidate& a, const Candidate& b) { return a.score > b.score; }
+
+    size_t k_{0};
+    std::vector<Candidate> heap_;
+};
+
+// Rows of one Add or one search batch as float rows of `dimension`
+atom::core::Result<i64> RowCount(const atom::core::Tensor& tensor, i64& dimension) {
+    if (tensor.GetDataType() != atom::core::DataType::Float32 ||
+        tensor.GetDevice().type != atom::core::DeviceType::CPU) {
+        return std::unexpected(IndexError("Embeddings must be float32 tensors on the CPU"));
+    }
+    const auto& shape = tensor.GetShape();
+    if (shape.empty()) return std::unexpected(IndexError("Embeddings need a batch dimension"));
+    i64 features = 1;
+    for (size_t i = 1; i < shape.size(); ++i) features *= shape[i];
+    if (dimension == 0) dimension = features;
+    if (features != dimension || dimension <= 0) {
+        return std::unexpected(IndexError("Embedding size " + std::to_string(features) +
+                                          " does not match the index dimension " + std::to_string(dimension)));
+    }
+    return shape[0];
+}
+
+} // namespace
+
+EmbeddingIndex::EmbeddingIndex(EmbeddingIndexConfig config) : config_(config) {
+    if (config_.dimension > 0) padded_ = (config_.dimension + kRowAlignment - 1) / kRowAlignment * kRowAlignment;
+}
+
+EmbeddingIndex::EmbeddingIndex(EmbeddingIndex&& other) noexcept {
+    *this = std::move(other);
+}
+
+EmbeddingIndex& EmbeddingIndex::operator=(EmbeddingIndex&& other) noexcept {
+    if (this == &other) return *this;
+    config_ = other.config_;
+    padded_ = other.padded_;
+    count_ = std::exchange(other.count_, 0);
+    owned_rows_ = std::move(other.owned_rows_);
+    owned_scales_ = std::move(other.owned_scales_);
+    owned_ids_ = std::move(other.owned_ids_);
+    mapping_ = std::move(other.mapping_);
+    rows_ = std::exchange(other.rows_, nullptr);
+    scales_ = std::exchange(other.scales_, nullptr);
+    ids_ = std::exchange(other.ids_, nullptr);
+    centroids_ = std::move(other.centroids_);
+    lists_ = std::move(other.lists_);
+    return *this;
+}
+
+size_t EmbeddingIndex::RowBytes() const {
+    return static_cast<size_t>(padded_) * atom::core::DataTypeSize(config_.storage);
+}
+
+size_t EmbeddingIndex::GetMemoryUsage() const {
+    size_t lists = 0;
+    for (const auto& list : lists_) lists += list.size() * sizeof(u32);
+    return owned_rows_.size() + owned_scales_.size() * sizeof(f32) + owned_ids_.size() * sizeof(u64) +
+           centroids_.size() * sizeof(f32) + lists;
+}
+
+void EmbeddingIndex::Materialize() {
+    if (!mapping_.IsOpen()) return;
+    owned_rows_.assign(rows_, rows_ + count_ * RowBytes());
+    owned_scales_.assign(scales_, scales_ + count_);
+    owned_ids_.assign(ids_, ids_ + count_);
+    mapping_.Close();
+    rows_ = owned_rows_.data();
+    scales_ = owned_scales_.data();
+    ids_ = owned_ids_.data();
+}
+
+void EmbeddingIndex::Append(const f32* vector, u64 id) {
+    std::vector<f32> row(static_cast<size_t>(padded_), 0.0f);
+    std::copy(vector, vector + config_.dimension, row.begin());
+    if (config_.metric == EmbeddingMetric::Cosine) {
+        const f32 norm = std::sqrt(SelectKernels().dot_f32(row.data(), row.data(), padded_));
+        if (norm > 0.0f) {
+            for (auto& v : row) v /= norm;
+        }
+    }
+
+    const size_t offset = owned_rows_.size();
+    owned_rows_.resize(offset + RowBytes());
+    f32 scale = 1.0f;
+    if (config_.storage == atom::core::DataType::Int8) {
+        f32 peak = 0.0f;
+        for (const f32 v : row) peak = std::max(peak, std::fabs(v));
+        scale = peak > 0.0f ? peak / 127.0f : 1.0f;
+        auto* codes = reinterpret_cast<i8*>(owned_rows_.data() + offset);
+        for (i64 i = 0; i < padded_; ++i) codes[i] = static_cast<i8>(std::lround(row[i] / scale));
+    } else {
+        std::memcpy(owned_rows_.data() + offset, row.data(), RowBytes());
+    }
+    owned_scales_.push_back(scale);
+    owned_ids_.push_back(id);
+
+    rows_ = owned_rows_.data();
+    scales_ = owned_scales_.data();
+    ids_ = owned_ids_.data();
+    if (IsTrained()) {
+        lists_[NearestPartition(row.data())].push_back(static_cast<u32>(count_));
+    }
+    ++count_;
+}
+
+atom::core::Result<void> EmbeddingIndex::Add(const atom::core::Tensor& embeddings, std::span<const u64> ids) {
+    std::unique_lock lock(mutex_);
+    if (config_.storage != atom::core::DataType::Float32 && config_.storage != atom::core::DataType::Int8) {
+        return std::unexpected(IndexError("Embedding storage must be Float32 or Int8"));
+    }
+    i64 dimension = config_.dimension;
+    auto rows = RowCount(embeddings, dimension);
+    if (!rows) return std::unexpected(rows.error());
+    if (!ids.empty() && static_cast<i64>(ids.size()) != *rows) {
+        return std::unexpected(IndexError("Need one id per embedding"));
+    }
+    if (count_ + static_cast<size_t>(*rows) > std::numeric_limits<u32>::max()) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::OutOfMemory, "Embedding index is full"));
+    }
+    if (config_.dimension == 0) {
+        config_.dimension = dimension;
+        padded_ = (dimension + kRowAlignment - 1) / kRowAlignment * kRowAlignment;
+    }
+
+    Materialize();
+    owned_rows_.reserve(owned_rows_.size() + static_cast<size_t>(*rows) * RowBytes());
+    const auto* data = static_cast<const f32*>(embeddings.GetData());
+    for (i64 r = 0; r < *rows; ++r) {
+        Append(data + r * dimension, ids.empty() ? count_ : ids[r]);
+    }
+    return {};
+}
+
+atom::core::Result<void> EmbeddingIndex::Add(std::span<const f32> embedding, u64 id) {
+    auto tensor = atom::core::Tensor::Create({1, static_cast<i64>(embedding.size())}, atom::core::DataType::Float32);
+    if (!tensor) return std::unexpected(tensor.error());
+    std::copy(embedding.begin(), embedding.end(), static_cast<f32*>(tensor->GetData()));
+    return Add(*tensor, std::span<const u64>(&id, 1));
+}
+
+u32 EmbeddingIndex::NearestPartition(const f32* padded) const {
+    const auto dot = SelectKernels().dot_f32;
+    u32 best = 0;
+    f32 best_score = -std::numeric_limits<f32>::infinity();
+    for (u32 p = 0; p < lists_.size(); ++p) {
+        const f32 score = dot(padded, centroids_.data() + p * padded_, padded_);
+        if (score > best_score) {
+            best_score = score;
+            best = p;
+        }
+    }
+    return best;
+}
+
+atom::core::Result<void> EmbeddingIndex::Train() {
+    std::unique_lock lock(mutex_);
+    const size_t partitions = config_.partitions;
+    if (partitions == 0) return std::unexpected(IndexError("IVF training needs partitions > 0"));
+    if (count_ < partitions) {
+        return std::unexpected(IndexError("IVF training needs at least one vector per partition"));
+    }
+
+    const auto& kernels = SelectKernels();
+    const size_t row_bytes = RowBytes();
+    const auto decode = [&](size_t row, f32* out) {
+        const byte_t* data = rows_ + row * row_bytes;
+        if (config_.storage == atom::core::DataType::Int8) {
+            const auto* codes = reinterpret_cast<const i8*>(data);
+            for (i64 i = 0; i < padded_; ++i) out[i] = codes[i] * scales_[row];
+        } else {
+            std::memcpy(out, data, row_bytes);
+        }
+    };
+
+    // K-means on an even sample, assigning by largest dot product as search
+    // probes do; centroids are means, renormalized for Cosine (spherical
+    // k-means) and left as is for InnerProduct
+    const size_t samples = std::min(count_, partitions * std::max<size_t>(config_.training_samples, 1));
+    std::vector<f32> sample(samples * padded_);
+    for (size_t s = 0; s < samples; ++s) decode(s * count_ / samples, &sample[s * padded_]);
+
+    std::vector<f32> centroids(partitions * padded_);
+    for (size_t p = 0; p < partitions; ++p) {
+        std::copy_n(&sample[(p * samples / partitions) * padded_], padded_, &centroids[p * padded_]);
+    }
+
+    auto parallel = atom::inference::cpu::Parallel(atom::inference::cpu::ComputePool(),
+                                                   atom::inference::cpu::ComputeThreadCount());
+    const auto nearest = [&](const f32* vector) {
+        u32 best = 0;
+        f32 best_score = -std::numeric_limits<f32>::infinity();
+        for (u32 p = 0; p < partitions; ++p) {
+            const f32 score = kernels.dot_f32(vector, &centroids[p * padded_], padded_);
+            if (score > best_score) {
+                best_score = score;
+                best = p;
+            }
+        }
+        return best;
+    };
+
+    std::vector<u32> assignment(samples);
+    std::vector<f32> sums(partitions * padded_);
+    std::vector<size_t> sizes(partitions);
+    for (u32 iteration = 0; iteration < config_.training_iterations; ++iteration) {
+        parallel.For(static_cast<i64>(samples), 64, [&](i64 begin, i64 end) {
+            for (i64 s = begin; s < end; ++s) assignment[s] = nearest(&sample[s * padded_]);
+        });
+        std::fill(sums.begin(), sums.end(), 0.0f);
+        std::fill(sizes.begin(), sizes.end(), 0);
+        for (size_t s = 0; s < samples; ++s) {
+            f32* sum = &sums[assignment[s] * padded_];
+            const f32* vector = &sample[s * padded_];
+            for (i64 i = 0; i < padded_; ++i) sum[i] += vector[i];
+            ++sizes[assignment[s]];
+        }
+        for (size_t p = 0; p < partitions; ++p) {
+            if (sizes[p] == 0) continue;   // empty cluster keeps its centroid
+            f32* centroid = &centroids[p * padded_];
+            const f32* sum = &sums[p * padded_];
+            f32 norm = 0.0f;
+            for (i64 i = 0; i < padded_; ++i) {
+                centroid[i] = sum[i] / static_cast<f32>(sizes[p]);
+                norm += centroid[i] * centroid[i];
+            }
+            if (config_.metric == EmbeddingMetric::Cosine && norm > 0.0f) {
+                const f32 inverse = 1.0f / std::sqrt(norm);
+                for (i64 i = 0; i < padded_; ++i) centroid[i] *= inverse;
+            }
+        }
+    }
+
+    // Assign every stored vector
+    std::vector<u32> rows(count_);
+    parallel.For(static_cast<i64>(count_), 256, [&](i64 begin, i64 end) {
+        std::vector<f32> vector(padded_);
+        for (i64 r = begin; r < end; ++r) {
+            decode(r, vector.data());
+            rows[r] = nearest(vector.data());
+        }
+    });
+
+    centroids_ = std::move(centroids);
+    lists_.assign(partitions, {});
+    for (size_t r = 0; r < count_; ++r) lists_[rows[r]].push_back(static_cast<u32>(r));
+    return {};
+}
+
+void EmbeddingIndex::PrepareQuery(const f32* query, f32* padded, i16* codes, f32& scale) const {
+    std::fill(padded, padded + padded_, 0.0f);
+    std::copy(query, query + config_.dimension, padded);
+    if (config_.metric == EmbeddingMetric::Cosine) {
+        const f32 norm = std::sqrt(SelectKernels().dot_f32(padded, padded, padded_));
+        if (norm > 0.0f) {
+            for (i64 i = 0; i < padded_; ++i) padded[i] /= norm;
+        }
+    }
+    scale = 1.0f;
+    if (config_.storage == atom::core::DataType::Int8) {
+        f32 peak = 0.0f;
+        for (i64 i = 0; i < padded_; ++i) peak = std::max(peak, std::fabs(padded[i]));
+        scale = peak > 0.0f ? peak / 127.0f : 1.0f;
+        for (i64 i = 0; i < padded_; ++i) codes[i] = static_cast<i16>(std::lround(padded[i] / scale));
+    }
+}
+
+atom::core::Result<void> EmbeddingIndex::Search(const atom::core::Tensor& queries, size_t k,
+                                                std::vector<SearchHit>& hits) const {
+    std::shared_lock lock(mutex_);
+    i64 dimension = config_.dimension;
+    if (dimension == 0) return std::unexpected(IndexError("Embedding index is empty"));
+    auto count = RowCount(queries, dimension);
+    if (!count) return std::unexpected(count.error());
+    if (k == 0) return std::unexpected(IndexError("Search needs k > 0"));
+
+    const size_t query_count = static_cast<size_t>(*count);
+    const bool int8 = config_.storage == atom::core::DataType::Int8;
+    std::vector<f32> padded(query_count * padded_);
+    std::vector<i16> codes(int8 ? query_count * padded_ : 0);
+    std::vector<f32> query_scales(query_count);
+    const auto* data = static_cast<const f32*>(queries.GetData());
+    for (size_t q = 0; q < query_count; ++q) {
+        PrepareQuery(data + q * dimension, &padded[q * padded_], int8 ? &codes[q * padded_] : nullptr,
+                     query_scales[q]);
+    }
+
+    const auto& kernels = SelectKernels();
+    const size_t row_bytes = RowBytes();
+    const auto score = [&](size_t q, u32 row) {
+        const byte_t* data_row = rows_ + static_cast<size_t>(row) * row_bytes;
+        if (int8) {
+            return static_cast<f32>(kernels.dot_i8(&codes[q * padded_], reinterpret_cast<const i8*>(data_row), padded_)) *
+                   scales_[row] * query_scales[q];
+        }
+        return kernels.dot_f32(&padded[q * padded_], reinterpret_cast<const f32*>(data_row), padded_);
+    };
+
+    const auto parallel = atom::inference::cpu::Parallel(atom::inference::cpu::ComputePool(),
+                                                         atom::inference::cpu::ComputeThreadCount());
+
+    // Every task keeps its own heaps per query; they are merged at the end
+    std::vector<std::vector<TopK>> partial;
+    const auto reset = [&](size_t tasks) {
+        partial.resize(tasks);
+        for (auto& heaps : partial) {
+            heaps.resize(query_count);
+            for (auto& heap : heaps) heap.Reset(k);
+        }
+    };
+
+    if (!IsTrained()) {
+        // Exact: rows split across tasks, each block of rows scored against
+        // every query while it is in cache
+        const size_t tasks = std::clamp<size_t>(count_ / kRowsPerTask, 1, parallel.Width());
+        reset(tasks);
+        parallel.For(static_cast<i64>(tasks), 1, [&](i64 begin, i64 end) {
+            for (i64 t = begin; t < end; ++t) {
+                const size_t first = count_ * t / tasks;
+                const size_t last = count_ * (t + 1) / tasks;
+                for (size_t block = first; block < last; block += kScanBlock) {
+                    const size_t block_end = std::min(last, block + kScanBlock);
+                    for (size_t q = 0; q < query_count; ++q) {
+                        auto& heap = partial[t][q];
+                        for (size_t row = block; row < block_end; ++row) {
+                            heap.Push(score(q, static_cast<u32>(row)), static_cast<u32>(row));
+                        }
+                    }
+                }
+            }
+        });
+    } else {
+        // IVF: each query scans the lists of its closest centroids, one task per probe
+        const size_t partitions = lists_.size();
+        const size_t probes = std::clamp<size_t>(config_.probes, 1, partitions);
+        reset(probes);
+        std::vector<Candidate> ranked(partitions);
+        for (size_t q = 0; q < query_count; ++q) {
+            for (u32 p = 0; p < partitions; ++p) {
+                ranked[p] = {kernels.dot_f32(&padded[q * padded_], &centroids_[p * padded_], padded_), p};
+            }
+            std::partial_sort(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(probes), ranked.end(),
+                              [](const Candidate& a, const Candidate& b) { return a.score > b.score; });
+            parallel.For(static_cast<i64>(probes), 1, [&](i64 begin, i64 end) {
+                for (i64 t = begin; t < end; ++t) {
+                    auto& heap = partial[t][q];
+                    for (const u32 row : lists_[ranked[t].row]) heap.Push(score(q, row), row);
+                }
+            });
+        }
+    }
+
+    hits.assign(query_count * k, {~u64{0}, -std::numeric_limits<f32>::infinity()});
+    std::vector<Candidate> merged;
+    for (size_t q = 0; q < query_count; ++q) {
+        merged.clear();
+        for (const auto& heaps : partial) {
+            merged.insert(merged.end(), heaps[q].Items().begin(), heaps[q].Items().end());
+        }
+        const size_t kept = std::min(k, merged.size());
+        std::partial_sort(merged.begin(), merged.begin() + static_cast<std::ptrdiff_t>(kept), merged.end(),
+                          [](const Candidate& a, const Candidate& b) { return a.score > b.score; });
+        for (size_t i = 0; i < kept; ++i) hits[q * k + i] = {ids_[merged[i].row], merged[i].score};
+    }
+    return {};
+}
+
+atom::core::Result<std::vector<SearchHit>> EmbeddingIndex::Search(std::span<const f32> query, size_t k) const {
+    auto tensor = atom::core::Tensor::Create({1, static_cast<i64>(query.size())}, atom::core::DataType::Float32);
+    if (!tensor) return std::unexpected(tensor.error());
+    std::copy(query.begin(), query.end(), static_cast<f32*>(tensor->GetData()));
+
+    std::vector<SearchHit> hits;
+    auto searched = Search(*tensor, k, hits);
+    if (!searched) return std::unexpected(searched.error());
+    std::erase_if(hits, [](const SearchHit& hit) { return hit.id == ~u64{0}; });
+    return hits;
+}
+
+atom::core::Result<void> EmbeddingIndex::Save(const std::string& path) const {
+    std::shared_lock lock(mutex_);
+    const u64 partitions = lists_.size();
+    u64 listed = 0;
+    for (const auto& list : lists_) listed += list.size();
+
+    IndexHeader header{};
+    std::memcpy(header.magic, kIndexMagic, sizeof(kIndexMagic));
+    header.version = kIndexVersion;
+    header.storage = static_cast<u32>(config_.storage);
+    header.metric = static_cast<u32>(config_.metric);
+    header.partitions = static_cast<u32>(partitions);
+    header.dimension = config_.dimension;
+    header.padded = padded_;
+    header.count = count_;
+    header.rows_offset = AlignUp(sizeof(IndexHeader), kSectionAlignment);
+    header.scales_offset = AlignUp(header.rows_offset + count_ * RowBytes(), 64);
+    header.ids_offset = AlignUp(header.scales_offset + count_ * sizeof(f32), 64);
+    header.centroids_offset = AlignUp(header.ids_offset + count_ * sizeof(u64), 64);
+    header.lists_offset = AlignUp(header.centroids_offset + centroids_.size() * sizeof(f32), 64);
+    header.file_size = header.lists_offset + (partitions + (partitions ? 1 : 0) + listed) * sizeof(u32);
+
+    // Write then rename so a concurrent loader never maps a partial file
+    const std::string temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file) return std::unexpected(IndexError("Cannot write embedding index: " + temp_path));
+
+        atom::inference::cpu::BinaryWriter writer(file);
+        const std::vector<char> zeros(kSectionAlignment, 0);
+        u64 written = 0;
+        const auto section = [&](u64 offset, const void* data, u64 size) {
+            writer.WriteBytes(zeros.data(), offset - written);
+            writer.WriteBytes(data, size);
+            written = offset + size;
+        };
+        section(0, &header, sizeof(header));
+        section(header.rows_offset, rows_, count_ * RowBytes());
+        section(header.scales_offset, scales_, count_ * sizeof(f32));
+        section(header.ids_offset, ids_, count_ * sizeof(u64));
+        section(header.centroids_offset, centroids_.data(), centroids_.size() * sizeof(f32));
+        if (partitions > 0) {
+            std::vector<u32> offsets(partitions + 1, 0);
+            for (size_t p = 0; p < partitions; ++p) offsets[p + 1] = offsets[p] + static_cast<u32>(lists_[p].size());
+            section(header.lists_offset, offsets.data(), offsets.size() * sizeof(u32));
+            for (const auto& list : lists_) section(written, list.data(), list.size() * sizeof(u32));
+        }
+
+        if (!writer.Ok()) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::Unknown,
+                "Failed writing embedding index: " + temp_path));
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::Unknown,
+            "Failed to replace embedding index: " + ec.message()));
+    }
+    return {};
+}
+
+atom::core::Result<EmbeddingIndex> EmbeddingIndex::Load(const std::string& path, i64 dimension) {
+    auto mapping = atom::core::MappedFile::Open(path);
+    if (!mapping) return std::unexpected(mapping.error());
+
+    const auto* base = mapping->GetData();
+    const u64 file_size = mapping->GetSize();
+    IndexHeader header{};
+    if (file_size < sizeof(header)) return std::unexpected(IndexError("Truncated embedding index: " + path));
+    std::memcpy(&header, base, sizeof(header));
+
+    if (!std::equal(std::begin(kIndexMagic), std::end(kIndexMagic), header.magic) ||
+        header.version != kIndexVersion) {
+        return std::unexpected(IndexError("Not an embedding index (or unsupported version): " + path));
+    }
+    // Only an empty index is saved before its dimension is known; that one
+    // takes it from the first Add like a new index
+    if (header.dimension < 0 || (header.dimension == 0 && header.count > 0)) {
+        return std::unexpected(IndexError("Corrupt embedding index: " + path));
+    }
+    if (dimension > 0 && header.dimension > 0 && header.dimension != dimension) {
+        return std::unexpected(IndexError("Embedding index " + path + " has dimension " +
+                                          std::to_string(header.dimension) + ", expected " + std::to_string(dimension)));
+    }
+
+    EmbeddingIndexConfig config;
+    config.dimension = header.dimension;
+    config.storage = static_cast<atom::core::DataType>(header.storage);
+    config.metric = static_cast<EmbeddingMetric>(header.metric);
+    config.partitions = header.partitions;
+    EmbeddingIndex index(config);
+
+    const u64 partitions = header.partitions;
+    if (header.file_size != file_size || index.padded_ != header.padded ||
+        (config.storage != atom::core::DataType::Float32 && config.storage != atom::core::DataType::Int8) ||
+        header.rows_offset + header.count * index.RowBytes() > header.scales_offset ||
+        header.scales_offset + header.count * sizeof(f32) > header.ids_offset ||
+        header.ids_offset + header.count * sizeof(u64) > header.centroids_offset ||
+        header.centroids_offset + partitions * header.padded * sizeof(f32) > header.lists_offset ||
+        header.lists_offset > file_size) {
+        return std::unexpected(IndexError("Corrupt embedding index: " + path));
+    }
+
+    // Centroids and lists are small and copied; the rows stay mapped
+    if (partitions > 0) {
+        const auto* centroids = reinterpret_cast<const f32*>(base + header.centroids_offset);
+        index.centroids_.assign(centroids, centroids + partitions * header.padded);
+        std::vector<u32> offsets(partitions + 1);
+        if (header.lists_offset + offsets.size() * sizeof(u32) > file_size) {
+            return std::unexpected(IndexError("Corrupt embedding index: " + path));
+        }
+        std::memcpy(offsets.data(), base + header.lists_offset, offsets.size() * sizeof(u32));
+        const u64 rows_offset = header.lists_offset + offsets.size() * sizeof(u32);
+        if (offsets.back() != header.count || rows_offset + u64{offsets.back()} * sizeof(u32) > file_size) {
+            return std::unexpected(IndexError("Corrupt embedding index: " + path));
+        }
+        const auto* rows = reinterpret_cast<const u32*>(base + rows_offset);
+        index.lists_.resize(partitions);
+        for (size_t p = 0; p < partitions; ++p) {
+            if (offsets[p] > offsets[p + 1]) return std::unexpected(IndexError("Corrupt embedding index: " + path));
+            index.lists_[p].assign(rows + offsets[p], rows + offsets[p + 1]);
+            for (const u32 row : index.lists_[p]) {
+                if (row >= header.count) return std::unexpected(IndexError("Corrupt embedding index: " + path));
+            }
+        }
+    }
+
+    index.count_ = header.count;
+    index.rows_ = base + header.rows_offset;
+    index.scales_ = reinterpret_cast<const f32*>(base + header.scales_offset);
+    index.ids_ = reinterpret_cast<const u64*>(base + header.ids_offset);
+    index.mapping_ = std::move(*mapping);
+    return index;
+}
+
+} // namespace atom::data
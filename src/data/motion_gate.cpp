@@ -0,0 +1,298 @@
+#include "atom/data/motion_gate.hpp"
+#include "atom/inference/cpu/kernels.hpp"
+#include "atom/inference/cpu/parallel.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define ATOM_X86_KERNELS 1
+#endif
+
+namespace atom::data {
+
+using atom::core::f32;
+using atom::core::i32;
+using atom::core::i64;
+using atom::core::u8;
+using atom::core::u32;
+
+namespace {
+
+// SAD of `rows` rows, written per 8-byte column chunk: out[c] covers bytes [8c, 8c + 8)
+void BlockRowSad(const u8* current, const u8* reference, i64 stride, i64 rows, u32* out) {
+    for (i64 x = 0; x < stride; x += 8) {
+        u32 sum = 0;
+        for (i64 r = 0; r < rows; ++r) {
+            const u8* a = current + r * stride + x;
+            const u8* b = reference + r * stride + x;
+            for (int i = 0; i < 8; ++i) sum += static_cast<u32>(a[i] > b[i] ? a[i] - b[i] : b[i] - a[i]);
+        }
+        out[x / 8] = sum;
+    }
+}
+
+#ifdef ATOM_X86_KERNELS
+__attribute__((target("avx2")))
+void BlockRowSadAvx2(const u8* current, const u8* reference, i64 stride, i64 rows, u32* out) {
+    // psadbw sums each 8-byte lane, which is exactly one column chunk
+    for (i64 x = 0; x < stride; x += 32) {
+        __m256i acc = _mm256_setzero_si256();
+        for (i64 r = 0; r < rows; ++r) {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(current + r * stride + x));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(reference + r * stride + x));
+            acc = _mm256_add_epi64(acc, _mm256_sad_epu8(a, b));
+        }
+        alignas(32) atom::core::u64 lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        for (int i = 0; i < 4; ++i) out[x / 8 + i] = static_cast<u32>(lanes[i]);
+    }
+}
+#endif
+
+using BlockRowSadFn = void (*)(const u8*, const u8*, i64, i64, u32*);
+
+BlockRowSadFn SelectBlockRowSad() {
+    static const BlockRowSadFn kernel = [] {
+#ifdef ATOM_X86_KERNELS
+        if (atom::inference::cpu::kernels::DetectCpuIsa() >= atom::inference::cpu::kernels::CpuIsa::Avx2) {
+            return &BlockRowSadAvx2;
+        }
+#endif
+        return &BlockRowSad;
+    }();
+    return kernel;
+}
+
+bool Overlaps(const RoiBox& a, const RoiBox& b) {
+    return a.x1 < b.x2 && b.x1 < a.x2 && a.y1 < b.y2 && b.y1 < a.y2;
+}
+
+} // namespace
+
+MotionGate::MotionGate(MotionGateConfig config) : config_(config) {
+    config_.scale = std::max(config_.scale, 1);
+    config_.block_size = std::max(8, (config_.block_size + 7) / 8 * 8);
+    config_.region_margin = std::max(config_.region_margin, 0);
+
+    if (!config_.metrics_name.empty()) {
+        auto& registry = atom::logging::MetricsRegistry::Instance();
+        const auto& name = config_.metrics_name;
+        metrics_.frames = &registry.RegisterCounter(name + ".frames");
+        metrics_.skipped = &registry.RegisterCounter(name + ".skipped_frames");
+        metrics_.region_frames = &registry.RegisterCounter(name + ".region_frames");
+        metrics_.full_frames = &registry.RegisterCounter(name + ".full_frames");
+        metrics_.skip_rate = &registry.RegisterGauge(name + ".skip_rate");
+        metrics_.saved_fraction = &registry.RegisterGauge(name + ".saved_fraction");
+    }
+}
+
+void MotionGate::Reset() {
+    reference_.clear();
+    frame_width_ = frame_height_ = 0;
+    frames_since_inference_ = 0;
+}
+
+void MotionGate::Configure(const cv::Mat& frame) {
+    frame_width_ = frame.cols;
+    frame_height_ = frame.rows;
+    // A frame smaller than the scale would sample past its edge
+    scale_ = std::min<i64>({config_.scale, frame.cols, frame.rows});
+    plane_width_ = frame.cols / scale_;
+    plane_height_ = frame.rows / scale_;
+    blocks_x_ = (plane_width_ + config_.block_size - 1) / config_.block_size;
+    blocks_y_ = (plane_height_ + config_.block_size - 1) / config_.block_size;
+    plane_stride_ = (blocks_x_ * config_.block_size + 31) / 32 * 32;
+
+    // Padding stays zero in both planes, so it never adds to a block's SAD
+    const size_t plane_size = static_cast<size_t>(plane_stride_ * blocks_y_ * config_.block_size);
+    reference_.assign(plane_size, 0);
+    current_.assign(plane_size, 0);
+    chunk_sums_.assign(static_cast<size_t>(plane_stride_ / 8), 0);
+    changed_.assign(static_cast<size_t>(blocks_x_ * blocks_y_), 0);
+    labels_.assign(changed_.size(), -1);
+}
+
+void MotionGate::ComputeLuma(const cv::Mat& frame) {
+    // BT.601 luma of the 2x2 pixels at each cell's center (one pixel, taken
+    // four times, at scale 1): as good as a box average for block SADs, at a
+    // fraction of the frame reads
+    const i64 scale = scale_;
+    const i64 taps = scale > 1 ? 2 : 1;
+    const i64 first = (scale - taps) / 2;
+    const auto* source = static_cast<const u8*>(frame.data);
+    const auto step = static_cast<i64>(static_cast<size_t>(frame.step));
+    u8* plane = current_.data();
+
+    const auto run = [&](i64 begin, i64 end) {
+        for (i64 py = begin; py < end; ++py) {
+            u8* out = plane + py * plane_stride_;
+            const u8* top = source + (py * scale + first) * step + first * 3;
+            const u8* bottom = top + (taps - 1) * step;
+            for (i64 px = 0; px < plane_width_; ++px) {
+                const u8* a = top + px * scale * 3;
+                const u8* b = bottom + px * scale * 3;
+                const u8* c = a + (taps - 1) * 3;
+                const u8* d = b + (taps - 1) * 3;
+                const u32 blue = a[0] + b[0] + c[0] + d[0];
+                const u32 green = a[1] + b[1] + c[1] + d[1];
+                const u32 red = a[2] + b[2] + c[2] + d[2];
+                const u32 sum = 29u * blue + 150u * green + 77u * red;
+                out[px] = static_cast<u8>((sum + 512) >> 10);   // four samples, weights sum to 256
+            }
+        }
+    };
+    const i64 grain = std::max<i64>(1, 16384 / plane_width_);
+    atom::inference::cpu::Parallel(atom::inference::cpu::ComputePool(),
+                                   atom::inference::cpu::ComputeThreadCount()).For(plane_height_, grain, run);
+}
+
+i64 MotionGate::MarkChangedBlocks() {
+    const auto sad = SelectBlockRowSad();
+    const i64 block = config_.block_size;
+    const i64 chunks_per_block = block / 8;
+    i64 changed = 0;
+    for (i64 by = 0; by < blocks_y_; ++by) {
+        const i64 offset = by * block * plane_stride_;
+        sad(current_.data() + offset, reference_.data() + offset, plane_stride_, block, chunk_sums_.data());
+        const i64 rows = std::min(block, plane_height_ - by * block);
+        for (i64 bx = 0; bx < blocks_x_; ++bx) {
+            u32 sum = 0;
+            for (i64 c = 0; c < chunks_per_block; ++c) sum += chunk_sums_[bx * chunks_per_block + c];
+            const i64 cols = std::min(block, plane_width_ - bx * block);
+            const bool moved = static_cast<f32>(sum) > config_.pixel_threshold * static_cast<f32>(rows * cols);
+            changed_[by * blocks_x_ + bx] = moved ? 1 : 0;
+            changed += moved ? 1 : 0;
+        }
+    }
+    return changed;
+}
+
+f32 MotionGate::CollectRegions(std::vector<RoiBox>& regions) {
+    // 8-connected components of changed blocks, as padded bounding boxes
+    std::fill(labels_.begin(), labels_.end(), -1);
+    const f32 cell = static_cast<f32>(config_.block_size * scale_);
+    for (i64 start = 0; start < blocks_x_ * blocks_y_; ++start) {
+        if (!changed_[start] || labels_[start] >= 0) continue;
+        i64 x0 = start % blocks_x_, x1 = x0, y0 = start / blocks_x_, y1 = y0;
+        labels_[start] = static_cast<i32>(regions.size());
+        stack_.assign(1, static_cast<i32>(start));
+        while (!stack_.empty()) {
+            const i64 index = stack_.back();
+            stack_.pop_back();
+            const i64 bx = index % blocks_x_;
+            const i64 by = index / blocks_x_;
+            x0 = std::min(x0, bx), x1 = std::max(x1, bx), y0 = std::min(y0, by), y1 = std::max(y1, by);
+            for (i64 ny = std::max<i64>(by - 1, 0); ny <= std::min(by + 1, blocks_y_ - 1); ++ny) {
+                for (i64 nx = std::max<i64>(bx - 1, 0); nx <= std::min(bx + 1, blocks_x_ - 1); ++nx) {
+                    const i64 next = ny * blocks_x_ + nx;
+                    if (changed_[next] && labels_[next] < 0) {
+                        labels_[next] = labels_[start];
+                        stack_.push_back(static_cast<i32>(next));
+                    }
+                }
+            }
+        }
+        const i64 margin = config_.region_margin;
+        regions.push_back({static_cast<f32>(std::max<i64>(x0 - margin, 0)) * cell,
+                           static_cast<f32>(std::max<i64>(y0 - margin, 0)) * cell,
+                           std::min(static_cast<f32>(x1 + 1 + margin) * cell, static_cast<f32>(frame_width_)),
+                           std::min(static_cast<f32>(y1 + 1 + margin) * cell, static_cast<f32>(frame_height_))});
+    }
+
+    // Margins can make regions overlap; merge until they are disjoint
+    for (bool merged = true; merged;) {
+        merged = false;
+        for (size_t i = 0; i < regions.size() && !merged; ++i) {
+            for (size_t j = i + 1; j < regions.size(); ++j) {
+                if (!Overlaps(regions[i], regions[j])) continue;
+                regions[i] = {std::min(regions[i].x1, regions[j].x1), std::min(regions[i].y1, regions[j].y1),
+                              std::max(regions[i].x2, regions[j].x2), std::max(regions[i].y2, regions[j].y2)};
+                regions.erase(regions.begin() + static_cast<std::ptrdiff_t>(j));
+                merged = true;
+                break;
+            }
+        }
+    }
+
+    f32 area = 0.0f;
+    for (const auto& region : regions) area += (region.x2 - region.x1) * (region.y2 - region.y1);
+    return area / static_cast<f32>(frame_width_ * frame_height_);
+}
+
+void MotionGate::CommitBlocks(const std::vector<RoiBox>& regions) {
+    // Regions start on block boundaries, so they map onto whole luma rows and columns
+    const i64 scale = scale_;
+    for (const auto& region : regions) {
+        const i64 x0 = static_cast<i64>(region.x1) / scale;
+        const i64 y0 = static_cast<i64>(region.y1) / scale;
+        const i64 x1 = std::min((static_cast<i64>(region.x2) + scale - 1) / scale, plane_width_);
+        const i64 y1 = std::min((static_cast<i64>(region.y2) + scale - 1) / scale, plane_height_);
+        for (i64 y = y0; y < y1; ++y) {
+            std::memcpy(reference_.data() + y * plane_stride_ + x0, current_.data() + y * plane_stride_ + x0,
+                        static_cast<size_t>(x1 - x0));
+        }
+    }
+}
+
+atom::core::Result<void> MotionGate::Evaluate(const cv::Mat& frame, MotionDecision& decision) {
+    if (frame.empty() || frame.type() != CV_8UC3) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Motion gating needs an 8-bit 3-channel frame"));
+    }
+
+    decision.regions.clear();
+    const bool first = reference_.empty() || frame.cols != frame_width_ || frame.rows != frame_height_;
+    if (first) Configure(frame);
+    ComputeLuma(frame);
+
+    const i64 changed = first ? blocks_x_ * blocks_y_ : MarkChangedBlocks();
+    decision.changed_fraction = static_cast<f32>(changed) / static_cast<f32>(blocks_x_ * blocks_y_);
+    const bool forced = first || (config_.max_skip_frames > 0 &&
+                                  frames_since_inference_ + 1 >= config_.max_skip_frames);
+
+    if (!forced && decision.changed_fraction <= config_.min_changed_fraction) {
+        decision.action = MotionAction::Skip;
+        ++frames_since_inference_;
+        Record(MotionAction::Skip, 0.0);
+        return {};
+    }
+
+    if (!forced && config_.enable_regions) {
+        const f32 area = CollectRegions(decision.regions);
+        if (area <= config_.max_region_fraction) {
+            decision.action = MotionAction::Regions;
+            CommitBlocks(decision.regions);
+            ++frames_since_inference_;
+            Record(MotionAction::Regions, area);
+            return {};
+        }
+        decision.regions.clear();
+    }
+
+    decision.action = MotionAction::Full;
+    std::swap(reference_, current_);
+    frames_since_inference_ = 0;
+    Record(MotionAction::Full, 1.0);
+    return {};
+}
+
+void MotionGate::Record(MotionAction action, atom::core::f64 area) {
+    ++stats_.frames;
+    stats_.inferred_area += area;
+    atom::logging::Counter* counter = nullptr;
+    switch (action) {
+        case MotionAction::Skip: ++stats_.skipped; counter = metrics_.skipped; break;
+        case MotionAction::Regions: ++stats_.region_frames; counter = metrics_.region_frames; break;
+        case MotionAction::Full: ++stats_.full_frames; counter = metrics_.full_frames; break;
+    }
+
+    if (!metrics_.frames) return;
+    metrics_.frames->Increment();
+    counter->Increment();
+    // Gauges follow GetStats, so they restart with ResetStats
+    metrics_.skip_rate->Set(stats_.SkipRate());
+    metrics_.saved_fraction->Set(stats_.SavedFraction());
+}
+
+} // namespace atom::data
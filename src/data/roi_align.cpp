@@ -0,0 +1,113 @@
+#include "atom/data/roi_align.hpp"
+#include "atom/inference/cpu/parallel.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace atom::data {
+
+using atom::core::f32;
+using atom::core::i64;
+
+namespace {
+
+// Two neighbouring source pixels (byte offsets) and the weight of the second
+struct Tap {
+    i64 offset0;
+    i64 offset1;
+    f32 weight;
+};
+
+void SampleAxis(f32 start, f32 length, i64 out_size, i64 in_size, i64 stride, Tap* taps) {
+    const f32 step = length / static_cast<f32>(out_size);
+    const f32 last = static_cast<f32>(in_size - 1);
+    for (i64 o = 0; o < out_size; ++o) {
+        const f32 s = std::clamp(start + (static_cast<f32>(o) + 0.5f) * step - 0.5f, 0.0f, last);
+        const i64 i0 = static_cast<i64>(s);
+        const i64 i1 = std::min(i0 + 1, in_size - 1);
+        taps[o] = {i0 * stride, i1 * stride, s - static_cast<f32>(i0)};
+    }
+}
+
+} // namespace
+
+atom::core::Result<void> CropResizeBatch(const cv::Mat& frame, std::span<const RoiBox> boxes,
+                                         const PreprocessConfig& config, atom::core::Tensor& batch) {
+    if (frame.empty() || frame.type() != CV_8UC3) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "ROI crops need an 8-bit 3-channel frame"));
+    }
+    if (boxes.empty()) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "No boxes to crop"));
+    }
+
+    const i64 count = static_cast<i64>(boxes.size());
+    const i64 height = config.target_size.height;
+    const i64 width = config.target_size.width;
+    const atom::core::Shape shape{count, 3, height, width};
+    if (batch.GetShape() != shape || batch.GetDataType() != atom::core::DataType::Float32 ||
+        batch.GetDevice().type != atom::core::DeviceType::CPU) {
+        auto created = atom::core::Tensor::Create(shape, atom::core::DataType::Float32);
+        if (!created) return std::unexpected(created.error());
+        batch = std::move(*created);
+    }
+
+    // value = pixel * scale + bias per output channel
+    f32 scale[3];
+    f32 bias[3];
+    for (int c = 0; c < 3; ++c) {
+        const f32 deviation = config.normalize ? static_cast<f32>(config.std[c]) : 1.0f;
+        scale[c] = 1.0f / (255.0f * deviation);
+        bias[c] = config.normalize ? -static_cast<f32>(config.mean[c]) / deviation : 0.0f;
+    }
+    const int source_channel[3] = {config.to_rgb ? 2 : 0, 1, config.to_rgb ? 0 : 2};
+
+    std::vector<Tap> x_taps(count * width);
+    std::vector<Tap> y_taps(count * height);
+    const auto row_stride = static_cast<i64>(static_cast<size_t>(frame.step));
+    for (i64 k = 0; k < count; ++k) {
+        const auto& box = boxes[k];
+        SampleAxis(box.x1, box.x2 - box.x1, width, frame.cols, 3, &x_taps[k * width]);
+        SampleAxis(box.y1, box.y2 - box.y1, height, frame.rows, row_stride, &y_taps[k * height]);
+    }
+
+    const auto* source = static_cast<const atom::core::u8*>(frame.data);
+    auto* output = static_cast<f32*>(batch.GetData());
+    const i64 plane = height * width;
+    const auto run = [&](i64 begin, i64 end) {
+        for (i64 row = begin; row < end; ++row) {
+            const i64 k = row / height;
+            const i64 y = row % height;
+            const Tap& ty = y_taps[row];
+            const atom::core::u8* top = source + ty.offset0;
+            const atom::core::u8* bottom = source + ty.offset1;
+            const Tap* taps = &x_taps[k * width];
+            f32* out = output + k * 3 * plane + y * width;
+            for (int c = 0; c < 3; ++c) {
+                const atom::core::u8* t = top + source_channel[c];
+                const atom::core::u8* b = bottom + source_channel[c];
+                const f32 wy = ty.weight;
+                f32* dst = out + c * plane;
+                for (i64 x = 0; x < width; ++x) {
+                    const Tap& tx = taps[x];
+                    const f32 upper = t[tx.offset0] + (t[tx.offset1] - t[tx.offset0]) * tx.weight;
+                    const f32 lower = b[tx.offset0] + (b[tx.offset1] - b[tx.offset0]) * tx.weight;
+                    dst[x] = (upper + (lower - upper) * wy) * scale[c] + bias[c];
+                }
+            }
+        }
+    };
+    atom::inference::cpu::Parallel(atom::inference::cpu::ComputePool(),
+                                   atom::inference::cpu::ComputeThreadCount()).For(count * height, height, run);
+    return {};
+}
+
+atom::core::Result<atom::core::Tensor> CropResizeBatch(const cv::Mat& frame, std::span<const RoiBox> boxes,
+                                                       const PreprocessConfig& config) {
+    atom::core::Tensor batch;
+    auto cropped = CropResizeBatch(frame, boxes, config, batch);
+    if (!cropped) return std::unexpected(cropped.error());
+    return batch;
+}
+
+} // namespace atom::data
@@ -0,0 +1,84 @@
+#include "atom/inference/async_executor.hpp"
+#include "atom/inference/backend.hpp"
+
+namespace atom::inference {
+
+AsyncExecutor::AsyncExecutor(IBackend& backend, size_t num_workers, size_t queue_capacity)
+    : backend_(backend), queue_(queue_capacity) {
+    num_workers = std::max<size_t>(num_workers, 1);
+    workers_.reserve(num_workers);
+    for (size_t i = 0; i < num_workers; ++i) {
+        workers_.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+
+AsyncExecutor::~AsyncExecutor() {
+    Stop();
+}
+
+atom::core::Result<void> AsyncExecutor::Submit(
+    std::vector<atom::core::Tensor> inputs, CompletionCallback callback) {
+    
+    if (!running_) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Async executor is stopped"));
+    }
+    
+    Request request{std::move(inputs), std::move(callback)};
+    if (!queue_.Push(std::move(request), atom::core::Duration::zero())) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::QueueFull,
+            "Backend submission queue is full"));
+    }
+    
+    return {};
+}
+
+std::future<ExecuteResult> AsyncExecutor::Submit(std::vector<atom::core::Tensor> inputs) {
+    auto promise = std::make_shared<std::promise<ExecuteResult>>();
+    auto future = promise->get_future();
+    
+    auto submitted = Submit(std::move(inputs), [promise](ExecuteResult result) {
+        promise->set_value(std::move(result));
+    });
+    if (!submitted) {
+        promise->set_value(std::unexpected(submitted.error()));
+    }
+    
+    return future;
+}
+
+void AsyncExecutor::Stop() {
+    running_ = false;
+    queue_.Stop();
+    
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+}
+
+void AsyncExecutor::WorkerLoop() {
+    // Pop keeps returning queued requests after Stop() until the queue is empty
+    while (auto request = queue_.Pop()) {
+        in_flight_++;
+        
+        ExecuteResult result = [&]() -> ExecuteResult {
+            try {
+                return backend_.Execute(request->inputs);
+            } catch (const std::exception& e) {
+                return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::Unknown,
+                    "Execute threw: " + std::string(e.what())));
+            }
+        }();
+        
+        if (request->callback) {
+            request->callback(std::move(result));
+        }
+        
+        in_flight_--;
+    }
+}
+
+} // namespace atom::inference
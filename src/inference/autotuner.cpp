@@ -0,0 +1,435 @@
+#include "atom/inference/autotuner.hpp"
+#include "atom/inference/backend_factory.hpp"
+#include "atom/inference/cpu/binary_io.hpp"
+#include "atom/logging/logger.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace atom::inference {
+
+namespace {
+
+constexpr const char* kCacheHeader = "# atom tuning cache v1";
+constexpr int kMinIterations = 3;
+constexpr int kMaxIterations = 1000;
+constexpr auto kMinMeasureBudget = std::chrono::milliseconds(1);
+
+std::vector<std::string> SplitString(const std::string& text, char delimiter) {
+    std::vector<std::string> parts;
+    std::string part;
+    std::istringstream stream(text);
+    while (std::getline(stream, part, delimiter)) {
+        parts.push_back(part);
+    }
+    return parts;
+}
+
+std::optional<TuningEntry> ParseEntry(const std::vector<std::string>& fields) {
+    try {
+        TuningEntry entry;
+        entry.batch_size = std::stoull(fields[1]);
+        auto backend = ParseBackendType(fields[2]);
+        if (!backend) return std::nullopt;
+        entry.backend = *backend;
+        entry.variant = fields[3];
+        entry.median_ms = std::stod(fields[4]);
+
+        if (fields.size() > 5) {
+            for (const auto& item : SplitString(fields[5], ',')) {
+                auto slash = item.find('/');
+                auto equals = item.find('=');
+                if (slash == std::string::npos || equals == std::string::npos || equals < slash) {
+                    return std::nullopt;
+                }
+                auto type = ParseBackendType(item.substr(0, slash));
+                if (!type) return std::nullopt;
+                entry.timings.push_back({*type, item.substr(slash + 1, equals - slash - 1),
+                                         std::stod(item.substr(equals + 1))});
+            }
+        }
+        return entry;
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+}
+
+atom::core::Result<std::vector<atom::core::Tensor>> MakeInputs(
+    const std::vector<atom::core::Shape>& shapes,
+    const std::vector<atom::core::DataType>& types,
+    size_t batch_size) {
+
+    std::mt19937 rng(static_cast<unsigned>(batch_size));
+    std::uniform_real_distribution<atom::core::f32> dist(0.0f, 1.0f);
+
+    std::vector<atom::core::Tensor> inputs;
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        auto shape = shapes[i];
+        if (shape.empty()) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+                "Autotuning needs ranked input shapes"));
+        }
+        shape[0] = static_cast<atom::core::i64>(batch_size);
+        if (std::any_of(shape.begin(), shape.end(), [](auto d) { return d <= 0; })) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+                "Autotuning needs static non-batch input dimensions"));
+        }
+
+        auto dtype = i < types.size() ? types[i] : atom::core::DataType::Float32;
+        auto tensor = atom::core::Tensor::Create(shape, dtype);
+        if (!tensor) return std::unexpected(tensor.error());
+
+        if (dtype == atom::core::DataType::Float32) {
+            auto* data = static_cast<atom::core::f32*>(tensor->GetData());
+            for (size_t j = 0; j < tensor->GetSize(); ++j) data[j] = dist(rng);
+        } else {
+            std::memset(tensor->GetData(), 0, tensor->GetByteSize());
+        }
+        inputs.push_back(std::move(*tensor));
+    }
+    return inputs;
+}
+
+} // namespace
+
+TuningCache::TuningCache(std::filesystem::path path)
+    : path_(std::move(path)) {}
+
+atom::core::Result<void> TuningCache::Load() {
+    std::ifstream file(path_);
+    if (!file) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Cannot open tuning cache: " + path_.string()));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        auto fields = SplitString(line, '\t');
+        if (fields.size() < 5) continue;
+
+        if (auto entry = ParseEntry(fields)) {
+            entries_[{fields[0], entry->batch_size}] = std::move(*entry);
+        }
+    }
+    return {};
+}
+
+atom::core::Result<void> TuningCache::Save() const {
+    // Write then rename so a crash never leaves a truncated cache behind
+    auto temp_path = path_;
+    temp_path += ".tmp";
+
+    {
+        std::ofstream file(temp_path, std::ios::trunc);
+        if (!file) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+                "Cannot write tuning cache: " + temp_path.string()));
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        file << kCacheHeader << '\n';
+        for (const auto& [id, entry] : entries_) {
+            file << id.first << '\t' << entry.batch_size << '\t'
+                 << BackendTypeName(entry.backend) << '\t' << entry.variant << '\t'
+                 << entry.median_ms << '\t';
+            for (size_t i = 0; i < entry.timings.size(); ++i) {
+                const auto& timing = entry.timings[i];
+                file << (i ? "," : "") << BackendTypeName(timing.backend) << '/'
+                     << timing.variant << '=' << timing.median_ms;
+            }
+            file << '\n';
+        }
+        if (!file) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+                "Failed writing tuning cache: " + temp_path.string()));
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path_, ec);
+    if (ec) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Failed to replace tuning cache: " + ec.message()));
+    }
+    return {};
+}
+
+std::optional<TuningEntry> TuningCache::Find(const std::string& key, size_t batch_size) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find({key, batch_size});
+    if (it == entries_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void TuningCache::Store(const std::string& key, const TuningEntry& entry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[{key, entry.batch_size}] = entry;
+}
+
+std::string TuningCache::MakeKey(atom::core::u64 model_hash, const std::string& cpu_model) {
+    std::ostringstream key;
+    key << std::hex << model_hash << std::dec << '|' << cpu_model << '|'
+        << std::thread::hardware_concurrency();
+    return key.str();
+}
+
+BackendAutotuner::BackendAutotuner(atom::core::AutotuneOptions options)
+    : options_(std::move(options)) {
+    if (options_.batch_sizes.empty()) {
+        options_.batch_sizes = {1};
+    }
+}
+
+atom::core::Result<TuningDecision> BackendAutotuner::Tune(
+    const std::string& model_path,
+    const atom::core::DeviceInfo& device,
+    const std::vector<atom::core::Shape>& input_shapes,
+    const std::vector<atom::core::DataType>& input_types) {
+
+    auto hash = HashModelFile(model_path);
+    if (!hash) return std::unexpected(hash.error());
+
+    const auto key = TuningCache::MakeKey(*hash, GetCpuModel());
+    TuningCache cache(options_.cache_path);
+    (void)cache.Load();  // a missing cache just means tuning from scratch
+
+    // Reuse the cached decision when every batch size is covered by one backend
+    std::vector<TuningEntry> cached;
+    for (size_t batch : options_.batch_sizes) {
+        auto entry = cache.Find(key, batch);
+        if (!entry || (!cached.empty() && entry->backend != cached.front().backend)) {
+            cached.clear();
+            break;
+        }
+        cached.push_back(std::move(*entry));
+    }
+    if (!cached.empty()) {
+        auto decision = ApplyCached(cached, model_path, device);
+        if (decision) return decision;
+        LOG_WARNING("Cached tuning decision unusable, re-tuning: " + decision.error().message);
+    }
+
+    // Load the model into every registered backend that accepts it
+    struct Candidate {
+        atom::core::BackendType type;
+        UniqueBackendPtr backend;
+        std::vector<std::string> variants;
+    };
+    std::vector<Candidate> candidates;
+    for (auto type : BackendFactory::Instance().GetAvailableBackends()) {
+        auto backend = CreateLoadedBackend(type, model_path, device);
+        if (!backend) {
+            LOG_INFO(std::string("Skipping backend ") + BackendTypeName(type) + " for tuning: " +
+                     backend.error().message);
+            continue;
+        }
+        auto variants = (*backend)->GetKernelVariants();
+        candidates.push_back({type, std::move(*backend), std::move(variants)});
+    }
+    if (candidates.empty()) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::BackendNotAvailable,
+            "No registered backend could load " + model_path));
+    }
+
+    size_t measurements = 0;
+    for (const auto& candidate : candidates) {
+        measurements += candidate.variants.size() * options_.batch_sizes.size();
+    }
+    const auto budget = std::max<atom::core::Duration>(
+        options_.budget / static_cast<atom::core::i64>(measurements), kMinMeasureBudget);
+
+    std::vector<TuningEntry> entries;
+    for (size_t batch : options_.batch_sizes) {
+        TuningEntry entry;
+        entry.batch_size = batch;
+        entries.push_back(std::move(entry));
+    }
+
+    // Per candidate: best variant and latency for each batch size
+    std::vector<std::vector<std::optional<KernelTiming>>> best(
+        candidates.size(), std::vector<std::optional<KernelTiming>>(options_.batch_sizes.size()));
+
+    for (size_t b = 0; b < options_.batch_sizes.size(); ++b) {
+        const size_t batch = options_.batch_sizes[b];
+        auto inputs = MakeInputs(input_shapes, input_types, batch);
+        if (!inputs) return std::unexpected(inputs.error());
+
+        for (size_t c = 0; c < candidates.size(); ++c) {
+            auto& candidate = candidates[c];
+            for (const auto& variant : candidate.variants) {
+                if (!candidate.backend->SelectKernelVariant(variant, batch)) continue;
+
+                auto ms = Measure(*candidate.backend, *inputs, budget);
+                if (!ms) {
+                    LOG_INFO(std::string("Tuning run failed on ") + BackendTypeName(candidate.type) +
+                             "/" + variant + ": " + ms.error().message);
+                    continue;
+                }
+
+                KernelTiming timing{candidate.type, variant, *ms};
+                entries[b].timings.push_back(timing);
+                if (!best[c][b] || timing.median_ms < best[c][b]->median_ms) {
+                    best[c][b] = timing;
+                }
+            }
+        }
+    }
+
+    // One backend per model: lowest summed latency over all tuned batch sizes
+    std::optional<size_t> winner;
+    atom::core::f64 winner_total = 0.0;
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        atom::core::f64 total = 0.0;
+        bool complete = true;
+        for (const auto& timing : best[c]) {
+            if (!timing) {
+                complete = false;
+                break;
+            }
+            total += timing->median_ms;
+        }
+        if (complete && (!winner || total < winner_total)) {
+            winner = c;
+            winner_total = total;
+        }
+    }
+    if (!winner) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::BackendNotAvailable,
+            "No backend ran the model at every tuned batch size"));
+    }
+
+    TuningDecision decision;
+    decision.backend = std::move(candidates[*winner].backend);
+    for (size_t b = 0; b < entries.size(); ++b) {
+        const auto& choice = *best[*winner][b];
+        entries[b].backend = choice.backend;
+        entries[b].variant = choice.variant;
+        entries[b].median_ms = choice.median_ms;
+
+        auto selected = decision.backend->SelectKernelVariant(choice.variant, entries[b].batch_size);
+        if (!selected) return std::unexpected(selected.error());
+        cache.Store(key, entries[b]);
+
+        LOG_INFO("Autotune batch " + std::to_string(entries[b].batch_size) + ": " +
+                 BackendTypeName(choice.backend) + "/" + choice.variant + " " +
+                 std::to_string(choice.median_ms) + " ms");
+    }
+    decision.entries = std::move(entries);
+
+    // Losing backends still hold the model; release them before returning
+    candidates.clear();
+
+    auto saved = cache.Save();
+    if (!saved) {
+        LOG_WARNING("Tuning cache not saved: " + saved.error().message);
+    }
+
+    return decision;
+}
+
+atom::core::Result<atom::core::u64> BackendAutotuner::HashModelFile(const std::string& model_path) {
+    auto hash = cpu::HashFile(model_path);
+    if (!hash) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::ModelNotFound,
+            "Cannot open model: " + model_path));
+    }
+    return *hash;
+}
+
+std::string BackendAutotuner::GetCpuModel() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.rfind("model name", 0) == 0) {
+            auto colon = line.find(':');
+            if (colon != std::string::npos) {
+                auto name = line.substr(colon + 1);
+                name.erase(0, name.find_first_not_of(' '));
+                std::replace(name.begin(), name.end(), '\t', ' ');
+                std::replace(name.begin(), name.end(), '|', ' ');
+                return name;
+            }
+        }
+    }
+    return "unknown";
+}
+
+atom::core::Result<UniqueBackendPtr> BackendAutotuner::CreateLoadedBackend(
+    atom::core::BackendType type,
+    const std::string& model_path,
+    const atom::core::DeviceInfo& device) const {
+
+    auto backend = BackendFactory::Instance().Create(type);
+    if (!backend) return std::unexpected(backend.error());
+
+    // CPU backends run on the host whatever device the model asked for
+    auto backend_device = device;
+    if (type == atom::core::BackendType::CPU) {
+        backend_device = {atom::core::DeviceType::CPU, 0};
+    } else if (device.type == atom::core::DeviceType::CPU) {
+        backend_device = {atom::core::DeviceType::CUDA, 0};
+    }
+
+    auto init = (*backend)->Initialize(backend_device);
+    if (!init) return std::unexpected(init.error());
+
+    auto load = (*backend)->LoadModel(model_path);
+    if (!load) return std::unexpected(load.error());
+
+    return std::move(*backend);
+}
+
+atom::core::Result<TuningDecision> BackendAutotuner::ApplyCached(
+    const std::vector<TuningEntry>& entries,
+    const std::string& model_path,
+    const atom::core::DeviceInfo& device) const {
+
+    auto backend = CreateLoadedBackend(entries.front().backend, model_path, device);
+    if (!backend) return std::unexpected(backend.error());
+
+    for (const auto& entry : entries) {
+        auto selected = (*backend)->SelectKernelVariant(entry.variant, entry.batch_size);
+        if (!selected) return std::unexpected(selected.error());
+    }
+
+    LOG_INFO(std::string("Using cached tuning: ") + BackendTypeName(entries.front().backend));
+    return TuningDecision{std::move(*backend), entries, true};
+}
+
+atom::core::Result<atom::core::f64> BackendAutotuner::Measure(
+    IBackend& backend,
+    const std::vector<atom::core::Tensor>& inputs,
+    atom::core::Duration budget) const {
+
+    // Warmup run absorbs lazy allocation and first-touch costs
+    auto warmup = backend.Execute(inputs);
+    if (!warmup) return std::unexpected(warmup.error());
+
+    std::vector<atom::core::f64> samples;
+    const auto start = std::chrono::steady_clock::now();
+    while (samples.size() < static_cast<size_t>(kMaxIterations)) {
+        const auto begin = std::chrono::steady_clock::now();
+        auto result = backend.Execute(inputs);
+        const auto end = std::chrono::steady_clock::now();
+        if (!result) return std::unexpected(result.error());
+
+        samples.push_back(std::chrono::duration<atom::core::f64, std::milli>(end - begin).count());
+        if (samples.size() >= static_cast<size_t>(kMinIterations) && end - start >= budget) {
+            break;
+        }
+    }
+
+    auto middle = samples.begin() + static_cast<std::ptrdiff_t>(samples.size() / 2);
+    std::nth_element(samples.begin(), middle, samples.end());
+    return *middle;
+}
+
+} // namespace atom::inference
@@ -1,4 +1,80 @@
-// Placeholder implementation for inference/backend
 #include "atom/inference/backend.hpp"
+#include "atom/logging/logger.hpp"
+#include <cstdlib>
 
-// TODO: Implement inference/backend
+namespace atom::inference {
+
+IBackend::~IBackend() {
+    // The derived backend is already destroyed here, so a request still
+    // queued or running would Execute on a dead object. Derived destructors
+    // must DrainAsync first; one that does not is a bug, not a shutdown race.
+    if (async_executor_) {
+        LOG_CRITICAL("Backend destroyed without DrainAsync()");
+        std::abort();
+    }
+}
+
+atom::core::Result<void> IBackend::ExecuteAsync(
+    std::vector<atom::core::Tensor> inputs, CompletionCallback callback) {
+    
+    if (!IsModelLoaded()) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "No model loaded"));
+    }
+    
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    if (!async_executor_) {
+        async_executor_ = std::make_unique<AsyncExecutor>(*this, async_worker_count_);
+    }
+    return async_executor_->Submit(std::move(inputs), std::move(callback));
+}
+
+std::future<ExecuteResult> IBackend::ExecuteAsync(std::vector<atom::core::Tensor> inputs) {
+    auto promise = std::make_shared<std::promise<ExecuteResult>>();
+    auto future = promise->get_future();
+    
+    auto submitted = ExecuteAsync(std::move(inputs), [promise](ExecuteResult result) {
+        promise->set_value(std::move(result));
+    });
+    if (!submitted) {
+        promise->set_value(std::unexpected(submitted.error()));
+    }
+    
+    return future;
+}
+
+atom::core::Result<void> IBackend::SetExecutionContextCount(size_t count) {
+    if (count == 1) {
+        return {};
+    }
+    return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::NotImplemented,
+        "Backend does not support multiple execution contexts"));
+}
+
+atom::core::Result<void> IBackend::SelectKernelVariant(const std::string& variant,
+                                                      std::optional<size_t> batch_size) {
+    (void)batch_size;
+    if (variant == "default") {
+        return {};
+    }
+    return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+        "Unknown kernel variant: " + variant));
+}
+
+void IBackend::SetAsyncWorkerCount(size_t num_workers) {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    async_worker_count_ = std::max<size_t>(num_workers, 1);
+}
+
+void IBackend::DrainAsync() {
+    std::unique_ptr<AsyncExecutor> executor;
+    {
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        executor = std::move(async_executor_);
+    }
+    if (executor) {
+        executor->Stop();
+    }
+}
+
+} // namespace atom::inference
@@ -1,4 +1,81 @@
-// Placeholder implementation for inference/backend_factory
 #include "atom/inference/backend_factory.hpp"
 
-// TODO: Implement inference/backend_factory
+namespace atom::inference {
+
+BackendFactory& BackendFactory::Instance() {
+    static BackendFactory instance;
+    return instance;
+}
+
+bool BackendFactory::Register(atom::core::BackendType type, CreatorFunc creator) {
+    std::unique_lock lock(mutex_);
+    
+    if (creators_.find(type) != creators_.end()) {
+        return false; // Already registered
+    }
+    
+    creators_[type] = std::move(creator);
+    return true;
+}
+
+bool BackendFactory::Unregister(atom::core::BackendType type) {
+    std::unique_lock lock(mutex_);
+    return creators_.erase(type) > 0;
+}
+
+atom::core::Result<UniqueBackendPtr> BackendFactory::Create(atom::core::BackendType type) const {
+    std::shared_lock lock(mutex_);
+    
+    auto it = creators_.find(type);
+    if (it == creators_.end()) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::BackendNotAvailable, 
+            std::string("Backend not registered: ") + BackendTypeName(type)));
+    }
+    
+    try {
+        return it->second();
+    } catch (const std::exception& e) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::Unknown, 
+            "Failed to create backend: " + std::string(e.what())));
+    }
+}
+
+bool BackendFactory::IsAvailable(atom::core::BackendType type) const {
+    std::shared_lock lock(mutex_);
+    return creators_.find(type) != creators_.end();
+}
+
+std::vector<atom::core::BackendType> BackendFactory::GetAvailableBackends() const {
+    std::shared_lock lock(mutex_);
+    
+    std::vector<atom::core::BackendType> types;
+    types.reserve(creators_.size());
+    
+    for (const auto& [type, _] : creators_) {
+        types.push_back(type);
+    }
+    
+    return types;
+}
+
+const char* BackendTypeName(atom::core::BackendType type) {
+    switch (type) {
+        case atom::core::BackendType::TensorRT: return "TensorRT";
+        case atom::core::BackendType::ONNX: return "ONNX";
+        case atom::core::BackendType::CPU: return "CPU";
+        case atom::core::BackendType::Custom: return "Custom";
+    }
+    return "Unknown";
+}
+
+std::optional<atom::core::BackendType> ParseBackendType(std::string_view name) {
+    for (auto type : {atom::core::BackendType::TensorRT, atom::core::BackendType::ONNX,
+                      atom::core::BackendType::CPU, atom::core::BackendType::Custom}) {
+        if (name == BackendTypeName(type)) {
+            return type;
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace atom::inference
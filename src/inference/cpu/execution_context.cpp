@@ -0,0 +1,380 @@
+#include "atom/inference/cpu/execution_context.hpp"
+#include "atom/inference/cpu/kernels.hpp"
+#include "atom/inference/cpu/quantized_kernels.hpp"
+#include "atom/scheduler/thread_pool.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+
+namespace atom::inference::cpu {
+
+// Shared with the pool jobs of one branch-parallel run. Jobs that start after
+// the run finished find no ready nodes and leave without touching the context.
+struct ExecutionContext::BranchRun {
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<u32> ready;
+    std::vector<u32> pending;           // unfinished predecessors per node
+    std::vector<size_t> free_lanes;
+    size_t remaining{0};
+};
+
+ExecutionContext::ExecutionContext(std::shared_ptr<const Plan> plan)
+    : plan_(std::move(plan)), graph_(&plan_->GetGraph()) {
+
+    const auto& nodes = graph_->nodes;
+    std::vector<i32> producer(graph_->values.size(), -1);
+    successors_.resize(nodes.size());
+    predecessor_counts_.assign(nodes.size(), 0);
+
+    for (u32 i = 0; i < nodes.size(); ++i) {
+        std::vector<u32> predecessors;
+        for (u32 in : nodes[i].inputs) {
+            if (producer[in] >= 0) predecessors.push_back(static_cast<u32>(producer[in]));
+        }
+        std::sort(predecessors.begin(), predecessors.end());
+        predecessors.erase(std::unique(predecessors.begin(), predecessors.end()), predecessors.end());
+        for (u32 p : predecessors) successors_[p].push_back(i);
+        predecessor_counts_[i] = static_cast<u32>(predecessors.size());
+
+        for (u32 out : nodes[i].outputs) producer[out] = static_cast<i32>(i);
+    }
+}
+
+void ExecutionContext::SetParallelism(size_t intra_op_threads, size_t branches) {
+    auto* pool = ComputePool();
+    const size_t limit = ComputeThreadCount();
+    parallel_ = Parallel(pool, std::clamp<size_t>(intra_op_threads, 1, limit));
+
+    const size_t new_branches = pool ? std::clamp<size_t>(branches, 1, limit) : 1;
+    if (new_branches != branches_) {
+        // The memory layout depends on whether branches may overlap
+        branches_ = new_branches;
+        shape_plan_.reset();
+    }
+}
+
+atom::core::Result<std::shared_ptr<const ShapePlan>> BuildShapePlan(
+    const Plan& plan, const std::vector<Shape>& input_shapes, bool concurrent) {
+
+    const auto& graph = plan.GetGraph();
+    auto shapes = graph.InferShapes(input_shapes);
+    if (!shapes) return std::unexpected(shapes.error());
+
+    auto result = std::make_shared<ShapePlan>();
+    result->input_shapes = input_shapes;
+    result->shapes = std::move(*shapes);
+    result->concurrent = concurrent;
+
+    // Reuse the compiled memory plan when only the batch differs from it.
+    // It assumes sequential execution, so branch-parallel runs plan their own.
+    const auto& planned = plan.GetMemoryPlan();
+    bool reuse = !concurrent && !planned.offsets.empty() &&
+                 planned.input_shapes.size() == input_shapes.size();
+    for (size_t i = 0; reuse && i < input_shapes.size(); ++i) {
+        const auto& a = planned.input_shapes[i];
+        const auto& b = input_shapes[i];
+        reuse = a.size() == b.size() && std::equal(a.begin() + 1, a.end(), b.begin() + 1) &&
+                (planned.per_sample || a[0] == b[0]);
+    }
+
+    if (reuse) {
+        const i64 scale = planned.per_sample ? input_shapes[0][0] : 1;
+        result->offsets = planned.offsets;
+        for (auto& offset : result->offsets) {
+            if (offset >= 0) offset *= scale;
+        }
+        result->arena_size = planned.arena_size * scale;
+    } else {
+        auto memory = PlanMemory(graph, result->shapes, concurrent);
+        result->offsets = std::move(memory.offsets);
+        result->arena_size = memory.arena_size;
+    }
+
+    for (size_t i = 0; i < graph.nodes.size(); ++i) {
+        const auto& node = graph.nodes[i];
+        const auto& x = result->shapes[node.inputs[0]];
+        const bool quantized = plan.GetQuantParams(i) != nullptr;
+        if (node.op == OpType::Conv2D && quantized) {
+            result->quantized_scratch = std::max(result->quantized_scratch, kernels::QConv2DScratchBytes(
+                x, graph.weights[node.weight].shape, result->shapes[node.outputs[0]], node.attrs));
+        } else if (node.op == OpType::Conv2D) {
+            result->scratch = std::max(result->scratch, kernels::Conv2DScratchSize(
+                x, graph.weights[node.weight].shape, result->shapes[node.outputs[0]], node.attrs));
+        } else if (node.op == OpType::Gemm && quantized) {
+            result->quantized_scratch = std::max(result->quantized_scratch,
+                                                 kernels::QLinearScratchBytes(x[0], x[1]));
+        }
+    }
+    return result;
+}
+
+atom::core::Result<void> ExecutionContext::Prepare(const std::vector<Shape>& input_shapes) {
+    if (shape_plan_ && shape_plan_->input_shapes == input_shapes) {
+        return {};
+    }
+
+    auto shape_plan = BuildShapePlan(*plan_, input_shapes, branches_ > 1);
+    if (!shape_plan) return std::unexpected(shape_plan.error());
+    return Prepare(std::move(*shape_plan));
+}
+
+atom::core::Result<void> ExecutionContext::Prepare(std::shared_ptr<const ShapePlan> shape_plan) {
+    if (shape_plan == shape_plan_) {
+        return {};
+    }
+    if (!shape_plan || shape_plan->concurrent != (branches_ > 1)) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Shape plan does not match the context's branch parallelism"));
+    }
+
+    // Buffers only grow, so alternating between prepared shapes never reallocates
+    try {
+        arena_.resize(std::max<size_t>(arena_.size(), shape_plan->arena_size));
+        scratch_.resize(branches_);
+        quantized_scratch_.resize(branches_);
+        for (size_t lane = 0; lane < branches_; ++lane) {
+            scratch_[lane].resize(std::max<size_t>(scratch_[lane].size(), shape_plan->scratch));
+            quantized_scratch_[lane].resize(
+                std::max<size_t>(quantized_scratch_[lane].size(), shape_plan->quantized_scratch));
+        }
+    } catch (const std::bad_alloc&) {
+        shape_plan_.reset();
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::OutOfMemory,
+            "Failed to allocate execution context buffers"));
+    }
+
+    shape_plan_ = std::move(shape_plan);
+    values_.assign(graph_->values.size(), nullptr);
+    for (size_t v = 0; v < shape_plan_->offsets.size(); ++v) {
+        if (shape_plan_->offsets[v] >= 0) values_[v] = arena_.data() + shape_plan_->offsets[v];
+    }
+
+    return {};
+}
+
+atom::core::Result<std::vector<atom::core::Tensor>> ExecutionContext::Run(
+    const std::vector<atom::core::Tensor>& inputs, const std::shared_ptr<const ShapePlan>& shape_plan) {
+
+    if (inputs.size() != graph_->inputs.size()) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Input count does not match the graph"));
+    }
+
+    std::vector<Shape> input_shapes;
+    input_shapes.reserve(inputs.size());
+    for (const auto& input : inputs) {
+        if (input.GetDevice().type != atom::core::DeviceType::CPU ||
+            input.GetDataType() != atom::core::DataType::Float32) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+                "CPU backend expects float32 tensors in host memory"));
+        }
+        input_shapes.push_back(input.GetShape());
+    }
+
+    auto prepared = shape_plan && shape_plan->input_shapes == input_shapes ? Prepare(shape_plan)
+                                                                            : Prepare(input_shapes);
+    if (!prepared) return std::unexpected(prepared.error());
+
+    // Graph inputs are read in place
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        values_[graph_->inputs[i]] = static_cast<const f32*>(inputs[i].GetData());
+    }
+
+    if (observer_) {
+        // Observed runs stay sequential so the observer needs no locking
+        for (u32 input : graph_->inputs) Observe(input);
+        for (size_t i = 0; i < graph_->nodes.size(); ++i) {
+            RunNode(i);
+            for (u32 output : graph_->nodes[i].outputs) Observe(output);
+        }
+    } else if (branches_ > 1) {
+        RunBranches();
+    } else {
+        for (size_t i = 0; i < graph_->nodes.size(); ++i) {
+            RunNode(i);
+        }
+    }
+
+    std::vector<atom::core::Tensor> outputs;
+    outputs.reserve(graph_->outputs.size());
+    for (u32 output : graph_->outputs) {
+        auto tensor = atom::core::Tensor::Create(shape_plan_->shapes[output], atom::core::DataType::Float32);
+        if (!tensor) return std::unexpected(tensor.error());
+        std::memcpy(tensor->GetData(), values_[output], tensor->GetByteSize());
+        outputs.push_back(std::move(*tensor));
+    }
+
+    return outputs;
+}
+
+size_t ExecutionContext::GetMemoryUsage() const {
+    size_t bytes = arena_.capacity() * sizeof(f32);
+    for (size_t lane = 0; lane < scratch_.size(); ++lane) {
+        bytes += scratch_[lane].capacity() * sizeof(f32) + quantized_scratch_[lane].capacity();
+    }
+    return bytes;
+}
+
+void ExecutionContext::RunBranches() {
+    auto run = std::make_shared<BranchRun>();
+    run->pending = predecessor_counts_;
+    run->remaining = graph_->nodes.size();
+    for (size_t lane = branches_ - 1; lane > 0; --lane) run->free_lanes.push_back(lane);
+    for (u32 i = 0; i < run->pending.size(); ++i) {
+        if (run->pending[i] == 0) run->ready.push_back(i);
+    }
+
+    // The caller is lane 0 and stays until the graph is done, taking ready
+    // nodes itself whenever the pool has not picked them up yet
+    std::unique_lock lock(run->mutex);
+    SpawnBranches(run);
+    while (run->remaining > 0) {
+        if (run->ready.empty()) {
+            run->changed.wait(lock);
+            continue;
+        }
+        const u32 node = run->ready.back();
+        run->ready.pop_back();
+        lock.unlock();
+        RunNode(node, 0);
+        lock.lock();
+        CompleteNode(run, node);
+    }
+}
+
+void ExecutionContext::RunBranch(ExecutionContext* context, const std::shared_ptr<BranchRun>& run,
+                                 size_t lane) {
+    std::unique_lock lock(run->mutex);
+    while (!run->ready.empty()) {
+        const u32 node = run->ready.back();
+        run->ready.pop_back();
+        lock.unlock();
+        context->RunNode(node, lane);
+        lock.lock();
+        context->CompleteNode(run, node);
+    }
+    run->free_lanes.push_back(lane);
+}
+
+// Both below are called with run->mutex held
+void ExecutionContext::CompleteNode(const std::shared_ptr<BranchRun>& run, u32 node) {
+    for (u32 next : successors_[node]) {
+        if (--run->pending[next] == 0) run->ready.push_back(next);
+    }
+    --run->remaining;
+    SpawnBranches(run);
+    run->changed.notify_all();
+}
+
+void ExecutionContext::SpawnBranches(const std::shared_ptr<BranchRun>& run) {
+    // The current thread takes one ready node itself; free lanes take the rest
+    for (size_t extra = run->ready.empty() ? 0 : run->ready.size() - 1;
+         extra > 0 && !run->free_lanes.empty(); --extra) {
+        const size_t lane = run->free_lanes.back();
+        run->free_lanes.pop_back();
+        ComputePool()->Post([this, run, lane]() { RunBranch(this, run, lane); });
+    }
+}
+
+void ExecutionContext::Observe(u32 value) const {
+    observer_(value, values_[value], atom::core::ComputeSize(shape_plan_->shapes[value]));
+}
+
+void ExecutionContext::RunNode(size_t index, size_t lane) {
+    const auto& node = graph_->nodes[index];
+    const auto& a = node.attrs;
+    const u32 x = node.inputs[0];
+    const u32 y = node.outputs[0];
+    const f32* bias = Weight(node.bias);
+    const auto& shapes = shape_plan_->shapes;
+
+    if (const auto* quant = plan_->GetQuantParams(index)) {
+        const kernels::QuantizedWeights weights{plan_->GetWeight(node.weight).Int8(),
+                                                quant->weight_scales.data(), quant->weight_sums.data()};
+        const kernels::ActivationQuant input{quant->input_scale, quant->input_zero_point};
+        const auto& w = graph_->weights[node.weight].shape;
+        if (node.op == OpType::Conv2D) {
+            kernels::QConv2D(values_[x], shapes[x], weights, w, bias, input,
+                             Mutable(y), shapes[y], a, quantized_scratch_[lane].data(), parallel_);
+        } else {
+            kernels::QLinear(values_[x], weights, Mutable(y), shapes[x][0], w[0], w[1],
+                             bias, input, a.activation, quantized_scratch_[lane].data(), parallel_);
+        }
+        return;
+    }
+
+    const f32* weight = Weight(node.weight);
+
+    switch (node.op) {
+        case OpType::Conv2D:
+            kernels::Conv2D(values_[x], shapes[x], weight, graph_->weights[node.weight].shape, bias,
+                            Mutable(y), shapes[y], a, scratch_[lane].data(), config_, parallel_);
+            break;
+        case OpType::Gemm: {
+            const auto& w = graph_->weights[node.weight].shape;
+            kernels::Linear(values_[x], weight, Mutable(y), shapes[x][0], w[0], w[1],
+                            bias, a.activation, parallel_);
+            break;
+        }
+        case OpType::Add:
+        case OpType::Mul: {
+            const f32* rhs = weight ? weight : values_[node.inputs[1]];
+            const Shape& rhs_shape = weight ? graph_->weights[node.weight].shape : shapes[node.inputs[1]];
+            if (node.op == OpType::Add) {
+                kernels::Add(values_[x], shapes[x], rhs, rhs_shape, Mutable(y), a.activation);
+            } else {
+                kernels::Mul(values_[x], shapes[x], rhs, rhs_shape, Mutable(y), a.activation);
+            }
+            break;
+        }
+        case OpType::Relu:
+        case OpType::SiLU:
+        case OpType::Sigmoid: {
+            const i64 size = atom::core::ComputeSize(shapes[x]);
+            std::memcpy(Mutable(y), values_[x], size * sizeof(f32));
+            kernels::ApplyActivation(Mutable(y), size,
+                node.op == OpType::Relu ? Activation::Relu :
+                node.op == OpType::SiLU ? Activation::SiLU : Activation::Sigmoid);
+            break;
+        }
+        case OpType::MaxPool:
+            kernels::MaxPool(values_[x], shapes[x], Mutable(y), shapes[y], a, parallel_);
+            break;
+        case OpType::GlobalAvgPool:
+            kernels::GlobalAvgPool(values_[x], shapes[x], Mutable(y), parallel_);
+            break;
+        case OpType::Concat: {
+            std::vector<const f32*> parts;
+            std::vector<Shape> part_shapes;
+            for (u32 in : node.inputs) {
+                parts.push_back(values_[in]);
+                part_shapes.push_back(shapes[in]);
+            }
+            kernels::Concat(parts, part_shapes, a.axis, Mutable(y));
+            break;
+        }
+        case OpType::Split: {
+            std::vector<f32*> parts;
+            std::vector<Shape> part_shapes;
+            for (u32 out : node.outputs) {
+                parts.push_back(Mutable(out));
+                part_shapes.push_back(shapes[out]);
+            }
+            kernels::Split(values_[x], shapes[x], a.axis, parts, part_shapes);
+            break;
+        }
+        case OpType::Upsample:
+            kernels::UpsampleNearest(values_[x], shapes[x], a.scale, Mutable(y));
+            break;
+        case OpType::Softmax:
+            kernels::Softmax(values_[x], shapes[x], Mutable(y));
+            break;
+        case OpType::Flatten:
+            std::memcpy(Mutable(y), values_[x], atom::core::ComputeSize(shapes[x]) * sizeof(f32));
+            break;
+    }
+}
+
+} // namespace atom::inference::cpu
@@ -0,0 +1,374 @@
+#include "atom/inference/cpu/graph.hpp"
+#include "atom/inference/cpu/binary_io.hpp"
+#include <algorithm>
+#include <fstream>
+
+namespace atom::inference::cpu {
+
+namespace {
+
+constexpr char kGraphMagic[8] = {'A', 'T', 'O', 'M', 'G', 0, 0, 0};
+constexpr u32 kGraphVersion = 1;
+
+atom::core::Error ShapeError(const Node& node, const std::string& what) {
+    return ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+        std::string(OpTypeName(node.op)) + " '" + node.name + "': " + what);
+}
+
+// Numpy-style broadcast of two shapes
+std::optional<Shape> BroadcastShapes(const Shape& a, const Shape& b) {
+    const size_t rank = std::max(a.size(), b.size());
+    Shape out(rank);
+    for (size_t i = 0; i < rank; ++i) {
+        i64 da = i < rank - a.size() ? 1 : a[i - (rank - a.size())];
+        i64 db = i < rank - b.size() ? 1 : b[i - (rank - b.size())];
+        if (da != db && da != 1 && db != 1) return std::nullopt;
+        out[i] = std::max(da, db);
+    }
+    return out;
+}
+
+void WriteAttributes(BinaryWriter& writer, const OpAttributes& attrs) {
+    for (i32 v : attrs.kernel) writer.Write(v);
+    for (i32 v : attrs.stride) writer.Write(v);
+    for (i32 v : attrs.pad) writer.Write(v);
+    for (i32 v : attrs.dilation) writer.Write(v);
+    writer.Write(attrs.group);
+    writer.Write(attrs.axis);
+    writer.Write(attrs.scale);
+    writer.Write(static_cast<u32>(attrs.activation));
+    writer.WriteVector(attrs.split_sizes);
+}
+
+void ReadAttributes(BinaryReader& reader, OpAttributes& attrs) {
+    for (i32& v : attrs.kernel) reader.Read(v);
+    for (i32& v : attrs.stride) reader.Read(v);
+    for (i32& v : attrs.pad) reader.Read(v);
+    for (i32& v : attrs.dilation) reader.Read(v);
+    reader.Read(attrs.group);
+    reader.Read(attrs.axis);
+    reader.Read(attrs.scale);
+    u32 activation = 0;
+    reader.Read(activation);
+    attrs.activation = static_cast<Activation>(activation);
+    reader.ReadVector(attrs.split_sizes);
+}
+
+} // namespace
+
+void WriteNode(BinaryWriter& writer, const Node& node) {
+    writer.Write(static_cast<u32>(node.op));
+    writer.WriteVector(node.inputs);
+    writer.WriteVector(node.outputs);
+    writer.Write(node.weight);
+    writer.Write(node.bias);
+    writer.WriteString(node.name);
+    WriteAttributes(writer, node.attrs);
+}
+
+void ReadNode(BinaryReader& reader, Node& node) {
+    u32 op = 0;
+    reader.Read(op);
+    node.op = static_cast<OpType>(op);
+    reader.ReadVector(node.inputs);
+    reader.ReadVector(node.outputs);
+    reader.Read(node.weight);
+    reader.Read(node.bias);
+    reader.ReadString(node.name);
+    ReadAttributes(reader, node.attrs);
+}
+
+const char* OpTypeName(OpType op) {
+    switch (op) {
+        case OpType::Conv2D: return "Conv2D";
+        case OpType::Gemm: return "Gemm";
+        case OpType::Add: return "Add";
+        case OpType::Mul: return "Mul";
+        case OpType::Relu: return "Relu";
+        case OpType::SiLU: return "SiLU";
+        case OpType::Sigmoid: return "Sigmoid";
+        case OpType::MaxPool: return "MaxPool";
+        case OpType::GlobalAvgPool: return "GlobalAvgPool";
+        case OpType::Concat: return "Concat";
+        case OpType::Split: return "Split";
+        case OpType::Upsample: return "Upsample";
+        case OpType::Softmax: return "Softmax";
+        case OpType::Flatten: return "Flatten";
+        default: return "Unknown";
+    }
+}
+
+atom::core::Result<Graph> Graph::Load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::ModelNotFound,
+            "Cannot open model file: " + path));
+    }
+
+    BinaryReader reader(file);
+    char magic[8] = {};
+    reader.ReadBytes(magic, sizeof(magic));
+    u32 version = 0;
+    reader.Read(version);
+    if (!std::equal(std::begin(magic), std::end(magic), std::begin(kGraphMagic)) ||
+        version != kGraphVersion) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Not an atom graph file (or unsupported version): " + path));
+    }
+
+    Graph graph;
+    u32 count = 0;
+
+    reader.Read(count);
+    graph.values.resize(count);
+    for (auto& value : graph.values) {
+        reader.ReadString(value.name);
+        reader.ReadVector(value.shape);
+    }
+
+    reader.Read(count);
+    graph.weights.resize(count);
+    for (auto& weight : graph.weights) {
+        reader.ReadVector(weight.shape);
+        reader.ReadVector(weight.data);
+    }
+
+    reader.Read(count);
+    graph.nodes.resize(count);
+    for (auto& node : graph.nodes) {
+        ReadNode(reader, node);
+    }
+
+    reader.ReadVector(graph.inputs);
+    reader.ReadVector(graph.outputs);
+
+    if (!reader.Ok()) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Truncated model file: " + path));
+    }
+
+    auto valid = graph.Validate();
+    if (!valid) return std::unexpected(valid.error());
+
+    return graph;
+}
+
+atom::core::Result<void> Graph::Save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Cannot write model file: " + path));
+    }
+
+    BinaryWriter writer(file);
+    writer.WriteBytes(kGraphMagic, sizeof(kGraphMagic));
+    writer.Write(kGraphVersion);
+
+    writer.Write(static_cast<u32>(values.size()));
+    for (const auto& value : values) {
+        writer.WriteString(value.name);
+        writer.WriteVector(value.shape);
+    }
+
+    writer.Write(static_cast<u32>(weights.size()));
+    for (const auto& weight : weights) {
+        writer.WriteVector(weight.shape);
+        writer.WriteVector(weight.data);
+    }
+
+    writer.Write(static_cast<u32>(nodes.size()));
+    for (const auto& node : nodes) {
+        WriteNode(writer, node);
+    }
+
+    writer.WriteVector(inputs);
+    writer.WriteVector(outputs);
+
+    if (!writer.Ok()) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::Unknown,
+            "Failed writing model file: " + path));
+    }
+    return {};
+}
+
+atom::core::Result<void> Graph::Validate() const {
+    std::vector<bool> produced(values.size(), false);
+    for (u32 input : inputs) {
+        if (input >= values.size()) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+                "Graph input index out of range"));
+        }
+        produced[input] = true;
+    }
+
+    for (const auto& node : nodes) {
+        if (node.inputs.empty() || node.outputs.empty()) {
+            return std::unexpected(ShapeError(node, "node needs at least one input and output"));
+        }
+        for (u32 in : node.inputs) {
+            if (in >= values.size() || !produced[in]) {
+                return std::unexpected(ShapeError(node, "input used before it is produced"));
+            }
+        }
+        for (u32 out : node.outputs) {
+            if (out >= values.size() || produced[out]) {
+                return std::unexpected(ShapeError(node, "output index invalid or produced twice"));
+            }
+            produced[out] = true;
+        }
+        if (node.weight >= static_cast<i32>(weights.size()) ||
+            node.bias >= static_cast<i32>(weights.size())) {
+            return std::unexpected(ShapeError(node, "weight index out of range"));
+        }
+    }
+
+    for (u32 output : outputs) {
+        if (output >= values.size() || !produced[output]) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+                "Graph output is never produced"));
+        }
+    }
+    return {};
+}
+
+atom::core::Result<std::vector<Shape>> Graph::InferShapes(const std::vector<Shape>& input_shapes) const {
+    if (input_shapes.size() != inputs.size()) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Expected " + std::to_string(inputs.size()) + " graph inputs"));
+    }
+
+    std::vector<Shape> shapes(values.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        shapes[inputs[i]] = input_shapes[i];
+    }
+
+    for (const auto& node : nodes) {
+        if (node.inputs.empty()) {
+            return std::unexpected(ShapeError(node, "node has no inputs"));
+        }
+        const Shape& x = shapes[node.inputs[0]];
+        const auto& a = node.attrs;
+
+        switch (node.op) {
+            case OpType::Conv2D:
+            case OpType::MaxPool: {
+                if (x.size() != 4) return std::unexpected(ShapeError(node, "expects NCHW input"));
+                i64 channels = x[1];
+                i64 kh = a.kernel[0], kw = a.kernel[1];
+                if (node.op == OpType::Conv2D) {
+                    if (node.weight < 0) return std::unexpected(ShapeError(node, "missing weight"));
+                    const Shape& w = weights[node.weight].shape;
+                    if (w.size() != 4 || w[1] * a.group != x[1]) {
+                        return std::unexpected(ShapeError(node, "weight does not match input channels"));
+                    }
+                    channels = w[0];
+                    kh = w[2];
+                    kw = w[3];
+                }
+                i64 oh = (x[2] + a.pad[0] + a.pad[2] - a.dilation[0] * (kh - 1) - 1) / a.stride[0] + 1;
+                i64 ow = (x[3] + a.pad[1] + a.pad[3] - a.dilation[1] * (kw - 1) - 1) / a.stride[1] + 1;
+                if (oh <= 0 || ow <= 0) return std::unexpected(ShapeError(node, "output is empty"));
+                shapes[node.outputs[0]] = {x[0], channels, oh, ow};
+                break;
+            }
+            case OpType::Gemm: {
+                if (node.weight < 0) return std::unexpected(ShapeError(node, "missing weight"));
+                const Shape& w = weights[node.weight].shape;
+                if (x.size() != 2 || w.size() != 2 || w[1] != x[1]) {
+                    return std::unexpected(ShapeError(node, "expects [N,K] input and [M,K] weight"));
+                }
+                shapes[node.outputs[0]] = {x[0], w[0]};
+                break;
+            }
+            case OpType::Add:
+            case OpType::Mul: {
+                const Shape& y = node.weight >= 0 ? weights[node.weight].shape
+                    : node.inputs.size() > 1 ? shapes[node.inputs[1]] : Shape{};
+                auto out = BroadcastShapes(x, y);
+                if (!out || *out != x) {
+                    return std::unexpected(ShapeError(node, "second operand must broadcast to the first"));
+                }
+                shapes[node.outputs[0]] = *out;
+                break;
+            }
+            case OpType::Relu:
+            case OpType::SiLU:
+            case OpType::Sigmoid:
+            case OpType::Softmax:
+                shapes[node.outputs[0]] = x;
+                break;
+            case OpType::GlobalAvgPool:
+                if (x.size() != 4) return std::unexpected(ShapeError(node, "expects NCHW input"));
+                shapes[node.outputs[0]] = {x[0], x[1], 1, 1};
+                break;
+            case OpType::Concat: {
+                Shape out = x;
+                if (a.axis < 0 || a.axis >= static_cast<i32>(x.size())) {
+                    return std::unexpected(ShapeError(node, "axis out of range"));
+                }
+                for (size_t i = 1; i < node.inputs.size(); ++i) {
+                    const Shape& y = shapes[node.inputs[i]];
+                    if (y.size() != x.size()) return std::unexpected(ShapeError(node, "rank mismatch"));
+                    out[a.axis] += y[a.axis];
+                }
+                shapes[node.outputs[0]] = out;
+                break;
+            }
+            case OpType::Split: {
+                if (a.axis < 0 || a.axis >= static_cast<i32>(x.size()) ||
+                    a.split_sizes.size() != node.outputs.size()) {
+                    return std::unexpected(ShapeError(node, "invalid split"));
+                }
+                i64 total = 0;
+                for (size_t i = 0; i < node.outputs.size(); ++i) {
+                    Shape out = x;
+                    out[a.axis] = a.split_sizes[i];
+                    total += a.split_sizes[i];
+                    shapes[node.outputs[i]] = out;
+                }
+                if (total != x[a.axis]) return std::unexpected(ShapeError(node, "split sizes do not cover axis"));
+                break;
+            }
+            case OpType::Upsample:
+                if (x.size() != 4) return std::unexpected(ShapeError(node, "expects NCHW input"));
+                shapes[node.outputs[0]] = {x[0], x[1], x[2] * a.scale, x[3] * a.scale};
+                break;
+            case OpType::Flatten: {
+                i64 rest = 1;
+                for (size_t i = 1; i < x.size(); ++i) rest *= x[i];
+                shapes[node.outputs[0]] = {x[0], rest};
+                break;
+            }
+            default:
+                return std::unexpected(ShapeError(node, "unsupported operator"));
+        }
+    }
+
+    return shapes;
+}
+
+u64 Graph::Hash() const {
+    Fnv1a hash;
+    for (const auto& node : nodes) {
+        hash.Update(node.op);
+        hash.Update(node.inputs.data(), node.inputs.size() * sizeof(u32));
+        hash.Update(node.outputs.data(), node.outputs.size() * sizeof(u32));
+        hash.Update(node.weight);
+        hash.Update(node.bias);
+    }
+    for (const auto& weight : weights) {
+        hash.Update(weight.shape.data(), weight.shape.size() * sizeof(i64));
+        hash.Update(weight.data.data(), weight.data.size() * sizeof(f32));
+    }
+    return hash.Value();
+}
+
+size_t Graph::GetWeightBytes() const {
+    size_t bytes = 0;
+    for (const auto& weight : weights) {
+        bytes += weight.data.size() * sizeof(f32);
+    }
+    return bytes;
+}
+
+} // namespace atom::inference::cpu
@@ -0,0 +1,646 @@
+#include "atom/inference/cpu/kernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <utility>
+
+namespace atom::inference::cpu::kernels {
+
+namespace {
+
+constexpr i64 kBlockM = 64;
+constexpr i64 kBlockK = 256;
+constexpr i64 kTileM = kPanelRows;
+constexpr i64 kTileN = 16;
+
+// Smallest slices worth handing to another thread
+constexpr i64 kParallelRows = 4 * kPanelRows;
+constexpr i64 kParallelCols = 256;
+
+inline f32 Sigmoid(f32 x) {
+    return 1.0f / (1.0f + std::exp(-x));
+}
+
+i64 Product(const Shape& shape, size_t begin, size_t end) {
+    i64 result = 1;
+    for (size_t i = begin; i < end; ++i) result *= shape[i];
+    return result;
+}
+
+// Strides of rhs when broadcast onto lhs (0 along broadcast dimensions)
+std::vector<i64> BroadcastStrides(const Shape& lhs, const Shape& rhs) {
+    const size_t rank = lhs.size();
+    std::vector<i64> strides(rank, 0);
+    i64 stride = 1;
+    for (size_t i = rhs.size(); i-- > 0;) {
+        size_t dim = rank - rhs.size() + i;
+        strides[dim] = rhs[i] == 1 ? 0 : stride;
+        stride *= rhs[i];
+    }
+    return strides;
+}
+
+template<typename Op>
+void Elementwise(const f32* lhs, const Shape& lhs_shape, const f32* rhs, const Shape& rhs_shape,
+                 f32* output, Op op) {
+    const i64 size = atom::core::ComputeSize(lhs_shape);
+    const i64 rhs_size = atom::core::ComputeSize(rhs_shape);
+
+    if (rhs_size == size) {
+        for (i64 i = 0; i < size; ++i) output[i] = op(lhs[i], rhs[i]);
+        return;
+    }
+    if (rhs_size == 1) {
+        const f32 value = rhs[0];
+        for (i64 i = 0; i < size; ++i) output[i] = op(lhs[i], value);
+        return;
+    }
+
+    // General broadcast: walk the lhs index space and track the rhs offset
+    const size_t rank = lhs_shape.size();
+    const auto strides = BroadcastStrides(lhs_shape, rhs_shape);
+    const i64 inner = lhs_shape.back();
+    const i64 inner_stride = strides.back();
+    std::vector<i64> index(rank, 0);
+
+    for (i64 base = 0; base < size; base += inner) {
+        i64 rhs_offset = 0;
+        for (size_t d = 0; d + 1 < rank; ++d) rhs_offset += index[d] * strides[d];
+
+        for (i64 j = 0; j < inner; ++j) {
+            output[base + j] = op(lhs[base + j], rhs[rhs_offset + j * inner_stride]);
+        }
+
+        for (size_t d = rank - 1; d-- > 0;) {
+            if (++index[d] < lhs_shape[d]) break;
+            index[d] = 0;
+        }
+    }
+}
+
+void Im2Col(const f32* input, i64 channels, i64 height, i64 width,
+            i64 kh, i64 kw, const OpAttributes& attrs,
+            i64 out_h, i64 out_w, f32* col) {
+    const i64 out_size = out_h * out_w;
+    for (i64 c = 0; c < channels; ++c) {
+        const f32* plane = input + c * height * width;
+        for (i64 ki = 0; ki < kh; ++ki) {
+            for (i64 kj = 0; kj < kw; ++kj) {
+                f32* row = col + ((c * kh + ki) * kw + kj) * out_size;
+                for (i64 oy = 0; oy < out_h; ++oy) {
+                    const i64 iy = oy * attrs.stride[0] - attrs.pad[0] + ki * attrs.dilation[0];
+                    f32* dst = row + oy * out_w;
+                    if (iy < 0 || iy >= height) {
+                        std::fill(dst, dst + out_w, 0.0f);
+                        continue;
+                    }
+                    const f32* src = plane + iy * width;
+                    for (i64 ox = 0; ox < out_w; ++ox) {
+                        const i64 ix = ox * attrs.stride[1] - attrs.pad[1] + kj * attrs.dilation[1];
+                        dst[ox] = (ix >= 0 && ix < width) ? src[ix] : 0.0f;
+                    }
+                }
+            }
+        }
+    }
+}
+
+bool IsPointwise(const Shape& weight, const OpAttributes& attrs) {
+    return weight[2] == 1 && weight[3] == 1 &&
+           attrs.stride[0] == 1 && attrs.stride[1] == 1 &&
+           attrs.pad[0] == 0 && attrs.pad[1] == 0 && attrs.pad[2] == 0 && attrs.pad[3] == 0;
+}
+
+// Output indices o in [begin, end) with 0 <= o * stride + offset < limit
+std::pair<i64, i64> ValidRange(i64 offset, i64 stride, i64 limit, i64 count) {
+    const i64 begin = offset >= 0 ? 0 : (-offset + stride - 1) / stride;
+    const i64 end = limit - 1 - offset < 0 ? 0 : (limit - 1 - offset) / stride + 1;
+    return {std::min(begin, count), std::min(end, count)};
+}
+
+// Element (i, p) of a matrix packed by PackMatrixA
+inline f32 PackedAt(const f32* a, i64 k, i64 i, i64 p) {
+    return a[(i / kPanelRows) * kPanelRows * k + p * kPanelRows + i % kPanelRows];
+}
+
+// B and C are addressed with row strides so a thread can take a column block
+void MatMulBlocked(const f32* a, const f32* b, f32* c, i64 m, i64 n, i64 k,
+                   i64 ldb, i64 ldc, const f32* row_bias) {
+    for (i64 i = 0; i < m; ++i) {
+        std::fill(c + i * ldc, c + i * ldc + n, row_bias ? row_bias[i] : 0.0f);
+    }
+
+    // Blocked i-k-j order keeps a panel of B hot and vectorizes the inner loop
+    for (i64 i0 = 0; i0 < m; i0 += kBlockM) {
+        const i64 i1 = std::min(i0 + kBlockM, m);
+        for (i64 k0 = 0; k0 < k; k0 += kBlockK) {
+            const i64 k1 = std::min(k0 + kBlockK, k);
+            for (i64 i = i0; i < i1; ++i) {
+                f32* c_row = c + i * ldc;
+                for (i64 p = k0; p < k1; ++p) {
+                    const f32 a_ip = PackedAt(a, k, i, p);
+                    const f32* b_row = b + p * ldb;
+                    for (i64 j = 0; j < n; ++j) {
+                        c_row[j] += a_ip * b_row[j];
+                    }
+                }
+            }
+        }
+    }
+}
+
+void MatMulTiled(const f32* a, const f32* b, f32* c, i64 m, i64 n, i64 k,
+                 i64 ldb, i64 ldc, const f32* row_bias) {
+    // Each tile of C stays in registers for the whole K loop
+    for (i64 i0 = 0; i0 < m; i0 += kTileM) {
+        const i64 rows = std::min(kTileM, m - i0);
+        const f32* panel = a + i0 * k;
+        for (i64 j0 = 0; j0 < n; j0 += kTileN) {
+            const i64 cols = std::min(kTileN, n - j0);
+            f32 acc[kTileM][kTileN];
+            for (i64 r = 0; r < kTileM; ++r) {
+                std::fill(acc[r], acc[r] + kTileN, (row_bias && r < rows) ? row_bias[i0 + r] : 0.0f);
+            }
+
+            if (rows == kTileM && cols == kTileN) {
+                for (i64 p = 0; p < k; ++p) {
+                    const f32* b_row = b + p * ldb + j0;
+                    for (i64 r = 0; r < kTileM; ++r) {
+                        const f32 a_rp = panel[p * kTileM + r];
+                        for (i64 j = 0; j < kTileN; ++j) {
+                            acc[r][j] += a_rp * b_row[j];
+                        }
+                    }
+                }
+            } else {
+                for (i64 p = 0; p < k; ++p) {
+                    const f32* b_row = b + p * ldb + j0;
+                    for (i64 r = 0; r < rows; ++r) {
+                        const f32 a_rp = panel[p * kTileM + r];
+                        for (i64 j = 0; j < cols; ++j) {
+                            acc[r][j] += a_rp * b_row[j];
+                        }
+                    }
+                }
+            }
+
+            for (i64 r = 0; r < rows; ++r) {
+                std::memcpy(c + (i0 + r) * ldc + j0, acc[r], cols * sizeof(f32));
+            }
+        }
+    }
+}
+
+// Output channels [oc_begin, oc_end); weight is packed by PackMatrixA as
+// [out_c, in_c * kh * kw]
+void Conv2DDirect(const f32* input, i64 in_c, i64 in_h, i64 in_w,
+                  const f32* weight, i64 kh, i64 kw, const f32* bias,
+                  f32* output, i64 oc_begin, i64 oc_end, i64 out_h, i64 out_w,
+                  const OpAttributes& attrs) {
+    const i64 spatial = out_h * out_w;
+    const i64 sy = attrs.stride[0];
+    const i64 sx = attrs.stride[1];
+
+    for (i64 oc = oc_begin; oc < oc_end; ++oc) {
+        f32* plane = output + oc * spatial;
+        std::fill(plane, plane + spatial, bias ? bias[oc] : 0.0f);
+
+        for (i64 ic = 0; ic < in_c; ++ic) {
+            const f32* src = input + ic * in_h * in_w;
+            const i64 w_base = ic * kh * kw;
+            for (i64 ki = 0; ki < kh; ++ki) {
+                const auto [y0, y1] = ValidRange(ki * attrs.dilation[0] - attrs.pad[0], sy, in_h, out_h);
+                for (i64 kj = 0; kj < kw; ++kj) {
+                    const i64 x_offset = kj * attrs.dilation[1] - attrs.pad[1];
+                    const auto [x0, x1] = ValidRange(x_offset, sx, in_w, out_w);
+                    const f32 w_value = PackedAt(weight, in_c * kh * kw, oc, w_base + ki * kw + kj);
+                    for (i64 oy = y0; oy < y1; ++oy) {
+                        const f32* src_row = src + (oy * sy + ki * attrs.dilation[0] - attrs.pad[0]) * in_w + x_offset;
+                        f32* dst_row = plane + oy * out_w;
+                        if (sx == 1) {
+                            for (i64 ox = x0; ox < x1; ++ox) dst_row[ox] += w_value * src_row[ox];
+                        } else {
+                            for (i64 ox = x0; ox < x1; ++ox) dst_row[ox] += w_value * src_row[ox * sx];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Limit set by ATOM_CPU_ISA; none when unset
+CpuIsa IsaCap() {
+    const char* cap = std::getenv("ATOM_CPU_ISA");
+    if (!cap) return CpuIsa::Avx512Vnni;
+    const std::string_view name(cap);
+    return name == "generic" ? CpuIsa::Generic
+         : name == "avx2" ? CpuIsa::Avx2
+         : CpuIsa::Avx512Vnni;
+}
+
+} // namespace
+
+CpuIsa DetectCpuIsa() {
+    static const CpuIsa isa = [] {
+        CpuIsa best = CpuIsa::Generic;
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            best = CpuIsa::Avx2;
+        }
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+            __builtin_cpu_supports("avx512vnni")) {
+            best = CpuIsa::Avx512Vnni;
+        }
+#endif
+        return std::min(best, IsaCap());
+    }();
+    return isa;
+}
+
+bool HasAvx512F() {
+    static const bool available = [] {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx512f") && IsaCap() == CpuIsa::Avx512Vnni;
+#else
+        return false;
+#endif
+    }();
+    return available;
+}
+
+const char* KernelIsa() {
+#if defined(__AVX512F__)
+    constexpr const char* build = "x86-avx512";
+#elif defined(__AVX2__) && defined(__FMA__)
+    constexpr const char* build = "x86-avx2";
+#elif defined(__x86_64__)
+    constexpr const char* build = "x86-64";
+#elif defined(__aarch64__)
+    constexpr const char* build = "arm64";
+#else
+    constexpr const char* build = "generic";
+#endif
+    static const std::string name = [&] {
+        switch (DetectCpuIsa()) {
+            case CpuIsa::Avx512Vnni: return std::string(build) + "+vnni";
+            case CpuIsa::Avx2: return std::string(build) + "+avx2";
+            default: return std::string(build);
+        }
+    }();
+    return name.c_str();
+}
+
+i64 PackedMatrixSize(i64 m, i64 k) {
+    return (m + kPanelRows - 1) / kPanelRows * kPanelRows * k;
+}
+
+void PackMatrixA(const f32* a, i64 m, i64 k, f32* packed) {
+    for (i64 i0 = 0; i0 < m; i0 += kPanelRows) {
+        f32* panel = packed + i0 * k;
+        for (i64 p = 0; p < k; ++p) {
+            for (i64 r = 0; r < kPanelRows; ++r) {
+                panel[p * kPanelRows + r] = i0 + r < m ? a[(i0 + r) * k + p] : 0.0f;
+            }
+        }
+    }
+}
+
+i64 PackedConvWeightSize(const Shape& weight_shape, i32 group) {
+    const i64 group_out_c = weight_shape[0] / group;
+    const i64 k = weight_shape[1] * weight_shape[2] * weight_shape[3];
+    return group * PackedMatrixSize(group_out_c, k);
+}
+
+void PackConvWeights(const f32* weight, const Shape& weight_shape, i32 group, f32* packed) {
+    const i64 group_out_c = weight_shape[0] / group;
+    const i64 k = weight_shape[1] * weight_shape[2] * weight_shape[3];
+    for (i32 g = 0; g < group; ++g) {
+        PackMatrixA(weight + g * group_out_c * k, group_out_c, k,
+                    packed + g * PackedMatrixSize(group_out_c, k));
+    }
+}
+
+std::string KernelConfigName(const KernelConfig& config) {
+    std::string name = config.conv == ConvAlgorithm::Direct ? "direct" : "im2col";
+    name += config.gemm == GemmAlgorithm::Tiled ? "+tiled" : "+blocked";
+    return name;
+}
+
+std::optional<KernelConfig> ParseKernelConfig(std::string_view name) {
+    for (const auto& config : AllKernelConfigs()) {
+        if (KernelConfigName(config) == name) return config;
+    }
+    return std::nullopt;
+}
+
+std::vector<KernelConfig> AllKernelConfigs() {
+    return {
+        {ConvAlgorithm::Im2Col, GemmAlgorithm::Blocked},
+        {ConvAlgorithm::Im2Col, GemmAlgorithm::Tiled},
+        {ConvAlgorithm::Direct, GemmAlgorithm::Blocked},
+        {ConvAlgorithm::Direct, GemmAlgorithm::Tiled}
+    };
+}
+
+void ApplyActivation(f32* data, i64 size, Activation activation) {
+    switch (activation) {
+        case Activation::Relu:
+            for (i64 i = 0; i < size; ++i) data[i] = std::max(data[i], 0.0f);
+            break;
+        case Activation::SiLU:
+            for (i64 i = 0; i < size; ++i) data[i] = data[i] * Sigmoid(data[i]);
+            break;
+        case Activation::Sigmoid:
+            for (i64 i = 0; i < size; ++i) data[i] = Sigmoid(data[i]);
+            break;
+        case Activation::None:
+        default:
+            break;
+    }
+}
+
+void MatMul(const f32* a, const f32* b, f32* c, i64 m, i64 n, i64 k,
+            const f32* row_bias, Activation activation, GemmAlgorithm algorithm,
+            const Parallel& parallel) {
+    auto block = [&](i64 i0, i64 j0, i64 rows, i64 cols) {
+        f32* c_block = c + i0 * n + j0;
+        const f32* bias = row_bias ? row_bias + i0 : nullptr;
+        if (algorithm == GemmAlgorithm::Tiled) {
+            MatMulTiled(a + i0 * k, b + j0, c_block, rows, cols, k, n, n, bias);
+        } else {
+            MatMulBlocked(a + i0 * k, b + j0, c_block, rows, cols, k, n, n, bias);
+        }
+        for (i64 r = 0; r < rows; ++r) {
+            ApplyActivation(c_block + r * n, cols, activation);
+        }
+    };
+
+    if (parallel.Width() <= 1) {
+        block(0, 0, m, n);
+        return;
+    }
+
+    // Tasks are whole row panels by column blocks of C
+    const i64 row_blocks = (m + kParallelRows - 1) / kParallelRows;
+    const i64 col_blocks = (n + kParallelCols - 1) / kParallelCols;
+    parallel.For(row_blocks * col_blocks, 1, [&](i64 begin, i64 end) {
+        for (i64 t = begin; t < end; ++t) {
+            const i64 i0 = (t / col_blocks) * kParallelRows;
+            const i64 j0 = (t % col_blocks) * kParallelCols;
+            block(i0, j0, std::min(kParallelRows, m - i0), std::min(kParallelCols, n - j0));
+        }
+    });
+}
+
+void Linear(const f32* x, const f32* w_transposed, f32* y, i64 m, i64 n, i64 k,
+            const f32* bias, Activation activation, const Parallel& parallel) {
+    // Threads take blocks of output features across all rows
+    parallel.For(n, kParallelCols, [&](i64 j0, i64 j1) {
+        for (i64 i = 0; i < m; ++i) {
+            f32* y_row = y + i * n;
+            if (bias) {
+                std::memcpy(y_row + j0, bias + j0, (j1 - j0) * sizeof(f32));
+            } else {
+                std::fill(y_row + j0, y_row + j1, 0.0f);
+            }
+
+            const f32* x_row = x + i * k;
+            for (i64 p = 0; p < k; ++p) {
+                const f32 x_ip = x_row[p];
+                const f32* w_row = w_transposed + p * n;
+                for (i64 j = j0; j < j1; ++j) {
+                    y_row[j] += x_ip * w_row[j];
+                }
+            }
+            ApplyActivation(y_row + j0, j1 - j0, activation);
+        }
+    });
+}
+
+i64 Conv2DScratchSize(const Shape& input, const Shape& weight, const Shape& output,
+                      const OpAttributes& attrs) {
+    (void)input;
+    if (IsPointwise(weight, attrs)) return 0;
+    return weight[1] * weight[2] * weight[3] * output[2] * output[3];
+}
+
+void Conv2D(const f32* input, const Shape& input_shape,
+            const f32* packed_weight, const Shape& weight_shape, const f32* bias,
+            f32* output, const Shape& output_shape,
+            const OpAttributes& attrs, f32* scratch, const KernelConfig& config,
+            const Parallel& parallel) {
+    const i64 batch = input_shape[0];
+    const i64 in_c = input_shape[1];
+    const i64 in_h = input_shape[2];
+    const i64 in_w = input_shape[3];
+    const i64 out_c = output_shape[1];
+    const i64 out_h = output_shape[2];
+    const i64 out_w = output_shape[3];
+    const i64 kh = weight_shape[2];
+    const i64 kw = weight_shape[3];
+
+    const i64 groups = attrs.group;
+    const i64 group_in_c = in_c / groups;
+    const i64 group_out_c = out_c / groups;
+    const i64 k = group_in_c * kh * kw;
+    const i64 spatial = out_h * out_w;
+    const bool pointwise = IsPointwise(weight_shape, attrs);
+    const i64 group_weight_size = PackedMatrixSize(group_out_c, k);
+
+    auto direct = [&](i64 n, i64 g, i64 oc_begin, i64 oc_end) {
+        f32* group_output = output + n * out_c * spatial + g * group_out_c * spatial;
+        Conv2DDirect(input + (n * in_c + g * group_in_c) * in_h * in_w, group_in_c, in_h, in_w,
+                     packed_weight + g * group_weight_size, kh, kw,
+                     bias ? bias + g * group_out_c : nullptr,
+                     group_output, oc_begin, oc_end, out_h, out_w, attrs);
+        ApplyActivation(group_output + oc_begin * spatial, (oc_end - oc_begin) * spatial,
+                        attrs.activation);
+    };
+
+    // Many narrow groups (depthwise): whole groups go to threads, using the
+    // direct kernel so they need no shared im2col scratch
+    if (parallel.Width() > 1 && !pointwise && group_out_c < kParallelRows &&
+        groups >= static_cast<i64>(parallel.Width())) {
+        parallel.For(batch * groups, 1, [&](i64 begin, i64 end) {
+            for (i64 t = begin; t < end; ++t) direct(t / groups, t % groups, 0, group_out_c);
+        });
+        return;
+    }
+
+    for (i64 n = 0; n < batch; ++n) {
+        const f32* image = input + n * in_c * in_h * in_w;
+        f32* out_image = output + n * out_c * spatial;
+
+        for (i64 g = 0; g < groups; ++g) {
+            const f32* group_input = image + g * group_in_c * in_h * in_w;
+            f32* group_output = out_image + g * group_out_c * spatial;
+            const f32* group_weight = packed_weight + g * group_weight_size;
+            const f32* group_bias = bias ? bias + g * group_out_c : nullptr;
+
+            if (config.conv == ConvAlgorithm::Direct && !pointwise) {
+                parallel.For(group_out_c, 1, [&](i64 oc_begin, i64 oc_end) {
+                    direct(n, g, oc_begin, oc_end);
+                });
+                continue;
+            }
+
+            const f32* col = group_input;
+            if (!pointwise) {
+                // Threads unfold disjoint channel rows of the column matrix
+                const i64 rows_per_channel = kh * kw * spatial;
+                parallel.For(group_in_c, std::max<i64>(1, kParallelCols * kParallelRows / rows_per_channel),
+                             [&](i64 c_begin, i64 c_end) {
+                    Im2Col(group_input + c_begin * in_h * in_w, c_end - c_begin, in_h, in_w, kh, kw,
+                           attrs, out_h, out_w, scratch + c_begin * rows_per_channel);
+                });
+                col = scratch;
+            }
+
+            MatMul(group_weight, col, group_output, group_out_c, spatial, k,
+                   group_bias, attrs.activation, config.gemm, parallel);
+        }
+    }
+}
+
+void MaxPool(const f32* input, const Shape& input_shape,
+             f32* output, const Shape& output_shape, const OpAttributes& attrs,
+             const Parallel& parallel) {
+    const i64 planes = input_shape[0] * input_shape[1];
+    const i64 in_h = input_shape[2];
+    const i64 in_w = input_shape[3];
+    const i64 out_h = output_shape[2];
+    const i64 out_w = output_shape[3];
+
+    parallel.For(planes, 1, [&](i64 plane_begin, i64 plane_end) {
+        for (i64 p = plane_begin; p < plane_end; ++p) {
+            const f32* src = input + p * in_h * in_w;
+            f32* dst = output + p * out_h * out_w;
+            for (i64 oy = 0; oy < out_h; ++oy) {
+                for (i64 ox = 0; ox < out_w; ++ox) {
+                    f32 best = -std::numeric_limits<f32>::infinity();
+                    for (i64 ki = 0; ki < attrs.kernel[0]; ++ki) {
+                        const i64 iy = oy * attrs.stride[0] - attrs.pad[0] + ki * attrs.dilation[0];
+                        if (iy < 0 || iy >= in_h) continue;
+                        for (i64 kj = 0; kj < attrs.kernel[1]; ++kj) {
+                            const i64 ix = ox * attrs.stride[1] - attrs.pad[1] + kj * attrs.dilation[1];
+                            if (ix < 0 || ix >= in_w) continue;
+                            best = std::max(best, src[iy * in_w + ix]);
+                        }
+                    }
+                    dst[oy * out_w + ox] = best;
+                }
+            }
+        }
+    });
+}
+
+void GlobalAvgPool(const f32* input, const Shape& input_shape, f32* output,
+                   const Parallel& parallel) {
+    const i64 planes = input_shape[0] * input_shape[1];
+    const i64 spatial = input_shape[2] * input_shape[3];
+    const f32 scale = 1.0f / static_cast<f32>(spatial);
+
+    parallel.For(planes, std::max<i64>(1, kParallelCols * kParallelRows / spatial),
+                 [&](i64 plane_begin, i64 plane_end) {
+        for (i64 p = plane_begin; p < plane_end; ++p) {
+            const f32* src = input + p * spatial;
+            f32 sum = 0.0f;
+            for (i64 i = 0; i < spatial; ++i) sum += src[i];
+            output[p] = sum * scale;
+        }
+    });
+}
+
+void Add(const f32* lhs, const Shape& lhs_shape, const f32* rhs, const Shape& rhs_shape,
+         f32* output, Activation activation) {
+    Elementwise(lhs, lhs_shape, rhs, rhs_shape, output, [](f32 x, f32 y) { return x + y; });
+    ApplyActivation(output, atom::core::ComputeSize(lhs_shape), activation);
+}
+
+void Mul(const f32* lhs, const Shape& lhs_shape, const f32* rhs, const Shape& rhs_shape,
+         f32* output, Activation activation) {
+    Elementwise(lhs, lhs_shape, rhs, rhs_shape, output, [](f32 x, f32 y) { return x * y; });
+    ApplyActivation(output, atom::core::ComputeSize(lhs_shape), activation);
+}
+
+void Concat(const std::vector<const f32*>& inputs, const std::vector<Shape>& input_shapes,
+            i32 axis, f32* output) {
+    const Shape& first = input_shapes.front();
+    const i64 outer = Product(first, 0, axis);
+    const i64 inner = Product(first, axis + 1, first.size());
+
+    i64 out_axis = 0;
+    for (const auto& shape : input_shapes) out_axis += shape[axis];
+
+    for (i64 o = 0; o < outer; ++o) {
+        f32* dst = output + o * out_axis * inner;
+        for (size_t t = 0; t < inputs.size(); ++t) {
+            const i64 chunk = input_shapes[t][axis] * inner;
+            std::memcpy(dst, inputs[t] + o * chunk, chunk * sizeof(f32));
+            dst += chunk;
+        }
+    }
+}
+
+void Split(const f32* input, const Shape& input_shape, i32 axis,
+           const std::vector<f32*>& outputs, const std::vector<Shape>& output_shapes) {
+    const i64 outer = Product(input_shape, 0, axis);
+    const i64 inner = Product(input_shape, axis + 1, input_shape.size());
+    const i64 in_axis = input_shape[axis];
+
+    for (i64 o = 0; o < outer; ++o) {
+        const f32* src = input + o * in_axis * inner;
+        for (size_t t = 0; t < outputs.size(); ++t) {
+            const i64 chunk = output_shapes[t][axis] * inner;
+            std::memcpy(outputs[t] + o * chunk, src, chunk * sizeof(f32));
+            src += chunk;
+        }
+    }
+}
+
+void UpsampleNearest(const f32* input, const Shape& input_shape, i32 scale, f32* output) {
+    const i64 planes = input_shape[0] * input_shape[1];
+    const i64 in_h = input_shape[2];
+    const i64 in_w = input_shape[3];
+    const i64 out_w = in_w * scale;
+
+    for (i64 p = 0; p < planes; ++p) {
+        const f32* src = input + p * in_h * in_w;
+        f32* dst = output + p * in_h * scale * out_w;
+        for (i64 y = 0; y < in_h; ++y) {
+            f32* row = dst + y * scale * out_w;
+            for (i64 x = 0; x < in_w; ++x) {
+                std::fill(row + x * scale, row + (x + 1) * scale, src[y * in_w + x]);
+            }
+            for (i32 r = 1; r < scale; ++r) {
+                std::memcpy(row + r * out_w, row, out_w * sizeof(f32));
+            }
+        }
+    }
+}
+
+void Softmax(const f32* input, const Shape& shape, f32* output) {
+    const i64 inner = shape.back();
+    const i64 rows = atom::core::ComputeSize(shape) / inner;
+
+    for (i64 r = 0; r < rows; ++r) {
+        const f32* src = input + r * inner;
+        f32* dst = output + r * inner;
+        const f32 max_value = *std::max_element(src, src + inner);
+        f32 sum = 0.0f;
+        for (i64 i = 0; i < inner; ++i) {
+            dst[i] = std::exp(src[i] - max_value);
+            sum += dst[i];
+        }
+        const f32 inv = 1.0f / sum;
+        for (i64 i = 0; i < inner; ++i) dst[i] *= inv;
+    }
+}
+
+} // namespace atom::inference::cpu::kernels
@@ -0,0 +1,74 @@
+#include "atom/inference/cpu/parallel.hpp"
+#include "atom/scheduler/thread_pool.hpp"
+#include "atom/core/config.hpp"
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace atom::inference::cpu {
+
+namespace {
+
+// Chunk bookkeeping shared with helpers; helpers that start after the last
+// chunk was claimed find nothing to do and never touch the caller's body
+struct ForState {
+    std::atomic<atom::core::i64> next{0};
+    std::atomic<atom::core::i64> done{0};
+    atom::core::i64 chunks{0};
+    atom::core::i64 chunk_size{0};
+    atom::core::i64 count{0};
+    const std::function<void(atom::core::i64, atom::core::i64)>* body{nullptr};
+};
+
+void RunChunks(ForState& state) {
+    for (auto c = state.next.fetch_add(1); c < state.chunks; c = state.next.fetch_add(1)) {
+        const auto begin = c * state.chunk_size;
+        (*state.body)(begin, std::min(begin + state.chunk_size, state.count));
+        if (state.done.fetch_add(1) + 1 == state.chunks) {
+            state.done.notify_all();
+        }
+    }
+}
+
+} // namespace
+
+atom::scheduler::ThreadPool* ComputePool() {
+    static const std::unique_ptr<atom::scheduler::ThreadPool> pool = [] {
+        const size_t threads = ComputeThreadCount();
+        return threads > 1 ? std::make_unique<atom::scheduler::ThreadPool>(threads - 1) : nullptr;
+    }();
+    return pool.get();
+}
+
+size_t ComputeThreadCount() {
+    static const size_t threads = [] {
+        const auto configured = atom::core::Config::Instance().GetOr<int>(
+            atom::core::Config::KEY_CPU_THREADS, 0);
+        if (configured > 0) return static_cast<size_t>(configured);
+        return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }();
+    return threads;
+}
+
+void Parallel::Run(atom::core::i64 count, atom::core::i64 grain,
+                   const std::function<void(atom::core::i64, atom::core::i64)>& body) const {
+    // A few chunks per thread evens out uneven chunk costs
+    const auto target = static_cast<atom::core::i64>(width_) * 4;
+    auto state = std::make_shared<ForState>();
+    state->count = count;
+    state->chunk_size = std::max(grain, (count + target - 1) / target);
+    state->chunks = (count + state->chunk_size - 1) / state->chunk_size;
+    state->body = &body;
+
+    const auto helpers = std::min(static_cast<atom::core::i64>(width_) - 1, state->chunks - 1);
+    for (atom::core::i64 i = 0; i < helpers; ++i) {
+        pool_->Post([state]() { RunChunks(*state); });
+    }
+
+    RunChunks(*state);
+    for (auto done = state->done.load(); done < state->chunks; done = state->done.load()) {
+        state->done.wait(done);
+    }
+}
+
+} // namespace atom::inference::cpu
@@ -0,0 +1,685 @@
+#include "atom/inference/cpu/plan.hpp"
+#include "atom/inference/cpu/binary_io.hpp"
+#include "atom/inference/cpu/kernels.hpp"
+#include "atom/inference/cpu/quantization.hpp"
+#include "atom/inference/cpu/quantized_kernels.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+
+namespace atom::inference::cpu {
+
+namespace {
+
+constexpr char kPlanMagic[8] = {'A', 'T', 'O', 'M', 'P', 'L', 'A', 'N'};
+constexpr u32 kPlanVersion = 2;
+constexpr u64 kSectionAlignment = 4096;   // bytes; weights start on a page
+constexpr u64 kWeightAlignment = 64;      // bytes; every weight starts on a cache line
+constexpr i64 kValueAlignment = 16;       // floats; arena placement granularity
+
+struct PlanHeader {
+    char magic[8];
+    u32 version;
+    u32 panel_rows;
+    char isa[32];
+    u64 source_size;
+    i64 source_mtime;
+    u64 source_hash;
+    u64 meta_offset;
+    u64 meta_size;
+    u64 weights_offset;
+    u64 weights_size;
+};
+
+struct SourceInfo {
+    u64 size;
+    i64 mtime;
+};
+
+u64 AlignUp(u64 value, u64 alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+std::optional<SourceInfo> StatSource(const std::string& path) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec) return std::nullopt;
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec) return std::nullopt;
+    return SourceInfo{size, static_cast<i64>(mtime.time_since_epoch().count())};
+}
+
+atom::core::Error PlanError(const std::string& what) {
+    return ATOM_ERROR(atom::core::ErrorCode::InvalidArgument, what);
+}
+
+std::optional<Activation> AsActivation(OpType op) {
+    switch (op) {
+        case OpType::Relu: return Activation::Relu;
+        case OpType::SiLU: return Activation::SiLU;
+        case OpType::Sigmoid: return Activation::Sigmoid;
+        default: return std::nullopt;
+    }
+}
+
+// Folds a standalone activation into the Conv2D/Gemm/Add/Mul producing its
+// input when nothing else reads the intermediate value
+void FuseActivations(Graph& graph) {
+    std::vector<u32> uses(graph.values.size(), 0);
+    for (const auto& node : graph.nodes) {
+        for (u32 in : node.inputs) ++uses[in];
+    }
+    for (u32 out : graph.outputs) ++uses[out];
+
+    std::vector<i32> producer(graph.values.size(), -1);
+    std::vector<bool> removed(graph.nodes.size(), false);
+
+    for (size_t i = 0; i < graph.nodes.size(); ++i) {
+        auto& node = graph.nodes[i];
+        auto activation = AsActivation(node.op);
+        if (activation && uses[node.inputs[0]] == 1 && producer[node.inputs[0]] >= 0) {
+            auto& source = graph.nodes[producer[node.inputs[0]]];
+            const bool fusable = source.op == OpType::Conv2D || source.op == OpType::Gemm ||
+                                 source.op == OpType::Add || source.op == OpType::Mul;
+            if (fusable && source.attrs.activation == Activation::None && source.outputs.size() == 1) {
+                source.attrs.activation = *activation;
+                source.outputs[0] = node.outputs[0];
+                producer[node.outputs[0]] = producer[node.inputs[0]];
+                removed[i] = true;
+                continue;
+            }
+        }
+        for (u32 out : node.outputs) producer[out] = static_cast<i32>(i);
+    }
+
+    std::vector<Node> kept;
+    kept.reserve(graph.nodes.size());
+    for (size_t i = 0; i < graph.nodes.size(); ++i) {
+        if (!removed[i]) kept.push_back(std::move(graph.nodes[i]));
+    }
+    graph.nodes = std::move(kept);
+}
+
+std::vector<Shape> WithBatch(std::vector<Shape> shapes, i64 batch) {
+    for (auto& shape : shapes) shape[0] = batch;
+    return shapes;
+}
+
+void WriteMeta(BinaryWriter& writer, const Graph& graph, const std::vector<PackedWeight>& weights,
+               const std::vector<u64>& weight_offsets, const MemoryPlan& memory,
+               const std::vector<QuantParams>& quant) {
+    writer.Write(static_cast<u32>(graph.values.size()));
+    for (const auto& value : graph.values) {
+        writer.WriteString(value.name);
+        writer.WriteVector(value.shape);
+    }
+
+    writer.Write(static_cast<u32>(graph.weights.size()));
+    for (size_t i = 0; i < graph.weights.size(); ++i) {
+        writer.WriteVector(graph.weights[i].shape);
+        writer.Write(static_cast<u32>(weights[i].layout));
+        writer.Write(weight_offsets[i]);
+        writer.Write(weights[i].bytes);
+    }
+
+    writer.Write(static_cast<u32>(graph.nodes.size()));
+    for (const auto& node : graph.nodes) {
+        WriteNode(writer, node);
+    }
+    writer.WriteVector(graph.inputs);
+    writer.WriteVector(graph.outputs);
+
+    writer.Write(static_cast<u32>(memory.input_shapes.size()));
+    for (const auto& shape : memory.input_shapes) writer.WriteVector(shape);
+    writer.WriteVector(memory.offsets);
+    writer.Write(memory.arena_size);
+    writer.Write(static_cast<u8>(memory.per_sample));
+
+    const auto quantized = std::count_if(quant.begin(), quant.end(),
+                                         [](const QuantParams& q) { return q.IsQuantized(); });
+    writer.Write(static_cast<u32>(quantized));
+    for (size_t i = 0; i < quant.size(); ++i) {
+        if (!quant[i].IsQuantized()) continue;
+        writer.Write(static_cast<u32>(i));
+        writer.Write(quant[i].input_scale);
+        writer.Write(quant[i].input_zero_point);
+        writer.WriteVector(quant[i].weight_scales);
+        writer.WriteVector(quant[i].weight_sums);
+    }
+}
+
+i64 QuantizedGroupBytes(const Weight& weight, i64 groups) {
+    const i64 depth = atom::core::ComputeSize(weight.shape) / weight.shape[0];
+    return kernels::QuantizedRows(weight.shape[0] / groups) * kernels::QuantizedDepth(depth);
+}
+
+// Bytes Build stores for a weight in the given layout, or nothing when the
+// shape cannot take that layout or has more than limit elements
+std::optional<u64> PackedWeightBytes(const Weight& weight, WeightLayout layout, i64 group, u64 limit) {
+    const auto& shape = weight.shape;
+    u64 elements = 1;
+    for (i64 dim : shape) {
+        if (dim < 0 || (dim > 0 && elements > limit / static_cast<u64>(dim))) return std::nullopt;
+        elements *= static_cast<u64>(dim);
+    }
+
+    switch (layout) {
+        case WeightLayout::Plain:
+            return elements * sizeof(f32);
+        case WeightLayout::Transposed:
+            if (shape.size() != 2) return std::nullopt;
+            return elements * sizeof(f32);
+        case WeightLayout::ConvPanels:
+            if (shape.size() != 4 || group <= 0 || shape[0] % group != 0) return std::nullopt;
+            return kernels::PackedConvWeightSize(shape, static_cast<i32>(group)) * sizeof(f32);
+        case WeightLayout::Int8Rows:
+            if (shape.empty() || shape[0] <= 0 || group <= 0 || shape[0] % group != 0) return std::nullopt;
+            return group * QuantizedGroupBytes(weight, group);
+    }
+    return std::nullopt;
+}
+
+// Quantizes the weight of a Conv2D/Gemm node into s8 rows per group
+std::vector<f32> QuantizeNodeWeight(const Node& node, const Weight& weight, QuantParams& params) {
+    const i64 groups = node.op == OpType::Conv2D ? node.attrs.group : 1;
+    const i64 rows = weight.shape[0] / groups;
+    const i64 depth = atom::core::ComputeSize(weight.shape) / weight.shape[0];
+    const i64 group_bytes = QuantizedGroupBytes(weight, groups);
+
+    // Float storage keeps the int8 data as aligned as every other weight
+    std::vector<f32> storage((groups * group_bytes + sizeof(f32) - 1) / sizeof(f32));
+    auto* out = reinterpret_cast<i8*>(storage.data());
+    params.weight_scales.resize(weight.shape[0]);
+    params.weight_sums.resize(weight.shape[0]);
+
+    for (i64 g = 0; g < groups; ++g) {
+        kernels::QuantizeWeightRows(weight.data.data() + g * rows * depth, rows, depth,
+                                    out + g * group_bytes,
+                                    params.weight_scales.data() + g * rows,
+                                    params.weight_sums.data() + g * rows);
+    }
+    return storage;
+}
+
+} // namespace
+
+MemoryPlan PlanMemory(const Graph& graph, const std::vector<Shape>& shapes, bool concurrent) {
+    const size_t count = graph.values.size();
+    const size_t node_count = graph.nodes.size();
+    const i64 end_of_graph = static_cast<i64>(node_count);
+    std::vector<i64> first(count, -1);
+    std::vector<i64> last(count, -1);
+    std::vector<std::vector<u32>> readers(concurrent ? count : 0);
+
+    for (size_t i = 0; i < node_count; ++i) {
+        for (u32 in : graph.nodes[i].inputs) {
+            last[in] = static_cast<i64>(i);
+            if (concurrent) readers[in].push_back(static_cast<u32>(i));
+        }
+        for (u32 out : graph.nodes[i].outputs) {
+            first[out] = static_cast<i64>(i);
+            last[out] = std::max(last[out], static_cast<i64>(i));
+        }
+    }
+    for (u32 out : graph.outputs) last[out] = end_of_graph;
+
+    // reaches[i] has bit j set when node j (transitively) depends on node i
+    const size_t words = (node_count + 63) / 64;
+    std::vector<u64> reaches(concurrent ? node_count * words : 0, 0);
+    if (concurrent) {
+        for (size_t i = node_count; i-- > 0;) {
+            u64* row = reaches.data() + i * words;
+            for (u32 out : graph.nodes[i].outputs) {
+                for (u32 reader : readers[out]) {
+                    const u64* next = reaches.data() + reader * words;
+                    row[reader / 64] |= u64{1} << (reader % 64);
+                    for (size_t w = 0; w < words; ++w) row[w] |= next[w];
+                }
+            }
+        }
+    }
+    auto reaches_node = [&](i64 from, i64 to) {
+        return (reaches[from * words + to / 64] >> (to % 64)) & 1;
+    };
+    // Value a is dead before value b is produced, whatever the schedule
+    auto dead_before = [&](u32 a, u32 b) {
+        if (last[a] == end_of_graph) return false;
+        if (!reaches_node(first[a], first[b])) return false;
+        return std::all_of(readers[a].begin(), readers[a].end(),
+                           [&](u32 reader) { return reaches_node(reader, first[b]); });
+    };
+    auto overlaps = [&](u32 a, u32 b) {
+        if (!concurrent) return first[a] <= last[b] && first[b] <= last[a];
+        return !dead_before(a, b) && !dead_before(b, a);
+    };
+
+    struct Block {
+        u32 value;
+        i64 size;
+        i64 offset;
+    };
+    std::vector<Block> blocks;
+    for (u32 v = 0; v < count; ++v) {
+        if (first[v] >= 0) {
+            const i64 size = atom::core::ComputeSize(shapes[v]);
+            blocks.push_back({v, (size + kValueAlignment - 1) / kValueAlignment * kValueAlignment, 0});
+        }
+    }
+
+    // Largest first: big activations claim low offsets, small ones fill gaps
+    std::stable_sort(blocks.begin(), blocks.end(),
+                     [](const Block& a, const Block& b) { return a.size > b.size; });
+
+    MemoryPlan plan;
+    plan.offsets.assign(count, -1);
+    std::vector<const Block*> placed;
+    std::vector<const Block*> live;
+
+    for (auto& block : blocks) {
+        live.clear();
+        for (const Block* other : placed) {
+            if (overlaps(other->value, block.value)) {
+                live.push_back(other);
+            }
+        }
+        std::sort(live.begin(), live.end(),
+                  [](const Block* a, const Block* b) { return a->offset < b->offset; });
+
+        i64 offset = 0;
+        for (const Block* other : live) {
+            if (offset + block.size <= other->offset) break;
+            offset = std::max(offset, other->offset + other->size);
+        }
+
+        block.offset = offset;
+        plan.offsets[block.value] = offset;
+        plan.arena_size = std::max(plan.arena_size, offset + block.size);
+        placed.push_back(&block);
+    }
+
+    return plan;
+}
+
+atom::core::Result<std::shared_ptr<const Plan>> Plan::Compile(Graph graph,
+                                                              const CalibrationTable* calibration) {
+    auto valid = graph.Validate();
+    if (!valid) return std::unexpected(valid.error());
+
+    for (const auto& weight : graph.weights) {
+        if (static_cast<i64>(weight.data.size()) != atom::core::ComputeSize(weight.shape)) {
+            return std::unexpected(PlanError("Weight data does not match its shape"));
+        }
+    }
+
+    FuseActivations(graph);
+
+    std::vector<u32> consumers(graph.weights.size(), 0);
+    for (const auto& node : graph.nodes) {
+        if (node.weight >= 0) ++consumers[node.weight];
+    }
+
+    // A node runs in int8 when its input range was calibrated and it owns its weight
+    std::vector<QuantParams> quant(graph.nodes.size());
+    std::vector<i32> quant_node(graph.weights.size(), -1);
+    bool quantized = false;
+    if (calibration) {
+        for (size_t i = 0; i < graph.nodes.size(); ++i) {
+            const auto& node = graph.nodes[i];
+            const u32 x = node.inputs[0];
+            if ((node.op != OpType::Conv2D && node.op != OpType::Gemm) || node.weight < 0 ||
+                consumers[node.weight] != 1 || x >= calibration->ranges.size() ||
+                !calibration->ranges[x].IsValid()) {
+                continue;
+            }
+            const auto input = kernels::ChooseActivationQuant(calibration->ranges[x].min,
+                                                              calibration->ranges[x].max);
+            quant[i].input_scale = input.scale;
+            quant[i].input_zero_point = input.zero_point;
+            quant_node[node.weight] = static_cast<i32>(i);
+            quantized = true;
+        }
+    }
+
+    // Choose each weight's layout from the operator that consumes it
+    std::vector<std::optional<WeightLayout>> layouts(graph.weights.size());
+    std::vector<i32> groups(graph.weights.size(), 1);
+    for (const auto& node : graph.nodes) {
+        if (node.weight < 0) continue;
+        WeightLayout layout = quant_node[node.weight] >= 0 ? WeightLayout::Int8Rows
+                            : node.op == OpType::Conv2D ? WeightLayout::ConvPanels
+                            : node.op == OpType::Gemm ? WeightLayout::Transposed
+                            : WeightLayout::Plain;
+        auto& current = layouts[node.weight];
+        if ((current && *current != layout) ||
+            (layout == WeightLayout::ConvPanels && current && groups[node.weight] != node.attrs.group)) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::NotImplemented,
+                "Weight shared by operators needing different layouts"));
+        }
+        current = layout;
+        groups[node.weight] = node.attrs.group;
+    }
+
+    auto plan = std::make_shared<Plan>();
+    plan->weights_.resize(graph.weights.size());
+    plan->storage_.resize(graph.weights.size());
+
+    for (size_t i = 0; i < graph.weights.size(); ++i) {
+        auto& weight = graph.weights[i];
+        auto& storage = plan->storage_[i];
+        const auto layout = layouts[i].value_or(WeightLayout::Plain);
+        u64 bytes = 0;
+
+        switch (layout) {
+            case WeightLayout::Int8Rows: {
+                const i32 node = quant_node[i];
+                storage = QuantizeNodeWeight(graph.nodes[node], weight, quant[node]);
+                bytes = groups[i] * QuantizedGroupBytes(weight, groups[i]);
+                break;
+            }
+            case WeightLayout::ConvPanels:
+                storage.resize(kernels::PackedConvWeightSize(weight.shape, groups[i]));
+                kernels::PackConvWeights(weight.data.data(), weight.shape, groups[i], storage.data());
+                break;
+            case WeightLayout::Transposed: {
+                const i64 rows = weight.shape[0];
+                const i64 cols = weight.shape[1];
+                storage.resize(weight.data.size());
+                for (i64 r = 0; r < rows; ++r) {
+                    for (i64 c = 0; c < cols; ++c) {
+                        storage[c * rows + r] = weight.data[r * cols + c];
+                    }
+                }
+                break;
+            }
+            case WeightLayout::Plain:
+                storage = std::move(weight.data);
+                break;
+        }
+
+        if (layout != WeightLayout::Int8Rows) bytes = storage.size() * sizeof(f32);
+        weight.data = {};
+        plan->weights_[i] = {layout, storage.data(), bytes};
+    }
+
+    plan->graph_ = std::move(graph);
+    if (quantized) plan->quant_ = std::move(quant);
+    const auto& g = plan->graph_;
+
+    // Plan memory for the declared input shapes when only the batch is dynamic
+    std::vector<Shape> declared;
+    bool static_shapes = true;
+    for (u32 input : g.inputs) {
+        const auto& shape = g.values[input].shape;
+        static_shapes = static_shapes && !shape.empty() &&
+            std::all_of(shape.begin() + 1, shape.end(), [](i64 d) { return d > 0; });
+        declared.push_back(shape);
+    }
+
+    if (static_shapes) {
+        auto single = g.InferShapes(WithBatch(declared, 1));
+        if (!single) return std::unexpected(single.error());
+        auto pair = g.InferShapes(WithBatch(declared, 2));
+        if (!pair) return std::unexpected(pair.error());
+
+        plan->memory_ = PlanMemory(g, *single);
+        plan->memory_.input_shapes = WithBatch(declared, 1);
+        plan->memory_.per_sample = true;
+        for (size_t v = 0; v < single->size(); ++v) {
+            if (plan->memory_.offsets[v] >= 0 &&
+                atom::core::ComputeSize((*pair)[v]) != 2 * atom::core::ComputeSize((*single)[v])) {
+                plan->memory_.per_sample = false;
+                break;
+            }
+        }
+    }
+
+    return std::shared_ptr<const Plan>(std::move(plan));
+}
+
+atom::core::Result<std::shared_ptr<const Plan>> Plan::Load(
+    const std::string& plan_path, const std::optional<std::string>& model_path) {
+
+    auto mapping = atom::core::MappedFile::Open(plan_path);
+    if (!mapping) return std::unexpected(mapping.error());
+
+    const auto* base = mapping->GetData();
+    const u64 file_size = mapping->GetSize();
+
+    PlanHeader header{};
+    if (file_size < sizeof(header)) {
+        return std::unexpected(PlanError("Truncated plan file: " + plan_path));
+    }
+    std::memcpy(&header, base, sizeof(header));
+
+    if (!std::equal(std::begin(kPlanMagic), std::end(kPlanMagic), header.magic) ||
+        header.version != kPlanVersion) {
+        return std::unexpected(PlanError("Not a plan file (or unsupported version): " + plan_path));
+    }
+    if (header.panel_rows != kernels::kPanelRows ||
+        std::strncmp(header.isa, kernels::KernelIsa(), sizeof(header.isa)) != 0) {
+        return std::unexpected(PlanError("Plan was built for a different kernel ISA: " + plan_path));
+    }
+
+    if (model_path) {
+        // Size and mtime match is the fast path; otherwise fall back to the content hash
+        auto info = StatSource(*model_path);
+        if (!info) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::ModelNotFound,
+                "Cannot stat model file: " + *model_path));
+        }
+        if (info->size != header.source_size || info->mtime != header.source_mtime) {
+            auto hash = HashFile(*model_path);
+            if (!hash || *hash != header.source_hash) {
+                return std::unexpected(PlanError("Plan is stale for model: " + *model_path));
+            }
+        }
+    }
+
+    if (header.meta_size > file_size || header.meta_offset > file_size - header.meta_size ||
+        header.weights_size > file_size || header.weights_offset > file_size - header.weights_size ||
+        header.weights_offset % kSectionAlignment != 0) {
+        return std::unexpected(PlanError("Corrupt plan file: " + plan_path));
+    }
+
+    MemoryStreamBuf buffer(base + header.meta_offset, header.meta_size);
+    std::istream stream(&buffer);
+    BinaryReader reader(stream);
+
+    auto plan = std::make_shared<Plan>();
+    auto& graph = plan->graph_;
+    const auto* weight_base = base + header.weights_offset;
+    u32 count = 0;
+
+    reader.Read(count);
+    graph.values.resize(reader.Ok() ? count : 0);
+    for (auto& value : graph.values) {
+        reader.ReadString(value.name);
+        reader.ReadVector(value.shape);
+    }
+
+    reader.Read(count);
+    graph.weights.resize(reader.Ok() ? count : 0);
+    plan->weights_.resize(graph.weights.size());
+    for (size_t i = 0; i < graph.weights.size(); ++i) {
+        u32 layout = 0;
+        u64 offset = 0;
+        auto& weight = plan->weights_[i];
+        reader.ReadVector(graph.weights[i].shape);
+        reader.Read(layout);
+        reader.Read(offset);
+        reader.Read(weight.bytes);
+        if (offset > header.weights_size || weight.bytes > header.weights_size - offset ||
+            offset % kWeightAlignment != 0 || layout > static_cast<u32>(WeightLayout::Int8Rows)) {
+            return std::unexpected(PlanError("Corrupt plan weights: " + plan_path));
+        }
+        weight.layout = static_cast<WeightLayout>(layout);
+        weight.data = weight_base + offset;
+    }
+
+    reader.Read(count);
+    graph.nodes.resize(reader.Ok() ? count : 0);
+    for (auto& node : graph.nodes) {
+        ReadNode(reader, node);
+    }
+    reader.ReadVector(graph.inputs);
+    reader.ReadVector(graph.outputs);
+
+    auto& memory = plan->memory_;
+    reader.Read(count);
+    memory.input_shapes.resize(reader.Ok() ? count : 0);
+    for (auto& shape : memory.input_shapes) reader.ReadVector(shape);
+    reader.ReadVector(memory.offsets);
+    reader.Read(memory.arena_size);
+    u8 per_sample = 0;
+    reader.Read(per_sample);
+    memory.per_sample = per_sample != 0;
+
+    reader.Read(count);
+    if (reader.Ok() && count > 0) {
+        plan->quant_.resize(graph.nodes.size());
+    }
+    for (u32 i = 0; reader.Ok() && i < count; ++i) {
+        u32 node = 0;
+        reader.Read(node);
+        if (!reader.Ok() || node >= graph.nodes.size()) {
+            return std::unexpected(PlanError("Corrupt plan quantization: " + plan_path));
+        }
+        auto& params = plan->quant_[node];
+        reader.Read(params.input_scale);
+        reader.Read(params.input_zero_point);
+        reader.ReadVector(params.weight_scales);
+        reader.ReadVector(params.weight_sums);
+        const auto& weight = graph.nodes[node].weight;
+        if (weight < 0 || static_cast<size_t>(weight) >= graph.weights.size() ||
+            graph.weights[weight].shape.empty() ||
+            params.weight_scales.size() != static_cast<u64>(graph.weights[weight].shape[0]) ||
+            params.weight_sums.size() != params.weight_scales.size() ||
+            plan->weights_[weight].layout != WeightLayout::Int8Rows) {
+            return std::unexpected(PlanError("Corrupt plan quantization: " + plan_path));
+        }
+    }
+
+    if (!reader.Ok()) {
+        return std::unexpected(PlanError("Truncated plan file: " + plan_path));
+    }
+    if (!memory.offsets.empty() && memory.offsets.size() != graph.values.size()) {
+        return std::unexpected(PlanError("Corrupt plan memory layout: " + plan_path));
+    }
+
+    auto valid = graph.Validate();
+    if (!valid) return std::unexpected(valid.error());
+
+    // Every weight must have the layout and size Build gives it for its consumers
+    std::vector<bool> consumed(graph.weights.size(), false);
+    for (size_t i = 0; i < graph.nodes.size(); ++i) {
+        const auto& node = graph.nodes[i];
+        if (node.weight < 0) continue;
+        const bool quantized = !plan->quant_.empty() && plan->quant_[i].IsQuantized();
+        const WeightLayout layout = quantized ? WeightLayout::Int8Rows
+                                  : node.op == OpType::Conv2D ? WeightLayout::ConvPanels
+                                  : node.op == OpType::Gemm ? WeightLayout::Transposed
+                                  : WeightLayout::Plain;
+        const i64 group = node.op == OpType::Conv2D ? node.attrs.group : 1;
+        const auto& packed = plan->weights_[node.weight];
+        auto bytes = PackedWeightBytes(graph.weights[node.weight], layout, group, header.weights_size);
+        if (packed.layout != layout || !bytes || *bytes != packed.bytes) {
+            return std::unexpected(PlanError("Corrupt plan weights: " + plan_path));
+        }
+        consumed[node.weight] = true;
+    }
+    for (size_t i = 0; i < graph.weights.size(); ++i) {
+        if (consumed[i]) continue;
+        auto bytes = PackedWeightBytes(graph.weights[i], WeightLayout::Plain, 1, header.weights_size);
+        if (plan->weights_[i].layout != WeightLayout::Plain || !bytes || *bytes != plan->weights_[i].bytes) {
+            return std::unexpected(PlanError("Corrupt plan weights: " + plan_path));
+        }
+    }
+
+    plan->mapping_ = std::move(*mapping);
+    return std::shared_ptr<const Plan>(std::move(plan));
+}
+
+atom::core::Result<void> Plan::Save(const std::string& plan_path, const std::string& model_path) const {
+    auto info = StatSource(model_path);
+    auto hash = HashFile(model_path);
+    if (!info || !hash) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::ModelNotFound,
+            "Cannot read model file: " + model_path));
+    }
+
+    std::vector<u64> weight_offsets(weights_.size());
+    u64 weight_bytes = 0;
+    for (size_t i = 0; i < weights_.size(); ++i) {
+        weight_offsets[i] = weight_bytes;
+        weight_bytes = AlignUp(weight_bytes + weights_[i].bytes, kWeightAlignment);
+    }
+
+    std::ostringstream meta;
+    BinaryWriter meta_writer(meta);
+    WriteMeta(meta_writer, graph_, weights_, weight_offsets, memory_, quant_);
+    const std::string meta_bytes = meta.str();
+
+    PlanHeader header{};
+    std::memcpy(header.magic, kPlanMagic, sizeof(kPlanMagic));
+    header.version = kPlanVersion;
+    header.panel_rows = static_cast<u32>(kernels::kPanelRows);
+    std::strncpy(header.isa, kernels::KernelIsa(), sizeof(header.isa) - 1);
+    header.source_size = info->size;
+    header.source_mtime = info->mtime;
+    header.source_hash = *hash;
+    header.meta_offset = sizeof(PlanHeader);
+    header.meta_size = meta_bytes.size();
+    header.weights_offset = AlignUp(header.meta_offset + header.meta_size, kSectionAlignment);
+    header.weights_size = weight_bytes;
+
+    // Write then rename so a concurrent loader never maps a partial file
+    const std::string temp_path = plan_path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return std::unexpected(PlanError("Cannot write plan file: " + temp_path));
+        }
+
+        BinaryWriter writer(file);
+        const std::vector<char> zeros(kSectionAlignment, 0);
+        writer.Write(header);
+        writer.WriteBytes(meta_bytes.data(), meta_bytes.size());
+        writer.WriteBytes(zeros.data(), header.weights_offset - header.meta_offset - header.meta_size);
+
+        u64 written = 0;
+        for (size_t i = 0; i < weights_.size(); ++i) {
+            writer.WriteBytes(zeros.data(), weight_offsets[i] - written);
+            writer.WriteBytes(weights_[i].data, weights_[i].bytes);
+            written = weight_offsets[i] + weights_[i].bytes;
+        }
+        writer.WriteBytes(zeros.data(), weight_bytes - written);
+
+        if (!writer.Ok()) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::Unknown,
+                "Failed writing plan file: " + temp_path));
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, plan_path, ec);
+    if (ec) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::Unknown,
+            "Failed to replace plan file: " + ec.message()));
+    }
+    return {};
+}
+
+const QuantParams* Plan::GetQuantParams(size_t node) const {
+    return node < quant_.size() && quant_[node].IsQuantized() ? &quant_[node] : nullptr;
+}
+
+size_t Plan::GetWeightBytes() const {
+    size_t bytes = 0;
+    for (const auto& weight : weights_) {
+        bytes += weight.bytes;
+    }
+    return bytes;
+}
+
+} // namespace atom::inference::cpu
@@ -0,0 +1,112 @@
+#include "atom/inference/cpu/quantization.hpp"
+#include "atom/inference/cpu/execution_context.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace atom::inference::cpu {
+
+void ValueRange::Observe(const f32* data, i64 size) {
+    for (i64 i = 0; i < size; ++i) {
+        min = std::min(min, data[i]);
+        max = std::max(max, data[i]);
+    }
+}
+
+atom::core::Result<CalibrationTable> CollectActivationRanges(
+    const std::shared_ptr<const Plan>& float_plan,
+    const std::vector<std::vector<atom::core::Tensor>>& dataset) {
+
+    if (!float_plan || float_plan->IsQuantized()) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Calibration needs a float plan"));
+    }
+    if (dataset.empty()) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Calibration dataset is empty"));
+    }
+
+    CalibrationTable table;
+    table.ranges.resize(float_plan->GetGraph().values.size());
+
+    ExecutionContext context(float_plan);
+    context.SetValueObserver([&table](u32 value, const f32* data, i64 size) {
+        table.ranges[value].Observe(data, size);
+    });
+
+    for (const auto& inputs : dataset) {
+        auto outputs = context.Run(inputs);
+        if (!outputs) return std::unexpected(outputs.error());
+        ++table.samples;
+    }
+    return table;
+}
+
+atom::core::Result<QuantizationReport> EvaluateQuantization(
+    const std::shared_ptr<const Plan>& float_plan,
+    const std::shared_ptr<const Plan>& quantized_plan,
+    const std::vector<std::vector<atom::core::Tensor>>& dataset) {
+
+    if (!float_plan || !quantized_plan) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Both plans are required"));
+    }
+
+    QuantizationReport report;
+    const auto& nodes = quantized_plan->GetGraph().nodes;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].op == OpType::Conv2D || nodes[i].op == OpType::Gemm) {
+            ++report.quantizable_nodes;
+            if (quantized_plan->GetQuantParams(i)) ++report.quantized_nodes;
+        }
+    }
+
+    ExecutionContext reference(float_plan);
+    ExecutionContext quantized(quantized_plan);
+    f64 signal = 0.0;
+    f64 noise = 0.0;
+    f64 error_sum = 0.0;
+    u64 elements = 0;
+    u64 rows = 0;
+    u64 agreeing_rows = 0;
+
+    for (const auto& inputs : dataset) {
+        auto expected = reference.Run(inputs);
+        if (!expected) return std::unexpected(expected.error());
+        auto actual = quantized.Run(inputs);
+        if (!actual) return std::unexpected(actual.error());
+
+        for (size_t o = 0; o < expected->size(); ++o) {
+            const auto* e = static_cast<const f32*>((*expected)[o].GetData());
+            const auto* a = static_cast<const f32*>((*actual)[o].GetData());
+            const i64 size = static_cast<i64>((*expected)[o].GetSize());
+            for (i64 i = 0; i < size; ++i) {
+                const f64 diff = std::fabs(static_cast<f64>(e[i]) - a[i]);
+                report.max_abs_error = std::max(report.max_abs_error, diff);
+                error_sum += diff;
+                signal += static_cast<f64>(e[i]) * e[i];
+                noise += diff * diff;
+            }
+            elements += size;
+
+            if (o == 0 && !(*expected)[o].GetShape().empty()) {
+                const i64 width = (*expected)[o].GetShape().back();
+                for (i64 row = 0; width > 0 && row < size / width; ++row) {
+                    const f32* er = e + row * width;
+                    const f32* ar = a + row * width;
+                    agreeing_rows += std::max_element(er, er + width) - er ==
+                                     std::max_element(ar, ar + width) - ar;
+                    ++rows;
+                }
+            }
+        }
+        ++report.samples;
+    }
+
+    report.mean_abs_error = elements ? error_sum / static_cast<f64>(elements) : 0.0;
+    report.snr_db = noise > 0.0 ? 10.0 * std::log10(signal / noise)
+                                : std::numeric_limits<f64>::infinity();
+    report.top1_agreement = rows ? static_cast<f64>(agreeing_rows) / static_cast<f64>(rows) : 1.0;
+    return report;
+}
+
+} // namespace atom::inference::cpu
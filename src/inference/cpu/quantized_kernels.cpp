@@ -0,0 +1,336 @@
+#include "atom/inference/cpu/quantized_kernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define ATOM_X86_KERNELS 1
+#endif
+
+namespace atom::inference::cpu::kernels {
+
+namespace {
+
+constexpr i64 kQTileM = 4;
+constexpr i64 kQTileN = 32;
+constexpr i64 kDepthGroup = 4;   // u8/s8 products summed per int32 lane
+
+using Tile = i32[kQTileM][kQTileN];
+
+// Where and how a GEMM tile is written back as float
+struct Epilogue {
+    const f32* scales;
+    const i32* sums;
+    const f32* bias;
+    f32 input_scale;
+    i32 zero_point;
+    f32* output;
+    i64 row_stride;
+    i64 col_stride;
+    i64 rows;
+    i64 cols;
+};
+
+i64 RoundUp(i64 value, i64 multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+inline u8 Quantize(f32 value, f32 inv_scale, f32 zero_point, f32 max_code) {
+    const f32 q = std::min(std::max(value * inv_scale + zero_point, 0.0f), max_code);
+    return static_cast<u8>(q + 0.5f);
+}
+
+void QuantizeActivations(const f32* input, i64 size, ActivationQuant quant, u8* output) {
+    const f32 inv_scale = 1.0f / quant.scale;
+    const f32 zero_point = static_cast<f32>(quant.zero_point);
+    const f32 max_code = static_cast<f32>(ActivationQuantMax());
+    for (i64 i = 0; i < size; ++i) {
+        output[i] = Quantize(input[i], inv_scale, zero_point, max_code);
+    }
+}
+
+// B is [depth / 4][cols][4]: four consecutive depth entries per column are
+// adjacent so one 32-bit lane feeds a whole dot-product group
+inline i64 PackedIndex(i64 p, i64 col, i64 padded_cols) {
+    return (p / kDepthGroup) * padded_cols * kDepthGroup + col * kDepthGroup + p % kDepthGroup;
+}
+
+void TileGeneric(const i8* a, const u8* b, i64 padded_cols, i64 depth, i64 n0, Tile& acc) {
+    for (auto& row : acc) std::fill(std::begin(row), std::end(row), 0);
+    for (i64 kb = 0; kb < depth; kb += kDepthGroup) {
+        const u8* b_block = b + kb * padded_cols + n0 * kDepthGroup;
+        for (i64 r = 0; r < kQTileM; ++r) {
+            const i8* a_group = a + r * depth + kb;
+            for (i64 c = 0; c < kQTileN; ++c) {
+                const u8* b_group = b_block + c * kDepthGroup;
+                acc[r][c] += a_group[0] * b_group[0] + a_group[1] * b_group[1] +
+                             a_group[2] * b_group[2] + a_group[3] * b_group[3];
+            }
+        }
+    }
+}
+
+#ifdef ATOM_X86_KERNELS
+
+inline i32 LoadGroup(const i8* a) {
+    i32 value;
+    std::memcpy(&value, a, sizeof(value));
+    return value;
+}
+
+__attribute__((target("avx2,fma")))
+void TileAvx2(const i8* a, const u8* b, i64 padded_cols, i64 depth, i64 n0, Tile& acc) {
+    const __m256i ones = _mm256_set1_epi16(1);
+    for (i64 half = 0; half < kQTileN; half += 16) {
+        __m256i c[kQTileM][2];
+        for (auto& row : c) row[0] = row[1] = _mm256_setzero_si256();
+
+        for (i64 kb = 0; kb < depth; kb += kDepthGroup) {
+            const u8* b_block = b + kb * padded_cols + (n0 + half) * kDepthGroup;
+            const __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b_block));
+            const __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b_block + 32));
+            for (i64 r = 0; r < kQTileM; ++r) {
+                const __m256i a_group = _mm256_set1_epi32(LoadGroup(a + r * depth + kb));
+                c[r][0] = _mm256_add_epi32(c[r][0], _mm256_madd_epi16(_mm256_maddubs_epi16(b0, a_group), ones));
+                c[r][1] = _mm256_add_epi32(c[r][1], _mm256_madd_epi16(_mm256_maddubs_epi16(b1, a_group), ones));
+            }
+        }
+
+        for (i64 r = 0; r < kQTileM; ++r) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&acc[r][half]), c[r][0]);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&acc[r][half + 8]), c[r][1]);
+        }
+    }
+}
+
+__attribute__((target("avx512f,avx512bw,avx512vnni")))
+void TileVnni(const i8* a, const u8* b, i64 padded_cols, i64 depth, i64 n0, Tile& acc) {
+    __m512i c[kQTileM][2];
+    for (auto& row : c) row[0] = row[1] = _mm512_setzero_si512();
+
+    for (i64 kb = 0; kb < depth; kb += kDepthGroup) {
+        const u8* b_block = b + kb * padded_cols + n0 * kDepthGroup;
+        const __m512i b0 = _mm512_loadu_si512(b_block);
+        const __m512i b1 = _mm512_loadu_si512(b_block + 64);
+        for (i64 r = 0; r < kQTileM; ++r) {
+            const __m512i a_group = _mm512_set1_epi32(LoadGroup(a + r * depth + kb));
+            c[r][0] = _mm512_dpbusd_epi32(c[r][0], b0, a_group);
+            c[r][1] = _mm512_dpbusd_epi32(c[r][1], b1, a_group);
+        }
+    }
+
+    for (i64 r = 0; r < kQTileM; ++r) {
+        _mm512_storeu_si512(&acc[r][0], c[r][0]);
+        _mm512_storeu_si512(&acc[r][16], c[r][1]);
+    }
+}
+
+#endif
+
+using TileFunc = void (*)(const i8*, const u8*, i64, i64, i64, Tile&);
+
+TileFunc SelectTile() {
+#ifdef ATOM_X86_KERNELS
+    switch (DetectCpuIsa()) {
+        case CpuIsa::Avx512Vnni: return TileVnni;
+        case CpuIsa::Avx2: return TileAvx2;
+        default: break;
+    }
+#endif
+    return TileGeneric;
+}
+
+void StoreTile(const Tile& acc, i64 i0, i64 n0, const Epilogue& ep) {
+    const i64 cols = std::min(kQTileN, ep.cols - n0);
+    for (i64 r = 0; r < kQTileM && i0 + r < ep.rows; ++r) {
+        const i64 i = i0 + r;
+        const f32 scale = ep.input_scale * ep.scales[i];
+        const i32 correction = ep.zero_point * ep.sums[i];
+        const f32 bias = ep.bias ? ep.bias[i] : 0.0f;
+        f32* out = ep.output + i * ep.row_stride + n0 * ep.col_stride;
+        for (i64 c = 0; c < cols; ++c) {
+            out[c * ep.col_stride] = scale * static_cast<f32>(acc[r][c] - correction) + bias;
+        }
+    }
+}
+
+// A: s8 [QuantizedRows(ep.rows), depth]; B: packed u8 with padded_cols columns
+void GemmU8S8(const i8* a, const u8* b, i64 padded_cols, i64 depth, const Epilogue& ep,
+              const Parallel& parallel) {
+    static const TileFunc tile = SelectTile();
+
+    // Column panels outermost: one B panel stays in L1 while the weights
+    // stream, and threads take disjoint panels
+    const i64 panels = (ep.cols + kQTileN - 1) / kQTileN;
+    parallel.For(panels, 1, [&](i64 panel_begin, i64 panel_end) {
+        alignas(64) Tile acc;
+        for (i64 n0 = panel_begin * kQTileN; n0 < std::min(panel_end * kQTileN, ep.cols); n0 += kQTileN) {
+            for (i64 i0 = 0; i0 < ep.rows; i0 += kQTileM) {
+                tile(a + i0 * depth, b, padded_cols, depth, n0, acc);
+                StoreTile(acc, i0, n0, ep);
+            }
+        }
+    });
+}
+
+} // namespace
+
+i32 ActivationQuantMax() {
+    return DetectCpuIsa() == CpuIsa::Avx2 ? 127 : 255;
+}
+
+ActivationQuant ChooseActivationQuant(f32 min_value, f32 max_value) {
+    // The range must contain zero so padding and ReLU outputs are exact
+    const f32 lo = std::min(min_value, 0.0f);
+    const f32 hi = std::max(max_value, 0.0f);
+    const f32 max_code = static_cast<f32>(ActivationQuantMax());
+    if (!(hi - lo > 1e-12f)) {
+        return {};
+    }
+
+    ActivationQuant quant;
+    quant.scale = (hi - lo) / max_code;
+    quant.zero_point = static_cast<i32>(std::clamp(std::nearbyint(-lo / quant.scale), 0.0f, max_code));
+    return quant;
+}
+
+i64 QuantizedRows(i64 m) {
+    return RoundUp(m, kQTileM);
+}
+
+i64 QuantizedDepth(i64 k) {
+    return RoundUp(k, kDepthGroup);
+}
+
+void QuantizeWeightRows(const f32* weight, i64 m, i64 k, i8* out, f32* scales, i32* sums) {
+    const i64 depth = QuantizedDepth(k);
+    std::fill(out, out + QuantizedRows(m) * depth, static_cast<i8>(0));
+
+    for (i64 i = 0; i < m; ++i) {
+        const f32* row = weight + i * k;
+        f32 max_abs = 0.0f;
+        for (i64 p = 0; p < k; ++p) max_abs = std::max(max_abs, std::fabs(row[p]));
+
+        const f32 scale = max_abs > 0.0f ? max_abs / 127.0f : 1.0f;
+        i32 sum = 0;
+        for (i64 p = 0; p < k; ++p) {
+            const auto q = static_cast<i32>(std::clamp(std::nearbyint(row[p] / scale), -127.0f, 127.0f));
+            out[i * depth + p] = static_cast<i8>(q);
+            sum += q;
+        }
+        scales[i] = scale;
+        sums[i] = sum;
+    }
+}
+
+i64 QConv2DScratchBytes(const Shape& input, const Shape& weight, const Shape& output,
+                        const OpAttributes& attrs) {
+    (void)attrs;
+    const i64 depth = QuantizedDepth(weight[1] * weight[2] * weight[3]);
+    const i64 padded_cols = RoundUp(output[2] * output[3], kQTileN);
+    return input[1] * input[2] * input[3] + depth * padded_cols;
+}
+
+void QConv2D(const f32* input, const Shape& input_shape,
+             const QuantizedWeights& weights, const Shape& weight_shape, const f32* bias,
+             ActivationQuant input_quant, f32* output, const Shape& output_shape,
+             const OpAttributes& attrs, u8* scratch, const Parallel& parallel) {
+    const i64 batch = input_shape[0];
+    const i64 in_c = input_shape[1];
+    const i64 in_h = input_shape[2];
+    const i64 in_w = input_shape[3];
+    const i64 out_c = output_shape[1];
+    const i64 out_h = output_shape[2];
+    const i64 out_w = output_shape[3];
+    const i64 kh = weight_shape[2];
+    const i64 kw = weight_shape[3];
+
+    const i64 groups = attrs.group;
+    const i64 group_in_c = in_c / groups;
+    const i64 group_out_c = out_c / groups;
+    const i64 k = group_in_c * kh * kw;
+    const i64 depth = QuantizedDepth(k);
+    const i64 spatial = out_h * out_w;
+    const i64 padded_cols = RoundUp(spatial, kQTileN);
+    const i64 group_weight_bytes = QuantizedRows(group_out_c) * depth;
+
+    u8* image_q = scratch;
+    u8* packed = scratch + in_c * in_h * in_w;
+    const u8 pad_code = static_cast<u8>(input_quant.zero_point);
+
+    const i64 plane = in_h * in_w;
+
+    for (i64 n = 0; n < batch; ++n) {
+        parallel.For(in_c, 1, [&](i64 c_begin, i64 c_end) {
+            QuantizeActivations(input + (n * in_c + c_begin) * plane, (c_end - c_begin) * plane,
+                                input_quant, image_q + c_begin * plane);
+        });
+        f32* out_image = output + n * out_c * spatial;
+
+        for (i64 g = 0; g < groups; ++g) {
+            // Quantized im2col straight into the interleaved GEMM layout
+            // Threads fill disjoint depth groups (four unfolded rows each)
+            const i64 depth_groups = depth / kDepthGroup;
+            parallel.For(depth_groups, 1, [&](i64 group_begin, i64 group_end) {
+                std::memset(packed + group_begin * padded_cols * kDepthGroup, 0,
+                            (group_end - group_begin) * padded_cols * kDepthGroup);
+                const i64 p_end = std::min(group_end * kDepthGroup, k);
+                for (i64 p = group_begin * kDepthGroup; p < p_end; ++p) {
+                    const i64 c = p / (kh * kw);
+                    const i64 ki = p / kw % kh;
+                    const i64 kj = p % kw;
+                    const u8* src = image_q + (g * group_in_c + c) * plane;
+                    u8* dst = packed + PackedIndex(p, 0, padded_cols);
+                    for (i64 oy = 0; oy < out_h; ++oy) {
+                        const i64 iy = oy * attrs.stride[0] - attrs.pad[0] + ki * attrs.dilation[0];
+                        for (i64 ox = 0; ox < out_w; ++ox) {
+                            const i64 ix = ox * attrs.stride[1] - attrs.pad[1] + kj * attrs.dilation[1];
+                            const bool inside = iy >= 0 && iy < in_h && ix >= 0 && ix < in_w;
+                            dst[(oy * out_w + ox) * kDepthGroup] = inside ? src[iy * in_w + ix] : pad_code;
+                        }
+                    }
+                }
+            });
+
+            Epilogue ep{weights.scales + g * group_out_c, weights.sums + g * group_out_c,
+                        bias ? bias + g * group_out_c : nullptr,
+                        input_quant.scale, input_quant.zero_point,
+                        out_image + g * group_out_c * spatial, spatial, 1, group_out_c, spatial};
+            GemmU8S8(weights.data + g * group_weight_bytes, packed, padded_cols, depth, ep, parallel);
+        }
+
+        parallel.For(out_c, 1, [&](i64 c_begin, i64 c_end) {
+            ApplyActivation(out_image + c_begin * spatial, (c_end - c_begin) * spatial, attrs.activation);
+        });
+    }
+}
+
+i64 QLinearScratchBytes(i64 m, i64 k) {
+    return QuantizedDepth(k) * RoundUp(m, kQTileN);
+}
+
+void QLinear(const f32* x, const QuantizedWeights& weights, f32* y, i64 m, i64 n, i64 k,
+             const f32* bias, ActivationQuant input_quant, Activation activation, u8* scratch,
+             const Parallel& parallel) {
+    const i64 depth = QuantizedDepth(k);
+    const i64 padded_cols = RoundUp(m, kQTileN);
+    const f32 inv_scale = 1.0f / input_quant.scale;
+    const f32 zero_point = static_cast<f32>(input_quant.zero_point);
+    const f32 max_code = static_cast<f32>(ActivationQuantMax());
+
+    // Input rows become GEMM columns, so the output is written transposed
+    std::memset(scratch, 0, depth * padded_cols);
+    for (i64 row = 0; row < m; ++row) {
+        for (i64 p = 0; p < k; ++p) {
+            scratch[PackedIndex(p, row, padded_cols)] = Quantize(x[row * k + p], inv_scale, zero_point, max_code);
+        }
+    }
+
+    Epilogue ep{weights.scales, weights.sums, bias, input_quant.scale, input_quant.zero_point,
+                y, 1, n, n, m};
+    GemmU8S8(weights.data, scratch, padded_cols, depth, ep, parallel);
+    ApplyActivation(y, m * n, activation);
+}
+
+} // namespace atom::inference::cpu::kernels
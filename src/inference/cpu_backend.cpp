@@ -1,4 +1,396 @@
-// Placeholder implementation for inference/cpu_backend
 #include "atom/inference/cpu_backend.hpp"
+#include "atom/inference/backend_factory.hpp"
+#include "atom/core/config.hpp"
+#include "atom/logging/logger.hpp"
+#include <algorithm>
 
-// TODO: Implement inference/cpu_backend
+namespace atom::inference {
+
+CPUBackend::CPUBackend() = default;
+
+CPUBackend::~CPUBackend() {
+    Shutdown();
+}
+
+atom::core::Result<void> CPUBackend::Initialize(const atom::core::DeviceInfo& device) {
+    if (device.type != atom::core::DeviceType::CPU) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "CPU backend requires a CPU device"));
+    }
+    
+    device_ = device;
+    initialized_ = true;
+    return {};
+}
+
+void CPUBackend::Shutdown() {
+    UnloadModel();
+    initialized_ = false;
+}
+
+atom::core::Result<void> CPUBackend::LoadModel(const std::string& model_path) {
+    if (!initialized_) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Backend not initialized"));
+    }
+    
+    if (std::filesystem::path(model_path).extension() == ".atomp") {
+        auto plan = cpu::Plan::Load(model_path);
+        if (!plan) return std::unexpected(plan.error());
+        InstallPlan(std::move(*plan));
+        model_path_ = model_path;
+        return {};
+    }
+    
+    const auto cache_path = GetPlanCachePath(model_path);
+    if (plan_cache_enabled_) {
+        auto cached = cpu::Plan::Load(cache_path.string(), model_path);
+        if (cached) {
+            InstallPlan(std::move(*cached));
+            model_path_ = model_path;
+            return {};
+        }
+        LOG_DEBUG("No usable plan cache: " + cached.error().message);
+    }
+    
+    auto graph = cpu::Graph::Load(model_path);
+    if (!graph) {
+        return std::unexpected(graph.error());
+    }
+    auto plan = cpu::Plan::Compile(std::move(*graph));
+    if (!plan) {
+        return std::unexpected(plan.error());
+    }
+    InstallPlan(std::move(*plan));
+    model_path_ = model_path;
+    
+    if (plan_cache_enabled_) {
+        auto saved = plan_->Save(cache_path.string(), model_path);
+        if (!saved) {
+            LOG_WARNING("Plan cache not written: " + saved.error().message);
+        }
+    }
+    return {};
+}
+
+atom::core::Result<void> CPUBackend::LoadGraph(cpu::Graph graph) {
+    if (!initialized_) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Backend not initialized"));
+    }
+    
+    auto plan = cpu::Plan::Compile(std::move(graph));
+    if (!plan) {
+        return std::unexpected(plan.error());
+    }
+    InstallPlan(std::move(*plan));
+    model_path_.clear();
+    return {};
+}
+
+atom::core::Result<void> CPUBackend::SavePlan(const std::string& plan_path) const {
+    if (!plan_ || model_path_.empty()) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "No model loaded from a file"));
+    }
+    return plan_->Save(plan_path, model_path_);
+}
+
+atom::core::Result<cpu::QuantizationReport> CPUBackend::Calibrate(
+    const std::vector<std::vector<atom::core::Tensor>>& dataset) {
+    
+    if (!float_plan_) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "No float model loaded"));
+    }
+    if (model_path_.empty() || std::filesystem::path(model_path_).extension() == ".atomp") {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::NotImplemented,
+            "Calibration needs a model loaded from a graph file"));
+    }
+    
+    auto table = cpu::CollectActivationRanges(float_plan_, dataset);
+    if (!table) return std::unexpected(table.error());
+    
+    auto graph = cpu::Graph::Load(model_path_);
+    if (!graph) return std::unexpected(graph.error());
+    auto plan = cpu::Plan::Compile(std::move(*graph), &*table);
+    if (!plan) return std::unexpected(plan.error());
+    
+    auto report = cpu::EvaluateQuantization(float_plan_, *plan, dataset);
+    if (!report) return std::unexpected(report.error());
+    
+    int8_plan_ = std::move(*plan);
+    LOG_INFO("Int8 calibration: " + std::to_string(report->quantized_nodes) + "/" +
+             std::to_string(report->quantizable_nodes) + " nodes quantized, SNR " +
+             std::to_string(report->snr_db) + " dB, top-1 agreement " +
+             std::to_string(report->top1_agreement * 100.0) + "% over " +
+             std::to_string(report->samples) + " samples");
+    return *report;
+}
+
+void CPUBackend::UnloadModel() {
+    DrainAsync();
+    contexts_.Clear();
+    {
+        std::unique_lock lock(shape_plans_mutex_);
+        shape_plans_.clear();
+    }
+    plan_.reset();
+    float_plan_.reset();
+    int8_plan_.reset();
+    model_loaded_ = false;
+}
+
+atom::core::Result<std::vector<atom::core::Tensor>> CPUBackend::Execute(
+    const std::vector<atom::core::Tensor>& inputs) {
+    
+    if (!model_loaded_) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "No model loaded"));
+    }
+    
+    auto context = contexts_.Acquire();
+    context->SetKernelConfig(GetKernelConfig(inputs));
+    return context->Run(inputs, FindShapePlan(inputs));
+}
+
+atom::core::Result<void> CPUBackend::OptimizeForBatchSize(size_t batch_size) {
+    if (!model_loaded_) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "No model loaded"));
+    }
+    
+    // Pre-size every context so the first request of this size does not allocate
+    std::vector<cpu::Shape> shapes;
+    const auto& graph = plan_->GetGraph();
+    for (auto input : graph.inputs) {
+        auto shape = graph.values[input].shape;
+        if (shape.empty()) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+                "Graph input has no shape"));
+        }
+        shape[0] = static_cast<atom::core::i64>(batch_size);
+        if (std::any_of(shape.begin(), shape.end(), [](auto d) { return d <= 0; })) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+                "Graph input has dynamic non-batch dimensions"));
+        }
+        shapes.push_back(std::move(shape));
+    }
+    
+    for (size_t i = 0; i < contexts_.Size(); ++i) {
+        auto prepared = contexts_[i].Prepare(shapes);
+        if (!prepared) {
+            return prepared;
+        }
+    }
+    return {};
+}
+
+atom::core::Result<void> CPUBackend::SetPrecision(atom::core::DataType precision) {
+    if (precision != atom::core::DataType::Float32 && precision != atom::core::DataType::Int8) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::NotImplemented,
+            "CPU backend supports float32 and int8"));
+    }
+    if (!model_loaded_) {
+        if (precision == atom::core::DataType::Float32) {
+            return {};
+        }
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "No model loaded"));
+    }
+    
+    auto plan = precision == atom::core::DataType::Int8 ? int8_plan_ : float_plan_;
+    if (!plan) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            precision == atom::core::DataType::Int8 ? "Int8 precision requires Calibrate first"
+                                                    : "Loaded plan has no float32 version"));
+    }
+    if (plan != plan_) {
+        UsePlan(std::move(plan));
+    }
+    return {};
+}
+
+atom::core::Result<void> CPUBackend::SetExecutionContextCount(size_t count) {
+    if (count == 0) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Execution context count must be at least 1"));
+    }
+    
+    DrainAsync();
+    context_count_ = count;
+    // One async worker per context keeps every context busy under ExecuteAsync
+    SetAsyncWorkerCount(count);
+    
+    if (plan_) {
+        CreateContexts();
+    }
+    return {};
+}
+
+atom::core::Result<void> CPUBackend::SetThreading(const atom::core::ThreadingOptions& threading) {
+    if (threading.inter_op_threads == 0) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Inter-op thread count must be at least 1"));
+    }
+    
+    DrainAsync();
+    threading_ = threading;
+    for (size_t i = 0; i < contexts_.Size(); ++i) {
+        contexts_[i].SetParallelism(IntraOpThreads(), threading_.inter_op_threads);
+    }
+    RebuildShapePlans();
+    return {};
+}
+
+atom::core::Result<void> CPUBackend::PrepareShapes(const std::vector<atom::core::Shape>& input_shapes) {
+    if (!model_loaded_) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "No model loaded"));
+    }
+    
+    {
+        std::shared_lock lock(shape_plans_mutex_);
+        if (shape_plans_.contains(input_shapes)) {
+            return {};
+        }
+    }
+    
+    auto shape_plan = cpu::BuildShapePlan(*plan_, input_shapes, contexts_[0].IsConcurrent());
+    if (!shape_plan) {
+        return std::unexpected(shape_plan.error());
+    }
+    std::unique_lock lock(shape_plans_mutex_);
+    shape_plans_.emplace(input_shapes, std::move(*shape_plan));
+    return {};
+}
+
+void CPUBackend::ReleaseShapes(const std::vector<atom::core::Shape>& input_shapes) {
+    std::unique_lock lock(shape_plans_mutex_);
+    shape_plans_.erase(input_shapes);
+}
+
+std::vector<std::string> CPUBackend::GetKernelVariants() const {
+    std::vector<std::string> variants;
+    for (const auto& config : cpu::kernels::AllKernelConfigs()) {
+        variants.push_back(cpu::kernels::KernelConfigName(config));
+    }
+    return variants;
+}
+
+atom::core::Result<void> CPUBackend::SelectKernelVariant(const std::string& variant,
+                                                        std::optional<size_t> batch_size) {
+    auto config = variant == "default" ? cpu::kernels::KernelConfig{}
+                                       : cpu::kernels::ParseKernelConfig(variant);
+    if (!config) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Unknown kernel variant: " + variant));
+    }
+    
+    std::unique_lock lock(kernel_configs_mutex_);
+    if (batch_size) {
+        batch_configs_[*batch_size] = *config;
+    } else {
+        default_config_ = *config;
+    }
+    return {};
+}
+
+size_t CPUBackend::GetMemoryUsage() const {
+    // Mapped weights are shared with the page cache but still count here
+    size_t bytes = plan_ ? plan_->GetWeightBytes() : 0;
+    for (size_t i = 0; i < contexts_.Size(); ++i) {
+        bytes += contexts_[i].GetMemoryUsage();
+    }
+    return bytes;
+}
+
+void CPUBackend::InstallPlan(std::shared_ptr<const cpu::Plan> plan) {
+    UnloadModel();
+    (plan->IsQuantized() ? int8_plan_ : float_plan_) = plan;
+    plan_ = std::move(plan);
+    CreateContexts();
+    model_loaded_ = true;
+}
+
+void CPUBackend::UsePlan(std::shared_ptr<const cpu::Plan> plan) {
+    DrainAsync();
+    contexts_.Clear();
+    plan_ = std::move(plan);
+    CreateContexts();
+    RebuildShapePlans();
+}
+
+std::filesystem::path CPUBackend::GetPlanCachePath(const std::string& model_path) const {
+    const std::filesystem::path model(model_path);
+    auto directory = plan_cache_dir_;
+    if (directory.empty()) {
+        directory = atom::core::Config::Instance().GetOr<std::string>(
+            atom::core::Config::KEY_PLAN_CACHE_DIR, "");
+    }
+    if (directory.empty()) {
+        directory = model.parent_path();
+    }
+    return directory / (model.filename().string() + ".atomp");
+}
+
+void CPUBackend::CreateContexts() {
+    std::vector<std::unique_ptr<cpu::ExecutionContext>> contexts;
+    contexts.reserve(context_count_);
+    for (size_t i = 0; i < context_count_; ++i) {
+        contexts.push_back(std::make_unique<cpu::ExecutionContext>(plan_));
+        contexts.back()->SetParallelism(IntraOpThreads(), threading_.inter_op_threads);
+    }
+    contexts_.Reset(std::move(contexts));
+}
+
+void CPUBackend::RebuildShapePlans() {
+    // Shape plans depend on the plan's graph and on the branch layout
+    std::unique_lock lock(shape_plans_mutex_);
+    for (auto it = shape_plans_.begin(); it != shape_plans_.end();) {
+        auto shape_plan = cpu::BuildShapePlan(*plan_, it->first, contexts_[0].IsConcurrent());
+        if (shape_plan) {
+            it->second = std::move(*shape_plan);
+            ++it;
+        } else {
+            it = shape_plans_.erase(it);
+        }
+    }
+}
+
+std::shared_ptr<const cpu::ShapePlan> CPUBackend::FindShapePlan(
+    const std::vector<atom::core::Tensor>& inputs) const {
+    
+    std::shared_lock lock(shape_plans_mutex_);
+    if (shape_plans_.empty()) {
+        return nullptr;
+    }
+    std::vector<atom::core::Shape> shapes;
+    shapes.reserve(inputs.size());
+    for (const auto& input : inputs) {
+        shapes.push_back(input.GetShape());
+    }
+    auto it = shape_plans_.find(shapes);
+    return it != shape_plans_.end() ? it->second : nullptr;
+}
+
+size_t CPUBackend::IntraOpThreads() const {
+    return threading_.intra_op_threads > 0 ? threading_.intra_op_threads : cpu::ComputeThreadCount();
+}
+
+cpu::kernels::KernelConfig CPUBackend::GetKernelConfig(
+    const std::vector<atom::core::Tensor>& inputs) const {
+    
+    std::shared_lock lock(kernel_configs_mutex_);
+    if (!batch_configs_.empty() && !inputs.empty() && !inputs[0].GetShape().empty()) {
+        auto it = batch_configs_.find(static_cast<size_t>(inputs[0].GetShape()[0]));
+        if (it != batch_configs_.end()) {
+            return it->second;
+        }
+    }
+    return default_config_;
+}
+
+REGISTER_BACKEND(CPUBackend, atom::core::BackendType::CPU)
+
+} // namespace atom::inference
@@ -0,0 +1,298 @@
+#include "atom/inference/shape_buckets.hpp"
+#include "atom/logging/logger.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace atom::inference {
+
+namespace {
+
+std::string FormatShape(const atom::core::Shape& shape) {
+    std::string text;
+    for (size_t i = 0; i < shape.size(); ++i) {
+        text += (i ? "x" : "") + std::to_string(shape[i]);
+    }
+    return text;
+}
+
+} // namespace
+
+ShapeBucketer::ShapeBucketer(IBackend& backend, atom::core::ShapeBucketOptions options)
+    : backend_(backend), options_(std::move(options)) {
+
+    auto& batches = options_.batch_sizes;
+    std::erase_if(batches, [](atom::core::i64 batch) { return batch <= 0; });
+    std::sort(batches.begin(), batches.end());
+    batches.erase(std::unique(batches.begin(), batches.end()), batches.end());
+
+    // By area, so the first resolution that fits is the one wasting least
+    auto& resolutions = options_.resolutions;
+    std::erase_if(resolutions, [](const auto& r) { return r.first <= 0 || r.second <= 0; });
+    std::sort(resolutions.begin(), resolutions.end(), [](const auto& a, const auto& b) {
+        return a.first * a.second < b.first * b.second ||
+               (a.first * a.second == b.first * b.second && a < b);
+    });
+    resolutions.erase(std::unique(resolutions.begin(), resolutions.end()), resolutions.end());
+}
+
+atom::core::Result<BucketPadding> ShapeBucketer::SelectBucket(const atom::core::Shape& shape) const {
+    if (shape.empty() || std::any_of(shape.begin(), shape.end(), [](auto d) { return d <= 0; })) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Shape buckets need a static input shape with a batch dimension"));
+    }
+
+    BucketPadding padding;
+    padding.batch = padding.bucket_batch = shape[0];
+    if (!options_.batch_sizes.empty()) {
+        auto it = std::lower_bound(options_.batch_sizes.begin(), options_.batch_sizes.end(), shape[0]);
+        if (it == options_.batch_sizes.end()) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+                "Batch " + std::to_string(shape[0]) + " exceeds every shape bucket"));
+        }
+        padding.bucket_batch = *it;
+    }
+
+    if (!options_.resolutions.empty() && shape.size() == 4) {
+        padding.height = shape[2];
+        padding.width = shape[3];
+        auto it = std::find_if(options_.resolutions.begin(), options_.resolutions.end(),
+            [&](const auto& r) { return r.first >= shape[2] && r.second >= shape[3]; });
+        if (it == options_.resolutions.end()) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+                "Resolution " + std::to_string(shape[2]) + "x" + std::to_string(shape[3]) +
+                " exceeds every shape bucket"));
+        }
+        padding.bucket_height = it->first;
+        padding.bucket_width = it->second;
+    }
+    return padding;
+}
+
+atom::core::Result<BucketedOutputs> ShapeBucketer::Execute(const std::vector<atom::core::Tensor>& inputs) {
+    BucketPadding padding;
+    auto padded = Enter(inputs, padding);
+    if (!padded) return std::unexpected(padded.error());
+
+    auto outputs = backend_.Execute(padded->empty() ? inputs : *padded);
+    if (!outputs) return std::unexpected(outputs.error());
+    return Crop(std::move(*outputs), padding);
+}
+
+atom::core::Result<void> ShapeBucketer::ExecuteAsync(std::vector<atom::core::Tensor> inputs,
+                                                     BucketedCallback callback) {
+    BucketPadding padding;
+    auto padded = Enter(inputs, padding);
+    if (!padded) return std::unexpected(padded.error());
+
+    return backend_.ExecuteAsync(padded->empty() ? std::move(inputs) : std::move(*padded),
+        [padding, callback = std::move(callback)](ExecuteResult result) {
+            if (!result) {
+                callback(std::unexpected(result.error()));
+                return;
+            }
+            callback(Crop(std::move(*result), padding));
+        });
+}
+
+atom::core::Result<void> ShapeBucketer::PrepareAll(const std::vector<atom::core::Shape>& input_shapes) {
+    if (input_shapes.empty() || input_shapes[0].empty()) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "No input shapes to bucket"));
+    }
+
+    auto batches = options_.batch_sizes;
+    if (batches.empty()) batches.push_back(input_shapes[0][0]);
+    std::vector<std::pair<atom::core::i64, atom::core::i64>> resolutions = options_.resolutions;
+    if (resolutions.empty() || input_shapes[0].size() != 4) resolutions = {{0, 0}};
+
+    std::lock_guard lock(mutex_);
+    for (auto batch : batches) {
+        for (const auto& [height, width] : resolutions) {
+            BucketPadding padding{batch, height, width, batch, height, width};
+            std::vector<atom::core::Shape> shapes;
+            for (const auto& shape : input_shapes) {
+                shapes.push_back(BucketShape(shape, padding));
+            }
+            auto acquired = Acquire(shapes, nullptr);
+            if (!acquired) return acquired;
+        }
+    }
+    return {};
+}
+
+ShapeBucketReport ShapeBucketer::GetReport() const {
+    std::lock_guard lock(mutex_);
+    ShapeBucketReport report;
+    for (const auto& [key, stats] : stats_) {
+        if (stats.requests == 0) continue;
+        report.buckets.push_back(stats);
+        report.total.requests += stats.requests;
+        report.total.plan_builds += stats.plan_builds;
+        report.total.evictions += stats.evictions;
+        report.total.valid_elements += stats.valid_elements;
+        report.total.padded_elements += stats.padded_elements;
+    }
+    report.rejected = rejected_;
+    report.resident_plans = lru_.size();
+    return report;
+}
+
+void ShapeBucketer::ResetStats() {
+    std::lock_guard lock(mutex_);
+    stats_.clear();
+    rejected_ = 0;
+}
+
+atom::core::Result<std::vector<atom::core::Tensor>> ShapeBucketer::Enter(
+    const std::vector<atom::core::Tensor>& inputs, BucketPadding& padding) {
+
+    if (inputs.empty()) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "No inputs"));
+    }
+
+    auto selected = SelectBucket(inputs[0].GetShape());
+    if (!selected) {
+        std::lock_guard lock(mutex_);
+        ++rejected_;
+        return std::unexpected(selected.error());
+    }
+    padding = *selected;
+
+    std::vector<atom::core::Shape> shapes;
+    shapes.reserve(inputs.size());
+    bool pad = false;
+    atom::core::u64 valid = 0;
+    atom::core::u64 computed = 0;
+    for (const auto& input : inputs) {
+        shapes.push_back(BucketShape(input.GetShape(), padding));
+        pad |= shapes.back() != input.GetShape();
+        valid += atom::core::ComputeSize(input.GetShape());
+        computed += atom::core::ComputeSize(shapes.back());
+    }
+
+    {
+        std::lock_guard lock(mutex_);
+        auto& stats = stats_[{padding.bucket_batch, padding.bucket_height, padding.bucket_width}];
+        stats.batch = padding.bucket_batch;
+        stats.height = padding.bucket_height;
+        stats.width = padding.bucket_width;
+        ++stats.requests;
+        stats.valid_elements += valid;
+        stats.padded_elements += computed;
+
+        auto acquired = Acquire(shapes, &stats);
+        if (!acquired) return std::unexpected(acquired.error());
+    }
+
+    // An empty result means the inputs already have the bucket shape
+    std::vector<atom::core::Tensor> padded;
+    if (pad) {
+        padded.reserve(inputs.size());
+        for (const auto& input : inputs) {
+            auto tensor = Pad(input, padding);
+            if (!tensor) return std::unexpected(tensor.error());
+            padded.push_back(std::move(*tensor));
+        }
+    }
+    return padded;
+}
+
+atom::core::Result<void> ShapeBucketer::Acquire(const std::vector<atom::core::Shape>& shapes,
+                                                ShapeBucketStats* stats) {
+    auto it = resident_.find(shapes);
+    if (it != resident_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return {};
+    }
+
+    auto prepared = backend_.PrepareShapes(shapes);
+    if (!prepared) return prepared;
+    LOG_DEBUG("Prepared shape bucket " + FormatShape(shapes[0]));
+    if (stats) ++stats->plan_builds;
+
+    lru_.push_front(shapes);
+    resident_.emplace(shapes, lru_.begin());
+    while (options_.max_plans > 0 && lru_.size() > options_.max_plans) {
+        const auto& oldest = lru_.back();
+        backend_.ReleaseShapes(oldest);
+        const auto& shape = oldest[0];
+        const bool spatial = !options_.resolutions.empty() && shape.size() == 4;
+        auto evicted = stats_.find({shape[0], spatial ? shape[2] : 0, spatial ? shape[3] : 0});
+        if (evicted != stats_.end()) ++evicted->second.evictions;
+        resident_.erase(oldest);
+        lru_.pop_back();
+    }
+    return {};
+}
+
+atom::core::Shape ShapeBucketer::BucketShape(const atom::core::Shape& shape,
+                                             const BucketPadding& padding) const {
+    auto bucket = shape;
+    if (!bucket.empty()) bucket[0] = std::max(bucket[0], padding.bucket_batch);
+    if (padding.bucket_height > 0 && bucket.size() == 4) {
+        bucket[2] = std::max(bucket[2], padding.bucket_height);
+        bucket[3] = std::max(bucket[3], padding.bucket_width);
+    }
+    return bucket;
+}
+
+atom::core::Result<atom::core::Tensor> ShapeBucketer::Pad(const atom::core::Tensor& input,
+                                                          const BucketPadding& padding) const {
+    if (input.GetDevice().type != atom::core::DeviceType::CPU) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::NotImplemented,
+            "Shape buckets pad host tensors only"));
+    }
+
+    const auto& shape = input.GetShape();
+    auto tensor = atom::core::Tensor::Create(BucketShape(shape, padding), input.GetDataType(), input.GetDevice());
+    if (!tensor) return std::unexpected(tensor.error());
+
+    auto filled = input.GetDataType() == atom::core::DataType::Float32 ? tensor->Fill(options_.pad_value)
+                                                                      : tensor->Zero();
+    if (!filled) return std::unexpected(filled.error());
+
+    const auto* src = static_cast<const atom::core::byte_t*>(input.GetData());
+    auto* dst = static_cast<atom::core::byte_t*>(tensor->GetData());
+    const auto& bucket = tensor->GetShape();
+    if (shape.size() == 4 && (bucket[2] != shape[2] || bucket[3] != shape[3])) {
+        // Row by row into the top-left corner of each plane
+        const size_t element = input.GetByteSize() / input.GetSize();
+        const size_t row = shape[3] * element;
+        for (atom::core::i64 plane = 0; plane < shape[0] * shape[1]; ++plane) {
+            for (atom::core::i64 y = 0; y < shape[2]; ++y) {
+                std::memcpy(dst + ((plane * bucket[2] + y) * bucket[3]) * element,
+                            src + (plane * shape[2] + y) * row, row);
+            }
+        }
+    } else {
+        // Extra samples go after the real ones
+        std::memcpy(dst, src, input.GetByteSize());
+    }
+    return tensor;
+}
+
+atom::core::Result<BucketedOutputs> ShapeBucketer::Crop(std::vector<atom::core::Tensor> outputs,
+                                                        const BucketPadding& padding) {
+    BucketedOutputs result;
+    result.padding = padding;
+    result.outputs.reserve(outputs.size());
+    for (auto& output : outputs) {
+        const auto& shape = output.GetShape();
+        if (padding.batch == padding.bucket_batch || shape.empty() || shape[0] != padding.bucket_batch ||
+            output.GetDevice().type != atom::core::DeviceType::CPU) {
+            result.outputs.push_back(std::move(output));
+            continue;
+        }
+
+        auto cropped_shape = shape;
+        cropped_shape[0] = padding.batch;
+        auto cropped = atom::core::Tensor::Create(std::move(cropped_shape), output.GetDataType(), output.GetDevice());
+        if (!cropped) return std::unexpected(cropped.error());
+        std::memcpy(cropped->GetData(), output.GetData(), cropped->GetByteSize());
+        result.outputs.push_back(std::move(*cropped));
+    }
+    return result;
+}
+
+} // namespace atom::inference
@@ -1,4 +1,150 @@
-// Placeholder implementation for logging/metrics
 #include "atom/logging/metrics.hpp"
+#include <sstream>
 
-// TODO: Implement logging/metrics
+namespace atom::logging {
+
+namespace {
+
+// Prometheus names allow [a-zA-Z0-9_:]; dotted registry names map onto '_'
+std::string PrometheusName(const std::string& name) {
+    std::string out = name;
+    for (auto& c : out) {
+        const bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                           (c >= '0' && c <= '9') || c == '_' || c == ':';
+        if (!valid) c = '_';
+    }
+    if (!out.empty() && out[0] >= '0' && out[0] <= '9') out.insert(out.begin(), '_');
+    return out;
+}
+
+std::string JsonString(const std::string& value) {
+    std::string out = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+} // namespace
+
+void Histogram::Observe(atom::core::f64 value) {
+    sum_.fetch_add(value);
+    auto min = min_.load();
+    while (value < min && !min_.compare_exchange_weak(min, value)) {}
+    auto max = max_.load();
+    while (value > max && !max_.compare_exchange_weak(max, value)) {}
+    count_++;
+}
+
+atom::core::f64 Histogram::GetMean() const {
+    const auto count = count_.load();
+    return count == 0 ? 0.0 : sum_.load() / static_cast<atom::core::f64>(count);
+}
+
+void Histogram::Reset() {
+    sum_ = 0.0;
+    min_ = std::numeric_limits<atom::core::f64>::max();
+    max_ = std::numeric_limits<atom::core::f64>::lowest();
+    count_ = 0;
+}
+
+MetricsRegistry& MetricsRegistry::Instance() {
+    static MetricsRegistry instance;
+    return instance;
+}
+
+Counter& MetricsRegistry::RegisterCounter(const std::string& name) {
+    std::unique_lock lock(mutex_);
+    return counters_[name];
+}
+
+Gauge& MetricsRegistry::RegisterGauge(const std::string& name) {
+    std::unique_lock lock(mutex_);
+    return gauges_[name];
+}
+
+Histogram& MetricsRegistry::RegisterHistogram(const std::string& name) {
+    std::unique_lock lock(mutex_);
+    return histograms_[name];
+}
+
+Counter* MetricsRegistry::GetCounter(const std::string& name) {
+    std::shared_lock lock(mutex_);
+    auto it = counters_.find(name);
+    return it != counters_.end() ? &it->second : nullptr;
+}
+
+Gauge* MetricsRegistry::GetGauge(const std::string& name) {
+    std::shared_lock lock(mutex_);
+    auto it = gauges_.find(name);
+    return it != gauges_.end() ? &it->second : nullptr;
+}
+
+Histogram* MetricsRegistry::GetHistogram(const std::string& name) {
+    std::shared_lock lock(mutex_);
+    auto it = histograms_.find(name);
+    return it != histograms_.end() ? &it->second : nullptr;
+}
+
+std::string MetricsRegistry::ExportJSON() const {
+    std::shared_lock lock(mutex_);
+    std::ostringstream out;
+    out << "{\"counters\":{";
+    const char* separator = "";
+    for (const auto& [name, counter] : counters_) {
+        out << separator << JsonString(name) << ':' << counter.Get();
+        separator = ",";
+    }
+    out << "},\"gauges\":{";
+    separator = "";
+    for (const auto& [name, gauge] : gauges_) {
+        out << separator << JsonString(name) << ':' << gauge.Get();
+        separator = ",";
+    }
+    out << "},\"histograms\":{";
+    separator = "";
+    for (const auto& [name, histogram] : histograms_) {
+        out << separator << JsonString(name) << ":{\"count\":" << histogram.GetCount();
+        if (histogram.GetCount() > 0) {
+            out << ",\"mean\":" << histogram.GetMean() << ",\"min\":" << histogram.GetMin()
+                << ",\"max\":" << histogram.GetMax();
+        }
+        out << '}';
+        separator = ",";
+    }
+    out << "}}";
+    return out.str();
+}
+
+std::string MetricsRegistry::ExportPrometheus() const {
+    std::shared_lock lock(mutex_);
+    std::ostringstream out;
+    for (const auto& [name, counter] : counters_) {
+        const auto metric = PrometheusName(name);
+        out << "# TYPE " << metric << " counter\n" << metric << ' ' << counter.Get() << '\n';
+    }
+    for (const auto& [name, gauge] : gauges_) {
+        const auto metric = PrometheusName(name);
+        out << "# TYPE " << metric << " gauge\n" << metric << ' ' << gauge.Get() << '\n';
+    }
+    for (const auto& [name, histogram] : histograms_) {
+        // Only count and sum are tracked, so this exports as a summary without quantiles
+        const auto metric = PrometheusName(name);
+        const auto count = histogram.GetCount();
+        out << "# TYPE " << metric << " summary\n"
+            << metric << "_sum " << histogram.GetMean() * static_cast<atom::core::f64>(count) << '\n'
+            << metric << "_count " << count << '\n';
+    }
+    return out.str();
+}
+
+void MetricsRegistry::Clear() {
+    // Values only: callers keep references to registered metrics
+    std::unique_lock lock(mutex_);
+    for (auto& [name, counter] : counters_) counter.Reset();
+    for (auto& [name, gauge] : gauges_) gauge.Set(0.0);
+    for (auto& [name, histogram] : histograms_) histogram.Reset();
+}
+
+} // namespace atom::logging
@@ -0,0 +1,150 @@
+#include "atom/scheduler/admission_controller.hpp"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace atom::scheduler {
+
+namespace {
+
+constexpr double kSampleWeight = 1.0 / 16;  // of a new sample in the latency averages
+
+// Tasks of a priority may fill this many of cap. The reserve rounds up, so
+// a priority with any headroom keeps at least one slot even at small caps.
+size_t Allowance(double cap, double share) {
+    const auto whole = static_cast<size_t>(cap);
+    const auto reserve = static_cast<size_t>(std::ceil(whole * (1.0 - std::clamp(share, 0.0, 1.0))));
+    return std::max<size_t>(whole - std::min(reserve, whole), 1);
+}
+
+} // namespace
+
+AdmissionController::AdmissionController(size_t max_queue_size, AdmissionConfig config)
+    : max_queue_size_(max_queue_size)
+    , config_(std::move(config))
+    , limit_(static_cast<double>(config_.initial_limit)) {
+    config_.min_limit = std::max<size_t>(config_.min_limit, 1);
+    config_.max_limit = std::max(config_.max_limit, config_.min_limit);
+    Clamp();
+}
+
+atom::core::Result<void> AdmissionController::Acquire(atom::core::Priority priority, size_t count) {
+    const auto index = std::min<size_t>(static_cast<size_t>(priority), config_.priority_share.size() - 1);
+    const double share = config_.priority_share[index];
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (max_queue_size_ > 0 && queued_ > 0 &&
+        queued_ + count > Allowance(static_cast<double>(max_queue_size_), share)) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::QueueFull,
+            "Scheduler queue full: " + std::to_string(queued_) + " tasks queued"));
+    }
+    if (config_.algorithm != LimitAlgorithm::None && in_flight_ > 0 &&
+        in_flight_ + count > Allowance(limit_, share)) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::QueueFull,
+            "Concurrency limit reached: " + std::to_string(in_flight_) + " of " +
+            std::to_string(static_cast<size_t>(limit_)) + " tasks in flight"));
+    }
+    in_flight_ += count;
+    queued_ += count;
+    return {};
+}
+
+void AdmissionController::OnStarted() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queued_ > 0) queued_--;
+}
+
+void AdmissionController::Release(size_t count, bool started) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    in_flight_ -= std::min(count, in_flight_);
+    if (!started) queued_ -= std::min(count, queued_);
+    cooldown_ -= std::min(count, cooldown_);
+}
+
+void AdmissionController::Release(atom::core::Duration queue_delay, atom::core::Duration execution_time) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const bool in_use = in_flight_ * 2 >= limit_;
+    if (in_flight_ > 0) in_flight_--;
+
+    switch (config_.algorithm) {
+    case LimitAlgorithm::None:
+        break;
+
+    case LimitAlgorithm::Aimd:
+        if (queue_delay > config_.target_queue_delay) {
+            if (cooldown_ == 0) Decrease(config_.backoff_ratio);
+            else cooldown_--;
+            return;
+        }
+        // Growing a limit nothing presses against says nothing about capacity
+        if (in_use) limit_ += 1.0;
+        break;
+
+    case LimitAlgorithm::Gradient: {
+        const auto delay = static_cast<double>(std::max(queue_delay.count(), atom::core::Duration::rep{0}));
+        const auto execution = static_cast<double>(std::max(execution_time.count(), atom::core::Duration::rep{0}));
+        if (!has_samples_) {
+            queue_delay_ns_ = delay;
+            execution_ns_ = execution;
+            has_samples_ = true;
+        } else {
+            queue_delay_ns_ += (delay - queue_delay_ns_) * kSampleWeight;
+            execution_ns_ += (execution - execution_ns_) * kSampleWeight;
+        }
+
+        const double latency = execution_ns_ + queue_delay_ns_;
+        const double gradient = latency > 0.0
+            ? std::clamp(config_.tolerance * execution_ns_ / latency, 0.5, 1.0)
+            : 1.0;
+        if (gradient >= 1.0 && !in_use) break;
+
+        const double target = limit_ * gradient + std::sqrt(limit_);
+        limit_ += (target - limit_) * config_.smoothing;
+        break;
+    }
+    }
+    if (cooldown_ > 0) cooldown_--;
+    Clamp();
+}
+
+void AdmissionController::ReleaseDropped() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (in_flight_ > 0) in_flight_--;
+    if (queued_ > 0) queued_--;
+    if (config_.algorithm == LimitAlgorithm::None) return;
+
+    if (cooldown_ > 0) {
+        cooldown_--;
+        return;
+    }
+    Decrease(config_.algorithm == LimitAlgorithm::Aimd ? config_.backoff_ratio : 0.5);
+}
+
+size_t AdmissionController::GetLimit() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<size_t>(limit_);
+}
+
+size_t AdmissionController::GetInFlight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_;
+}
+
+size_t AdmissionController::GetQueued() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queued_;
+}
+
+void AdmissionController::Decrease(double ratio) {
+    // Tasks still in flight were admitted under the old limit; their delays
+    // do not reflect the new one yet
+    limit_ *= ratio;
+    cooldown_ = in_flight_;
+    Clamp();
+}
+
+void AdmissionController::Clamp() {
+    limit_ = std::clamp(limit_, static_cast<double>(config_.min_limit), static_cast<double>(config_.max_limit));
+}
+
+} // namespace atom::scheduler
@@ -1,4 +0,0 @@
-// Placeholder implementation for scheduler/dependency_graph
-#include "atom/scheduler/dependency_graph.hpp"
-
-// TODO: Implement scheduler/dependency_graph
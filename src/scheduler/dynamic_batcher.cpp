@@ -0,0 +1,303 @@
+#include "atom/scheduler/dynamic_batcher.hpp"
+#include "atom/logging/logger.hpp"
+#include <algorithm>
+
+namespace atom::scheduler {
+
+DynamicBatcher::DynamicBatcher(atom::core::ModelPtr model, BatchingConfig config)
+    : model_(std::move(model)), config_(std::move(config)) {
+    config_.max_batch_size = std::max<size_t>(config_.max_batch_size, 1);
+    config_.max_in_flight = std::max<size_t>(config_.max_in_flight, 1);
+
+    // Preferred sizes above the maximum can never be formed
+    auto& preferred = config_.preferred_batch_sizes;
+    std::erase_if(preferred, [this](size_t size) {
+        return size == 0 || size > config_.max_batch_size;
+    });
+    std::sort(preferred.begin(), preferred.end());
+    preferred.erase(std::unique(preferred.begin(), preferred.end()), preferred.end());
+
+    stats_.batch_size_histogram = std::vector<std::atomic<uint64_t>>(config_.max_batch_size + 1);
+}
+
+DynamicBatcher::~DynamicBatcher() {
+    Stop();
+}
+
+void DynamicBatcher::Start() {
+    if (running_.exchange(true)) return;
+    batch_thread_ = std::thread([this]() { BatchLoop(); });
+}
+
+void DynamicBatcher::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) return;
+        running_ = false;
+    }
+    cv_.notify_all();
+
+    if (batch_thread_.joinable()) {
+        batch_thread_.join();
+    }
+
+    // Batches still on the model hold completions that call back into us
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this]() { return in_flight_ == 0; });
+}
+
+atom::core::Result<void> DynamicBatcher::Enqueue(
+    std::vector<atom::core::Tensor> inputs, Completion completion) {
+
+    if (inputs.empty() || inputs.front().GetShape().empty()) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Batched requests need inputs with a batch dimension"));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::SchedulerError,
+                "Batcher is not running"));
+        }
+        if (queue_.size() >= config_.max_queue_size) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::QueueFull,
+                "Batcher queue is full"));
+        }
+
+        const auto rows = static_cast<size_t>(std::max<atom::core::i64>(inputs.front().GetShape()[0], 1));
+        queue_.push_back(Request{
+            std::move(inputs),
+            std::move(completion),
+            std::chrono::high_resolution_clock::now(),
+            rows
+        });
+        queued_rows_ += rows;
+    }
+
+    cv_.notify_one();
+    return {};
+}
+
+size_t DynamicBatcher::GetQueuedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+std::vector<uint64_t> DynamicBatcher::GetBatchSizeHistogram() const {
+    std::vector<uint64_t> histogram;
+    histogram.reserve(stats_.batch_size_histogram.size());
+    for (const auto& bucket : stats_.batch_size_histogram) {
+        histogram.push_back(bucket.load());
+    }
+    return histogram;
+}
+
+void DynamicBatcher::ResetStatistics() {
+    stats_.total_requests = 0;
+    stats_.total_batches = 0;
+    stats_.failed_batches = 0;
+    stats_.total_queue_delay_ns = 0;
+    stats_.max_queue_delay_ns = 0;
+    for (auto& bucket : stats_.batch_size_histogram) {
+        bucket = 0;
+    }
+    stats_.start_time = std::chrono::high_resolution_clock::now();
+}
+
+void DynamicBatcher::BatchLoop() {
+    const size_t eager_size = config_.preferred_batch_sizes.empty()
+        ? config_.max_batch_size
+        : config_.preferred_batch_sizes.back();
+
+    while (true) {
+        std::vector<Request> batch;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return !running_ || !queue_.empty(); });
+
+            if (queue_.empty()) {
+                break; // Stopped and drained
+            }
+
+            // Backpressure: while the model is busy, requests accumulate
+            cv_.wait(lock, [this]() { return in_flight_ < config_.max_in_flight; });
+
+            // Wait for a full batch, but never hold the oldest request past its delay
+            if (running_) {
+                const auto deadline = queue_.front().enqueue_time + config_.max_queue_delay;
+                cv_.wait_until(lock, deadline, [this, eager_size]() {
+                    return !running_ || queued_rows_ >= eager_size;
+                });
+            }
+
+            batch = TakeBatch(ChooseBatchSize(std::min(queued_rows_, config_.max_batch_size)));
+            in_flight_++;
+        }
+
+        Dispatch(std::move(batch));
+    }
+}
+
+size_t DynamicBatcher::ChooseBatchSize(size_t available) const {
+    const auto& preferred = config_.preferred_batch_sizes;
+    auto it = std::upper_bound(preferred.begin(), preferred.end(), available);
+    if (it == preferred.begin()) {
+        return available; // Smaller than every preferred size
+    }
+    return *std::prev(it);
+}
+
+std::vector<DynamicBatcher::Request> DynamicBatcher::TakeBatch(size_t target_rows) {
+    std::vector<Request> batch;
+    batch.reserve(target_rows);
+
+    // The oldest request defines the signature; incompatible ones, and those
+    // that would overshoot the target, keep their place
+    batch.push_back(std::move(queue_.front()));
+    queue_.pop_front();
+    size_t rows = batch.front().rows;
+
+    for (auto it = queue_.begin(); it != queue_.end() && rows < target_rows;) {
+        if (rows + it->rows <= target_rows && IsCompatible(batch.front(), *it)) {
+            rows += it->rows;
+            batch.push_back(std::move(*it));
+            it = queue_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    queued_rows_ -= rows;
+    return batch;
+}
+
+bool DynamicBatcher::IsCompatible(const Request& a, const Request& b) {
+    if (a.inputs.size() != b.inputs.size()) return false;
+
+    for (size_t i = 0; i < a.inputs.size(); ++i) {
+        const auto& lhs = a.inputs[i];
+        const auto& rhs = b.inputs[i];
+        if (lhs.GetDataType() != rhs.GetDataType() || !(lhs.GetDevice() == rhs.GetDevice())) {
+            return false;
+        }
+
+        const auto& lhs_shape = lhs.GetShape();
+        const auto& rhs_shape = rhs.GetShape();
+        if (lhs_shape.empty() || lhs_shape.size() != rhs_shape.size() ||
+            !std::equal(lhs_shape.begin() + 1, lhs_shape.end(), rhs_shape.begin() + 1)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void DynamicBatcher::Dispatch(std::vector<Request> batch) {
+    const auto now = std::chrono::high_resolution_clock::now();
+    for (const auto& request : batch) {
+        auto delay = static_cast<uint64_t>(
+            std::chrono::duration_cast<atom::core::Duration>(now - request.enqueue_time).count());
+        stats_.total_queue_delay_ns += delay;
+
+        auto current_max = stats_.max_queue_delay_ns.load();
+        while (delay > current_max && !stats_.max_queue_delay_ns.compare_exchange_weak(current_max, delay)) {}
+    }
+    std::vector<atom::core::i64> batch_sizes;
+    auto completions = std::make_shared<std::vector<Completion>>();
+    batch_sizes.reserve(batch.size());
+    completions->reserve(batch.size());
+    size_t rows = 0;
+    for (auto& request : batch) {
+        batch_sizes.push_back(request.inputs.front().GetShape()[0]);
+        completions->push_back(std::move(request.completion));
+        rows += request.rows;
+    }
+
+    stats_.total_requests += batch.size();
+    stats_.total_batches++;
+    stats_.batch_size_histogram[std::min(rows, config_.max_batch_size)]++;
+
+    // Stack each input along the batch dimension; a single request passes through
+    std::vector<atom::core::Tensor> stacked;
+    if (batch.size() == 1) {
+        stacked = std::move(batch.front().inputs);
+    } else {
+        const size_t num_inputs = batch.front().inputs.size();
+        stacked.reserve(num_inputs);
+
+        std::vector<const atom::core::Tensor*> parts(batch.size());
+        for (size_t i = 0; i < num_inputs; ++i) {
+            for (size_t r = 0; r < batch.size(); ++r) {
+                parts[r] = &batch[r].inputs[i];
+            }
+            auto tensor = atom::core::Tensor::ConcatBatch(parts);
+            if (!tensor) {
+                FailAll(*completions, tensor.error());
+                FinishBatch();
+                return;
+            }
+            stacked.push_back(std::move(*tensor));
+        }
+    }
+
+    auto on_done = [this, completions, batch_sizes = std::move(batch_sizes)](
+        atom::core::Result<std::vector<atom::core::Tensor>> result) {
+        Deliver(*completions, batch_sizes, std::move(result));
+        FinishBatch();
+    };
+
+    // The callback is not invoked when submission fails, so report from here
+    auto submitted = model_->InferAsync(std::move(stacked), std::move(on_done));
+    if (!submitted) {
+        LOG_WARNING("Batched inference submission failed: " + submitted.error().message);
+        FailAll(*completions, submitted.error());
+        FinishBatch();
+    }
+}
+
+void DynamicBatcher::Deliver(std::vector<Completion>& completions, const std::vector<atom::core::i64>& batch_sizes,
+                             atom::core::Result<std::vector<atom::core::Tensor>> result) {
+    if (!result) {
+        FailAll(completions, result.error());
+        return;
+    }
+    if (completions.size() == 1) {
+        if (completions.front()) completions.front()(std::move(result));
+        return;
+    }
+
+    // Split every output back into per-request slices
+    std::vector<std::vector<atom::core::Tensor>> outputs(completions.size());
+    for (const auto& output : *result) {
+        auto split = output.SplitBatch(batch_sizes);
+        if (!split) {
+            FailAll(completions, split.error());
+            return;
+        }
+        for (size_t r = 0; r < outputs.size(); ++r) {
+            outputs[r].push_back(std::move((*split)[r]));
+        }
+    }
+
+    for (size_t r = 0; r < outputs.size(); ++r) {
+        if (completions[r]) completions[r](std::move(outputs[r]));
+    }
+}
+
+void DynamicBatcher::FailAll(std::vector<Completion>& completions, const atom::core::Error& error) {
+    stats_.failed_batches++;
+    for (auto& completion : completions) {
+        if (completion) completion(std::unexpected(error));
+    }
+}
+
+void DynamicBatcher::FinishBatch() {
+    // Notified under the lock: Stop may destroy the batcher once it sees zero
+    std::lock_guard<std::mutex> lock(mutex_);
+    in_flight_--;
+    cv_.notify_all();
+    idle_cv_.notify_all();
+}
+
+} // namespace atom::scheduler
@@ -0,0 +1,187 @@
+#include "atom/scheduler/fair_queue.hpp"
+#include <algorithm>
+
+namespace atom::scheduler {
+
+namespace {
+
+// Heap order for backlogged tenants: smallest tag on top
+constexpr auto kLaterEntry = [](const auto& a, const auto& b) {
+    return a.tag != b.tag ? a.tag > b.tag : a.sequence > b.sequence;
+};
+
+constexpr auto kLaterIdle = [](const auto& a, const auto& b) { return a.tag > b.tag; };
+
+} // namespace
+
+FairQueue::FairQueue(SchedulingPolicy policy, atom::core::Duration aging_interval)
+    : policy_(policy), aging_interval_(aging_interval) {
+    for (auto& cls : classes_) {
+        cls.spare.reserve(kSpareTenants);
+    }
+}
+
+bool FairQueue::TaskLess(const TaskPtr& a, const TaskPtr& b) const {
+    if (policy_ == SchedulingPolicy::EarliestDeadlineFirst) {
+        return Task::DeadlineLess(*a, *b);
+    }
+    return a->GetSequence() > b->GetSequence();
+}
+
+void FairQueue::SetWeight(const std::string& tenant, double weight) {
+    weight = std::max(weight, 1e-3);
+    weights_[tenant] = weight;
+    for (auto& cls : classes_) {
+        auto it = cls.tenants.find(tenant);
+        if (it != cls.tenants.end()) it->second.weight = weight;
+    }
+}
+
+void FairQueue::Activate(Class& cls, Tenant& tenant, double tag) {
+    tenant.tag = tag;
+    cls.backlogged.push_back(HeapEntry{tag, sequence_++, &tenant});
+    std::push_heap(cls.backlogged.begin(), cls.backlogged.end(), kLaterEntry);
+}
+
+void FairQueue::Push(TaskPtr task) {
+    auto& cls = classes_[static_cast<size_t>(task->GetPriority())];
+    if (cls.size == 0) {
+        cls.waiting_since = std::chrono::high_resolution_clock::now();
+    }
+
+    const std::string& key = task->GetTenant().empty() ? task->GetModel()->GetName() : task->GetTenant();
+    Tenant& tenant = FindTenant(cls, key)->second;
+
+    const bool was_idle = tenant.tasks.empty();
+    tenant.tasks.push_back(std::move(task));
+    std::push_heap(tenant.tasks.begin(), tenant.tasks.end(),
+                   [this](const TaskPtr& a, const TaskPtr& b) { return TaskLess(a, b); });
+
+    // A tenant returning from idle starts at the current virtual time, so
+    // idling earns it no credit
+    if (was_idle) {
+        Activate(cls, tenant, std::max(cls.virtual_time, tenant.tag) + 1.0 / tenant.weight);
+    }
+    cls.size++;
+    size_++;
+}
+
+size_t FairQueue::PickClass(atom::core::TimePoint now) const {
+    size_t pick = 0;
+    for (size_t c = kClassCount; c-- > 0;) {
+        if (classes_[c].size > 0) {
+            pick = c;
+            break;
+        }
+    }
+
+    // Aging: of the lower classes unserved for aging_interval, the one
+    // waiting longest goes first
+    size_t aged = kClassCount;
+    for (size_t c = 0; c < pick; ++c) {
+        const auto& cls = classes_[c];
+        if (cls.size > 0 && now - cls.waiting_since >= aging_interval_ &&
+            (aged == kClassCount || cls.waiting_since < classes_[aged].waiting_since)) {
+            aged = c;
+        }
+    }
+    return aged != kClassCount ? aged : pick;
+}
+
+TaskPtr FairQueue::Pop() {
+    if (size_ == 0) return nullptr;
+
+    const auto now = std::chrono::high_resolution_clock::now();
+    auto& cls = classes_[PickClass(now)];
+
+    std::pop_heap(cls.backlogged.begin(), cls.backlogged.end(), kLaterEntry);
+    const HeapEntry entry = cls.backlogged.back();
+    cls.backlogged.pop_back();
+
+    Tenant& tenant = *entry.tenant;
+    std::pop_heap(tenant.tasks.begin(), tenant.tasks.end(),
+                  [this](const TaskPtr& a, const TaskPtr& b) { return TaskLess(a, b); });
+    TaskPtr task = std::move(tenant.tasks.back());
+    tenant.tasks.pop_back();
+
+    // Virtual time follows the start tag of the dispatch in service
+    cls.virtual_time = std::max(cls.virtual_time, entry.tag - 1.0 / tenant.weight);
+    if (!tenant.tasks.empty()) {
+        Activate(cls, tenant, entry.tag + 1.0 / tenant.weight);
+    } else if (!tenant.idle_listed) {
+        tenant.idle_listed = true;
+        cls.idle.push_back(IdleEntry{tenant.tag, &tenant});
+        std::push_heap(cls.idle.begin(), cls.idle.end(), kLaterIdle);
+    }
+
+    cls.size--;
+    cls.waiting_since = now;
+    size_--;
+
+    if (cls.size == 0) {
+        // Idle class: virtual time jumps to the largest tag, as in SFQ, and
+        // every tenant has caught up
+        for (const auto& [key, idle] : cls.tenants) {
+            cls.virtual_time = std::max(cls.virtual_time, idle.tag);
+        }
+        for (auto it = cls.tenants.begin(); it != cls.tenants.end();) {
+            Forget(cls, it++);
+        }
+        cls.idle.clear();
+    } else {
+        RetireIdle(cls);
+    }
+    return task;
+}
+
+void FairQueue::RetireIdle(Class& cls) {
+    while (!cls.idle.empty() && cls.idle.front().tag <= cls.virtual_time) {
+        std::pop_heap(cls.idle.begin(), cls.idle.end(), kLaterIdle);
+        Tenant* tenant = cls.idle.back().tenant;
+        cls.idle.pop_back();
+        tenant->idle_listed = false;
+
+        if (!tenant->tasks.empty()) continue;       // relisted when it next goes idle
+        if (tenant->tag <= cls.virtual_time) {
+            Forget(cls, cls.tenants.find(*tenant->key));
+        } else {
+            // Went idle again since, with a later tag
+            tenant->idle_listed = true;
+            cls.idle.push_back(IdleEntry{tenant->tag, tenant});
+            std::push_heap(cls.idle.begin(), cls.idle.end(), kLaterIdle);
+        }
+    }
+}
+
+FairQueue::TenantMap::iterator FairQueue::FindTenant(Class& cls, const std::string& key) {
+    auto it = cls.tenants.find(key);
+    if (it != cls.tenants.end()) return it;
+
+    // A spare node keeps its task heap's capacity, so a returning tenant
+    // does not allocate
+    if (!cls.spare.empty()) {
+        auto node = std::move(cls.spare.back());
+        cls.spare.pop_back();
+        node.key() = key;
+        node.mapped().weight = 1.0;
+        node.mapped().tag = 0.0;
+        node.mapped().idle_listed = false;
+        it = cls.tenants.insert(std::move(node)).position;
+    } else {
+        it = cls.tenants.try_emplace(key).first;
+    }
+    it->second.key = &it->first;
+    auto weight = weights_.find(key);
+    if (weight != weights_.end()) it->second.weight = weight->second;
+    return it;
+}
+
+void FairQueue::Forget(Class& cls, TenantMap::iterator it) {
+    if (cls.spare.size() < kSpareTenants) {
+        cls.spare.push_back(cls.tenants.extract(it));
+    } else {
+        cls.tenants.erase(it);
+    }
+}
+
+} // namespace atom::scheduler
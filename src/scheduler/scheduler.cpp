@@ -1,4 +1,944 @@
-// Placeholder implementation for scheduler/scheduler
 #include "atom/scheduler/scheduler.hpp"
+#include "atom/logging/logger.hpp"
+#include <algorithm>
+#include <iterator>
 
-// TODO: Implement scheduler/scheduler
+namespace atom::scheduler {
+
+namespace {
+
+// Set on a worker while it runs a dispatched task: a graph node finishing
+// there may leave its successor here to run next on the same dispatch
+thread_local TaskPtr* t_continuation = nullptr;
+
+// Saturates to no deadline for non-positive or huge timeouts
+std::optional<atom::core::TimePoint> DeadlineAfter(atom::core::Duration timeout) {
+    if (timeout <= atom::core::Duration::zero()) return std::nullopt;
+    const auto now = std::chrono::high_resolution_clock::now();
+    if (timeout > atom::core::TimePoint::max() - now) return std::nullopt;
+    return now + timeout;
+}
+
+// However far the limit backs off, every worker can still be kept busy
+AdmissionConfig WithWorkerFloor(AdmissionConfig admission, size_t workers) {
+    admission.min_limit = std::max(admission.min_limit, workers);
+    return admission;
+}
+
+} // namespace
+
+Scheduler::Scheduler(const SchedulerConfig& config)
+    : config_(config)
+    , task_pool_(config.result_retention)
+    , admission_(config.max_queue_size, WithWorkerFloor(config.admission, std::max<size_t>(config.num_threads, 1)))
+    , ready_queue_(config.policy, config.aging_interval) {
+    config_.num_threads = std::max<size_t>(config_.num_threads, 1);
+    for (const auto& [tenant, weight] : config_.tenant_weights) {
+        ready_queue_.SetWeight(tenant, weight);
+    }
+}
+
+Scheduler::~Scheduler() {
+    Stop();
+}
+
+atom::core::Result<void> Scheduler::Start() {
+    if (running_) {
+        return {};
+    }
+
+    try {
+        thread_pool_ = std::make_unique<ThreadPool>(config_.num_threads, config_.worker_affinity);
+    } catch (const std::exception& e) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::SchedulerError,
+            "Failed to create thread pool: " + std::string(e.what())));
+    }
+
+    running_ = true;
+    scheduler_thread_ = std::thread([this]() { SchedulerLoop(); });
+    return {};
+}
+
+void Scheduler::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        if (!running_) return;
+        running_ = false;
+    }
+    queue_cv_.notify_all();
+
+    if (scheduler_thread_.joinable()) {
+        scheduler_thread_.join();
+    }
+
+    // Let dispatched tasks finish, then flush whatever the batchers still hold
+    if (thread_pool_) {
+        thread_pool_->Stop();
+    }
+    {
+        std::shared_lock lock(batchers_mutex_);
+        for (auto& [_, batcher] : batchers_) {
+            batcher->Stop();
+        }
+    }
+    // Completions of batched tasks call back into the scheduler
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        idle_cv_.wait(lock, [this]() { return running_count_ == 0; });
+    }
+
+    // Tasks that never got dispatched are cancelled so waiters do not hang
+    std::vector<TaskPtr> abandoned;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        while (auto task = ready_queue_.Pop()) {
+            abandoned.push_back(std::move(task));
+        }
+    }
+    task_pool_.ForEach([&abandoned](TaskPool::Record& record) {
+        // Free records hold a task reset to id 0
+        std::lock_guard<std::mutex> lock(record.mutex);
+        if (!record.finished && record.task->GetId() != 0 && record.task->GetStatus() == TaskStatus::Pending) {
+            abandoned.push_back(record.task);
+        }
+    });
+    for (auto& task : abandoned) {
+        if (!task->TryUpdateStatus(TaskStatus::Pending, TaskStatus::Cancelled)) continue;
+        stats_.cancelled_tasks++;
+        FinishTask(task, TaskResult{
+            task->GetId(), TaskStatus::Cancelled, {}, atom::core::Duration::zero(),
+            ATOM_ERROR(atom::core::ErrorCode::SchedulerError, "Scheduler stopped")
+        });
+    }
+}
+
+atom::core::Result<TaskId> Scheduler::SubmitTask(
+    atom::core::ModelPtr model,
+    std::vector<atom::core::Tensor> inputs,
+    atom::core::Priority priority,
+    Task::Callback callback,
+    const SubmitOptions& options) {
+
+    return SubmitTaskWithDependencies(std::move(model), std::move(inputs), {},
+        priority, std::move(callback), options);
+}
+
+atom::core::Result<TaskId> Scheduler::SubmitTaskWithDependencies(
+    atom::core::ModelPtr model,
+    std::vector<atom::core::Tensor> inputs,
+    std::vector<TaskId> dependencies,
+    atom::core::Priority priority,
+    Task::Callback callback,
+    const SubmitOptions& options) {
+
+    return EnqueueTask(std::move(model), std::move(inputs), std::move(dependencies),
+        priority, std::move(callback), TaskAwaiter{}, options);
+}
+
+Scheduler::SubmitAwaiter Scheduler::Submit(
+    atom::core::ModelPtr model,
+    std::vector<atom::core::Tensor> inputs,
+    atom::core::Priority priority) {
+
+    return SubmitAwaiter(*this, std::move(model), std::move(inputs), priority, SubmitOptions{});
+}
+
+Scheduler::SubmitAwaiter Scheduler::Submit(
+    atom::core::ModelPtr model,
+    std::vector<atom::core::Tensor> inputs,
+    atom::core::Priority priority,
+    SubmitOptions options) {
+
+    return SubmitAwaiter(*this, std::move(model), std::move(inputs), priority, std::move(options));
+}
+
+Scheduler::SubmitAwaiter::SubmitAwaiter(Scheduler& scheduler, atom::core::ModelPtr model,
+    std::vector<atom::core::Tensor> inputs, atom::core::Priority priority, SubmitOptions options)
+    : scheduler_(&scheduler)
+    , model_(std::move(model))
+    , inputs_(std::move(inputs))
+    , priority_(priority)
+    , options_(std::move(options)) {}
+
+bool Scheduler::SubmitAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    // Once admitted the task may finish and resume the coroutine on a worker
+    // before this returns, so nothing here is touched afterwards
+    auto id = scheduler_->EnqueueTask(std::move(model_), std::move(inputs_), {}, priority_,
+        nullptr, TaskAwaiter{handle, &result_}, options_);
+    if (!id) {
+        error_ = std::move(id.error());
+        return false;
+    }
+    return true;
+}
+
+atom::core::Result<TaskResult> Scheduler::SubmitAwaiter::await_resume() {
+    if (error_) return std::unexpected(std::move(*error_));
+    return std::move(*result_);
+}
+
+atom::core::Result<TaskId> Scheduler::EnqueueTask(
+    atom::core::ModelPtr model,
+    std::vector<atom::core::Tensor> inputs,
+    std::vector<TaskId> dependencies,
+    atom::core::Priority priority,
+    Task::Callback callback,
+    TaskAwaiter awaiter,
+    const SubmitOptions& options) {
+
+    if (!running_) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::SchedulerError,
+            "Scheduler is not running"));
+    }
+    if (!model) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Task requires a model"));
+    }
+    if (auto admitted = admission_.Acquire(priority); !admitted) {
+        stats_.rejected_tasks++;
+        return std::unexpected(std::move(admitted.error()));
+    }
+
+    TaskId id;
+    TaskPool::Record* record = task_pool_.Acquire(id);
+    if (!record) {
+        admission_.Release(1, false);
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::SchedulerError,
+            "Too many tasks in flight"));
+    }
+
+    Task& task = *record->task;
+    task.Reset(id, std::move(model), std::move(inputs), priority);
+    task.SetSequence(NextSequence());
+    task.SetCallback(std::move(callback));
+    task.SetAwaiter(awaiter);
+    task.SetDeadline(DeadlineAfter(options.timeout.value_or(config_.task_timeout)));
+    if (task.GetTenant() != options.tenant) task.SetTenant(options.tenant);
+    task.SetNumaNode(ResolveNumaNode(task.GetModel().get(), task.GetInputs(), options));
+
+    // Each unfinished dependency records this task as a dependent; the extra
+    // count keeps it from becoming ready before registration is over
+    record->pending.store(1, std::memory_order_relaxed);
+    for (TaskId dep_id : dependencies) {
+        TaskPool::Record* dep = task_pool_.Find(dep_id);
+        std::optional<atom::core::Error> error;
+        if (dep) {
+            std::lock_guard<std::mutex> lock(dep->mutex);
+            if (dep->generation != TaskPool::GenerationOf(dep_id) || dep->consumed) {
+                dep = nullptr;
+            } else if (!dep->finished) {
+                dep->dependents.push_back(id);
+                record->pending.fetch_add(1, std::memory_order_relaxed);
+            } else if (dep->task->GetStatus() != TaskStatus::Completed) {
+                error = ATOM_ERROR(atom::core::ErrorCode::SchedulerError,
+                    "Dependency task did not complete: " + std::to_string(dep_id));
+            }
+        }
+        if (!dep) {
+            error = ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+                "Unknown dependency task: " + std::to_string(dep_id));
+        }
+        if (error) {
+            // Dependents lists still naming this id skip it once the generation moves on
+            task_pool_.Discard(id);
+            admission_.Release(1, false);
+            return std::unexpected(std::move(*error));
+        }
+        task.AddDependency(dep_id);
+    }
+
+    stats_.total_tasks++;
+
+    if (record->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        PushReady(record->task);
+    }
+    return id;
+}
+
+atom::core::Result<std::vector<TaskId>> Scheduler::SubmitBatch(
+    const std::vector<std::pair<atom::core::ModelPtr, std::vector<atom::core::Tensor>>>& batch,
+    atom::core::Priority priority,
+    const SubmitOptions& options) {
+
+    for (const auto& [model, inputs] : batch) {
+        if (!model) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+                "Task requires a model"));
+        }
+    }
+
+    std::vector<TaskId> task_ids;
+    task_ids.reserve(batch.size());
+
+    for (const auto& [model, inputs] : batch) {
+        auto task_id = SubmitTask(model, inputs, priority, nullptr, options);
+        if (!task_id) {
+            // All or nothing: the caller never sees these ids, so cancel what
+            // has not started and drop the results of what has
+            for (TaskId id : task_ids) {
+                static_cast<void>(CancelTask(id));
+                task_pool_.Consume(id);
+            }
+            return std::unexpected(task_id.error());
+        }
+        task_ids.push_back(*task_id);
+    }
+
+    return task_ids;
+}
+
+atom::core::Result<void> Scheduler::SubmitGraph(
+    const TaskGraphPtr& graph,
+    std::vector<atom::core::Tensor> inputs,
+    GraphRun::Callback callback,
+    const SubmitOptions& options) {
+
+    if (!running_) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::SchedulerError,
+            "Scheduler is not running"));
+    }
+    if (!graph || !graph->IsCompiled()) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Task graph must be compiled before it is submitted"));
+    }
+
+    // A run is admitted whole, at the priority of its most urgent node
+    auto priority = atom::core::Priority::Low;
+    for (const auto& node : graph->nodes_) {
+        priority = std::max(priority, node.priority);
+    }
+    if (auto admitted = admission_.Acquire(priority, graph->GetNodeCount()); !admitted) {
+        stats_.rejected_tasks++;
+        return std::unexpected(std::move(admitted.error()));
+    }
+
+    // The run belongs to its tasks until FinishGraphRun hands it back to the pool
+    GraphRun& run = *graph->AcquireRun().release();
+    run.graph_ = graph;
+    run.callback_ = std::move(callback);
+    run.submitted_ = std::chrono::high_resolution_clock::now();
+    run.failed_ = false;
+    run.status_ = TaskStatus::Completed;
+    run.error_.reset();
+    run.finished_ = 0;
+
+    const auto deadline = DeadlineAfter(options.timeout.value_or(config_.task_timeout));
+    const std::string& tenant = options.tenant.empty() ? graph->GetName() : options.tenant;
+    // A run stays on one node, where its intermediate outputs are produced
+    const int numa_node = ResolveNumaNode(nullptr, inputs, options);
+    for (TaskGraphTemplate::NodeId i = 0; i < graph->GetNodeCount(); ++i) {
+        const auto& node = graph->nodes_[i];
+        run.pending_[i].store(static_cast<atom::core::u32>(node.predecessors.size()), std::memory_order_relaxed);
+        run.readers_[i].store(static_cast<atom::core::u32>(node.successors.size()), std::memory_order_relaxed);
+
+        auto& task = *run.tasks_[i];
+        task.Reset(NextSequence(), {});
+        task.SetDeadline(deadline);
+        task.SetNumaNode(numa_node);
+        if (task.GetTenant() != tenant) task.SetTenant(tenant);
+    }
+
+    const auto& roots = graph->GetRoots();
+    for (size_t r = 0; r < roots.size(); ++r) {
+        auto& task = *run.tasks_[roots[r]];
+        if (r + 1 == roots.size()) {
+            task.SetInputs(std::move(inputs));
+        } else {
+            task.SetInputs(inputs);
+        }
+    }
+    run.in_flight_.store(static_cast<atom::core::u32>(roots.size()), std::memory_order_release);
+    stats_.total_tasks += graph->GetNodeCount();
+
+    for (TaskGraphTemplate::NodeId root : roots) {
+        PushReady(run.tasks_[root]);
+    }
+    return {};
+}
+
+void Scheduler::SetModelNumaNode(const atom::core::ModelPtr& model, int node) {
+    std::unique_lock lock(model_nodes_mutex_);
+    if (node < 0) {
+        model_nodes_.erase(model.get());
+    } else {
+        model_nodes_[model.get()] = node;
+    }
+}
+
+int Scheduler::ResolveNumaNode(const atom::core::IModel* model,
+    const std::vector<atom::core::Tensor>& inputs, const SubmitOptions& options) const {
+
+    // Without per-node worker groups every worker is as good as any other
+    if (thread_pool_->GetNodeGroupCount() < 2) return -1;
+    if (options.numa_node) return *options.numa_node;
+    if (model) {
+        std::shared_lock lock(model_nodes_mutex_);
+        auto it = model_nodes_.find(model);
+        if (it != model_nodes_.end()) return it->second;
+    }
+    for (const auto& input : inputs) {
+        if (input.GetDevice().type == atom::core::DeviceType::CPU && !input.IsEmpty()) {
+            return atom::core::NumaNodeOfAddress(input.GetData());
+        }
+    }
+    return -1;
+}
+
+void Scheduler::SetTenantWeight(const std::string& tenant, double weight) {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    ready_queue_.SetWeight(tenant, weight);
+}
+
+atom::core::Result<void> Scheduler::EnableBatching(atom::core::ModelPtr model, BatchingConfig config) {
+    if (!model) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Batching requires a model"));
+    }
+
+    std::unique_lock lock(batchers_mutex_);
+    const auto* key = model.get();
+    if (batchers_.count(key)) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Batching already enabled for model: " + model->GetName()));
+    }
+
+    auto batcher = std::make_shared<DynamicBatcher>(std::move(model), std::move(config));
+    batcher->Start();
+    batchers_[key] = std::move(batcher);
+    return {};
+}
+
+void Scheduler::DisableBatching(const atom::core::ModelPtr& model) {
+    std::shared_ptr<DynamicBatcher> batcher;
+    {
+        std::unique_lock lock(batchers_mutex_);
+        auto it = batchers_.find(model.get());
+        if (it == batchers_.end()) return;
+        batcher = std::move(it->second);
+        batchers_.erase(it);
+    }
+    // Dispatches whatever is still queued and waits for it before returning
+    batcher->Stop();
+}
+
+const DynamicBatcher* Scheduler::GetBatcher(const atom::core::ModelPtr& model) const {
+    return FindBatcher(model.get()).get();
+}
+
+std::shared_ptr<DynamicBatcher> Scheduler::FindBatcher(const atom::core::IModel* model) const {
+    std::shared_lock lock(batchers_mutex_);
+    auto it = batchers_.find(model);
+    return it == batchers_.end() ? nullptr : it->second;
+}
+
+TaskPtr Scheduler::FindTask(TaskId task_id) const {
+    TaskPool::Record* record = task_pool_.Find(task_id);
+    if (!record) return nullptr;
+    std::lock_guard<std::mutex> lock(record->mutex);
+    const bool live = record->generation == TaskPool::GenerationOf(task_id) && !record->consumed;
+    return live ? record->task : nullptr;
+}
+
+atom::core::Result<void> Scheduler::CancelTask(TaskId task_id) {
+    TaskPtr task = FindTask(task_id);
+    if (!task) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Unknown task: " + std::to_string(task_id)));
+    }
+
+    // Races ExecuteTask's Pending -> Running; only the winner goes on
+    if (!task->TryUpdateStatus(TaskStatus::Pending, TaskStatus::Cancelled)) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Only pending tasks can be cancelled"));
+    }
+
+    // A cancelled task left in the ready queue is skipped on dispatch
+    stats_.cancelled_tasks++;
+    FinishTask(task, TaskResult{
+        task_id, TaskStatus::Cancelled, {}, atom::core::Duration::zero(), std::nullopt
+    });
+    return {};
+}
+
+atom::core::Result<TaskResult> Scheduler::WaitForTask(TaskId task_id,
+    std::optional<atom::core::Duration> timeout) {
+
+    auto unknown = [task_id]() {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Unknown task: " + std::to_string(task_id)));
+    };
+
+    TaskPool::Record* record = task_pool_.Find(task_id);
+    if (!record) return unknown();
+
+    std::optional<TaskResult> result;
+    {
+        std::unique_lock<std::mutex> lock(record->mutex);
+        if (record->generation != TaskPool::GenerationOf(task_id) || record->consumed) return unknown();
+
+        // Registered waiters keep the record from being retired under them
+        record->waiters++;
+        auto published = [record]() { return record->result.has_value(); };
+        if (timeout) {
+            record->cv.wait_for(lock, *timeout, published);
+        } else {
+            record->cv.wait(lock, published);
+        }
+        record->waiters--;
+
+        if (!record->result) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::Timeout,
+                "Timed out waiting for task " + std::to_string(task_id)));
+        }
+        // The last waiter takes the result, the others copy it
+        if (record->waiters > 0) return *record->result;
+        result = std::move(record->result);
+        record->result.reset();
+        record->consumed = true;
+    }
+
+    task_pool_.Consume(task_id);
+    return std::move(*result);
+}
+
+atom::core::Result<std::vector<TaskResult>> Scheduler::WaitForAll(
+    const std::vector<TaskId>& task_ids,
+    std::optional<atom::core::Duration> timeout) {
+
+    const auto deadline = std::chrono::high_resolution_clock::now() +
+        timeout.value_or(atom::core::Duration::zero());
+
+    std::vector<TaskResult> results;
+    results.reserve(task_ids.size());
+
+    for (TaskId task_id : task_ids) {
+        std::optional<atom::core::Duration> remaining;
+        if (timeout) {
+            remaining = std::max(atom::core::Duration::zero(),
+                std::chrono::duration_cast<atom::core::Duration>(
+                    deadline - std::chrono::high_resolution_clock::now()));
+        }
+
+        auto result = WaitForTask(task_id, remaining);
+        if (!result) {
+            return std::unexpected(result.error());
+        }
+        results.push_back(std::move(*result));
+    }
+
+    return results;
+}
+
+std::optional<TaskStatus> Scheduler::GetTaskStatus(TaskId task_id) const {
+    TaskPtr task = FindTask(task_id);
+    if (!task) {
+        return std::nullopt;
+    }
+    return task->GetStatus();
+}
+
+size_t Scheduler::GetQueuedTaskCount() const {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    return ready_queue_.Size();
+}
+
+size_t Scheduler::GetRunningTaskCount() const {
+    return running_count_.load();
+}
+
+size_t Scheduler::GetCompletedTaskCount() const {
+    return stats_.completed_tasks.load();
+}
+
+std::optional<atom::core::Duration> Scheduler::GetObservedLatency(const atom::core::ModelPtr& model) const {
+    return ObservedLatency(model.get(), 1);
+}
+
+void Scheduler::ResetStatistics() {
+    stats_.total_tasks = 0;
+    stats_.completed_tasks = 0;
+    stats_.failed_tasks = 0;
+    stats_.cancelled_tasks = 0;
+    stats_.total_execution_time_ns = 0;
+    stats_.shed_tasks = 0;
+    stats_.deadline_misses = 0;
+    stats_.rejected_tasks = 0;
+}
+
+void Scheduler::SchedulerLoop() {
+    const size_t max_dispatched = thread_pool_->GetThreadCount();
+
+    while (true) {
+        TaskPtr task;
+        std::optional<atom::core::Error> shed;
+        {
+            // Hold tasks back until a worker is free so priority order is kept
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_cv_.wait(lock, [this, max_dispatched]() {
+                return !running_ || (!ready_queue_.Empty() && dispatched_count_ < max_dispatched);
+            });
+
+            if (!running_) break;
+
+            task = ready_queue_.Pop();
+
+            if (task->GetStatus() != TaskStatus::Pending) continue;
+            shed = CheckDeadline(*task);
+            if (!shed) dispatched_count_++;
+        }
+
+        // A task that cannot make its deadline would only delay the ones behind it
+        if (shed) {
+            ShedTask(std::move(task), std::move(*shed));
+            continue;
+        }
+
+        const int numa_node = task->GetNumaNode();
+        thread_pool_->Post([this, task]() {
+            TaskPtr next = task;
+            TaskPtr continuation;
+            t_continuation = &continuation;
+            while (next) {
+                ExecuteTask(std::move(next));
+                next = std::move(continuation);
+            }
+            t_continuation = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex_);
+                dispatched_count_--;
+            }
+            queue_cv_.notify_all();
+        }, numa_node);
+    }
+}
+
+void Scheduler::ExecuteTask(TaskPtr task) {
+    // A shed task never starts
+    if (auto shed = CheckDeadline(*task)) {
+        ShedTask(std::move(task), std::move(*shed));
+        return;
+    }
+    // Claimed against a concurrent CancelTask
+    if (!task->TryUpdateStatus(TaskStatus::Pending, TaskStatus::Running)) return;
+
+    task->SetStartTime(std::chrono::high_resolution_clock::now());
+    running_count_++;
+    admission_.OnStarted();
+
+    auto complete = [this, task](atom::core::Result<std::vector<atom::core::Tensor>> outputs) {
+        const auto end_time = std::chrono::high_resolution_clock::now();
+        task->SetEndTime(end_time);
+
+        if (outputs) {
+            RecordLatency(task->GetModel().get(), task->GetExecutionTime());
+            const auto& deadline = task->GetDeadline();
+            if (deadline && end_time > *deadline) {
+                stats_.deadline_misses++;
+            }
+            OnTaskCompleted(task, TaskResult{
+                task->GetId(), TaskStatus::Completed, std::move(*outputs),
+                task->GetExecutionTime(), std::nullopt
+            });
+        } else {
+            OnTaskFailed(task, outputs.error());
+        }
+
+        // Last: once Stop sees no running task the scheduler may be destroyed
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        if (--running_count_ == 0) idle_cv_.notify_all();
+    };
+
+    // Batched models complete asynchronously and release this worker right away
+    if (auto batcher = FindBatcher(task->GetModel().get())) {
+        auto enqueued = batcher->Enqueue(task->TakeInputs(), complete);
+        if (!enqueued) {
+            complete(std::unexpected(enqueued.error()));
+        }
+        return;
+    }
+
+    try {
+        complete(task->GetModel()->Infer(task->GetInputs()));
+    } catch (const std::exception& e) {
+        complete(std::unexpected(ATOM_ERROR(atom::core::ErrorCode::Unknown,
+            "Task threw: " + std::string(e.what()))));
+    }
+}
+
+void Scheduler::OnTaskCompleted(TaskPtr task, const TaskResult& result) {
+    stats_.completed_tasks++;
+    stats_.total_execution_time_ns += static_cast<uint64_t>(result.execution_time.count());
+    FinishTask(std::move(task), result);
+}
+
+void Scheduler::OnTaskFailed(TaskPtr task, const atom::core::Error& error) {
+    stats_.failed_tasks++;
+    FinishTask(task, TaskResult{
+        task->GetId(), TaskStatus::Failed, {}, task->GetExecutionTime(), error
+    });
+}
+
+std::optional<atom::core::Error> Scheduler::CheckDeadline(const Task& task) const {
+    const auto& deadline = task.GetDeadline();
+    if (!config_.shed_late_tasks || !deadline) return std::nullopt;
+
+    const auto now = std::chrono::high_resolution_clock::now();
+    if (now >= *deadline) {
+        return ATOM_ERROR(atom::core::ErrorCode::Timeout,
+            "Task " + std::to_string(task.GetId()) + " expired before it could run");
+    }
+    auto latency = ObservedLatency(task.GetModel().get(), std::max<size_t>(config_.min_latency_samples, 1));
+    if (latency && *latency > *deadline - now) {
+        return ATOM_ERROR(atom::core::ErrorCode::Timeout,
+            "Task " + std::to_string(task.GetId()) + " cannot finish before its deadline");
+    }
+    return std::nullopt;
+}
+
+void Scheduler::ShedTask(TaskPtr task, atom::core::Error error) {
+    // Claimed like a cancel; whoever loses the race leaves the task alone
+    if (!task->TryUpdateStatus(TaskStatus::Pending, TaskStatus::Failed)) return;
+    stats_.shed_tasks++;
+    stats_.failed_tasks++;
+    const TaskId id = task->GetId();
+    FinishTask(std::move(task), TaskResult{
+        id, TaskStatus::Failed, {}, atom::core::Duration::zero(), std::move(error)
+    });
+}
+
+void Scheduler::ReleaseAdmission(const Task& task, const TaskResult& result) {
+    const bool started = task.HasStarted();
+    if (result.status == TaskStatus::Completed) {
+        admission_.Release(task.GetQueueDelay(), result.execution_time);
+    } else if (!started && result.error && result.error->code == atom::core::ErrorCode::Timeout) {
+        admission_.ReleaseDropped();
+    } else {
+        admission_.Release(1, started);
+    }
+}
+
+void Scheduler::RecordLatency(const atom::core::IModel* model, atom::core::Duration latency) {
+    std::lock_guard<std::mutex> lock(latency_mutex_);
+    auto& window = latencies_[model];
+    window.samples[window.next] = latency.count();
+    window.next = (window.next + 1) % window.samples.size();
+    window.count = std::min(window.count + 1, window.samples.size());
+}
+
+std::optional<atom::core::Duration> Scheduler::ObservedLatency(
+    const atom::core::IModel* model, size_t min_samples) const {
+
+    std::array<atom::core::i64, 64> samples;
+    size_t count;
+    {
+        std::lock_guard<std::mutex> lock(latency_mutex_);
+        auto it = latencies_.find(model);
+        if (it == latencies_.end() || it->second.count < min_samples) return std::nullopt;
+        count = it->second.count;
+        std::copy_n(it->second.samples.begin(), count, samples.begin());
+    }
+    std::nth_element(samples.begin(), samples.begin() + count / 2, samples.begin() + count);
+    return atom::core::Duration(samples[count / 2]);
+}
+
+void Scheduler::FinishTask(TaskPtr task, TaskResult result) {
+    if (auto* run = task->GetGraphRun()) {
+        FinishGraphNode(*run, task, std::move(result));
+        return;
+    }
+
+    const TaskId id = task->GetId();
+    const bool succeeded = result.status == TaskStatus::Completed;
+    TaskPool::Record& record = *task_pool_.Find(id);
+
+    // The dependents list is borrowed and handed back below, so its
+    // capacity stays with the record
+    std::vector<TaskId> dependents;
+    {
+        std::lock_guard<std::mutex> lock(record.mutex);
+        if (record.generation != TaskPool::GenerationOf(id) || record.finished) {
+            return; // Already finished (e.g. cancelled while being dispatched)
+        }
+        record.finished = true;
+        task->SetStatus(result.status);
+        dependents.swap(record.dependents);
+    }
+    ReleaseAdmission(*task, result);
+
+    // Only dependents whose last dependency this was come back; those of a
+    // failed or cancelled task can never run
+    std::vector<TaskPtr> orphaned;
+    for (TaskId dependent_id : dependents) {
+        TaskPool::Record* dependent = task_pool_.Find(dependent_id);
+        TaskPtr ready;
+        {
+            std::lock_guard<std::mutex> lock(dependent->mutex);
+            if (dependent->generation != TaskPool::GenerationOf(dependent_id) || dependent->finished) continue;
+            if (!succeeded) {
+                orphaned.push_back(dependent->task);
+            } else if (dependent->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                ready = dependent->task;
+            }
+        }
+        if (ready && ready->GetStatus() == TaskStatus::Pending) {
+            PushReady(std::move(ready));
+        }
+    }
+
+    try {
+        task->InvokeCallback(result);
+    } catch (const std::exception& e) {
+        LOG_ERROR("Task callback threw: " + std::string(e.what()));
+    }
+
+    // An awaiting coroutine takes the result, so the record retires without
+    // waiting out the retention; a concurrent WaitForTask gets a copy
+    const TaskAwaiter awaiter = task->TakeAwaiter();
+    bool waiters;
+    {
+        std::lock_guard<std::mutex> lock(record.mutex);
+        waiters = record.waiters > 0;
+        if (!awaiter) {
+            record.result = std::move(result);
+        } else if (waiters) {
+            record.result = result;
+        } else {
+            record.consumed = true;
+        }
+        record.finished_at = std::chrono::high_resolution_clock::now();
+        dependents.clear();
+        record.dependents.swap(dependents);
+    }
+    if (waiters) {
+        record.cv.notify_all();
+    }
+    if (awaiter) {
+        *awaiter.result = std::move(result);
+        ResumeAwaiter(awaiter.handle, task->GetNumaNode());
+    }
+    task_pool_.Retire(id);
+
+    for (auto& dependent : orphaned) {
+        if (!dependent->TryUpdateStatus(TaskStatus::Pending, TaskStatus::Failed)) continue;
+        stats_.failed_tasks++;
+        FinishTask(dependent, TaskResult{
+            dependent->GetId(), TaskStatus::Failed, {}, atom::core::Duration::zero(),
+            ATOM_ERROR(atom::core::ErrorCode::SchedulerError,
+                "Dependency task did not complete: " + std::to_string(id))
+        });
+    }
+}
+
+void Scheduler::ResumeAwaiter(std::coroutine_handle<> handle, int node) {
+    // Tasks finished by Stop, after the pool is gone, resume the coroutine here
+    try {
+        thread_pool_->Post([handle]() { handle.resume(); }, node);
+    } catch (const std::runtime_error&) {
+        handle.resume();
+    }
+}
+
+void Scheduler::FinishGraphNode(GraphRun& run, const TaskPtr& task, TaskResult result) {
+    const auto& graph = *run.graph_;
+    const auto node = task->GetGraphNode();
+    task->SetStatus(result.status);
+    ReleaseAdmission(*task, result);
+
+    if (result.status == TaskStatus::Completed && !run.failed_.load(std::memory_order_acquire)) {
+        run.outputs_[node] = std::move(result.outputs);
+
+        // A successor is ready once its last predecessor got here; the last
+        // consumer of a node's outputs takes them, earlier ones copy
+        for (TaskGraphTemplate::NodeId next : graph.nodes_[node].successors) {
+            if (run.pending_[next].fetch_sub(1, std::memory_order_acq_rel) != 1) continue;
+
+            std::vector<atom::core::Tensor> inputs;
+            for (TaskGraphTemplate::NodeId prev : graph.nodes_[next].predecessors) {
+                auto& outputs = run.outputs_[prev];
+                if (run.readers_[prev].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::move(outputs.begin(), outputs.end(), std::back_inserter(inputs));
+                    outputs.clear();
+                } else {
+                    inputs.insert(inputs.end(), outputs.begin(), outputs.end());
+                }
+            }
+            run.tasks_[next]->SetInputs(std::move(inputs));
+            run.in_flight_.fetch_add(1, std::memory_order_relaxed);
+            if (!TakeContinuation(run.tasks_[next])) {
+                PushReady(run.tasks_[next]);
+            }
+        }
+    } else if (result.status != TaskStatus::Completed && !run.failed_.exchange(true, std::memory_order_acq_rel)) {
+        run.status_ = result.status;
+        run.error_ = result.error ? std::move(result.error) : ATOM_ERROR(atom::core::ErrorCode::SchedulerError,
+            "Task graph node cancelled: " + graph.GetName() + "/" + graph.GetNodeName(node));
+    }
+
+    run.finished_.fetch_add(1, std::memory_order_relaxed);
+    if (run.in_flight_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        FinishGraphRun(run);
+    }
+}
+
+void Scheduler::FinishGraphRun(GraphRun& run) {
+    const auto& graph = *run.graph_;
+    GraphResult result{
+        run.status_, {},
+        std::chrono::duration_cast<atom::core::Duration>(std::chrono::high_resolution_clock::now() - run.submitted_),
+        std::move(run.error_)
+    };
+
+    if (run.failed_.load(std::memory_order_relaxed)) {
+        // Nodes behind the failure never ran
+        const size_t skipped = graph.GetNodeCount() - run.finished_.load(std::memory_order_relaxed);
+        stats_.failed_tasks += skipped;
+        admission_.Release(skipped, false);
+    } else {
+        result.outputs.reserve(graph.GetSinks().size());
+        for (TaskGraphTemplate::NodeId sink : graph.GetSinks()) {
+            result.outputs.push_back(std::move(run.outputs_[sink]));
+        }
+    }
+    for (auto& outputs : run.outputs_) {
+        outputs.clear();
+    }
+    run.error_.reset();
+
+    // Back to the pool before the callback, so a callback that submits the
+    // next frame reuses this run
+    auto callback = std::move(run.callback_);
+    run.callback_ = nullptr;
+    std::shared_ptr<const TaskGraphTemplate> owner = std::move(run.graph_);
+    owner->ReleaseRun(std::unique_ptr<GraphRun>(&run));
+
+    if (callback) {
+        try {
+            callback(std::move(result));
+        } catch (const std::exception& e) {
+            LOG_ERROR("Task graph callback threw: " + std::string(e.what()));
+        }
+    }
+}
+
+bool Scheduler::TakeContinuation(const TaskPtr& task) {
+    // Skipping the queue is only fair when nothing else is waiting in it
+    if (!t_continuation || *t_continuation) return false;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        if (!running_ || !ready_queue_.Empty()) return false;
+    }
+    task->SetReadyTime(std::chrono::high_resolution_clock::now());
+    *t_continuation = task;
+    return true;
+}
+
+void Scheduler::PushReady(TaskPtr task) {
+    task->SetReadyTime(std::chrono::high_resolution_clock::now());
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        ready_queue_.Push(std::move(task));
+    }
+    queue_cv_.notify_all();
+}
+
+} // namespace atom::scheduler
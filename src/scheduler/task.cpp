@@ -1,4 +1,50 @@
-// Placeholder implementation for scheduler/task
 #include "atom/scheduler/task.hpp"
+#include <algorithm>
 
-// TODO: Implement scheduler/task
+namespace atom::scheduler {
+
+Task::Task(TaskId id, 
+           atom::core::ModelPtr model,
+           std::vector<atom::core::Tensor> inputs,
+           atom::core::Priority priority)
+    : id_(id), sequence_(id), model_(std::move(model)), inputs_(std::move(inputs)), priority_(priority) {}
+
+void Task::Reset(TaskId id, std::vector<atom::core::Tensor> inputs) {
+    id_ = id;
+    sequence_ = id;
+    inputs_ = std::move(inputs);
+    status_ = TaskStatus::Pending;
+    start_time_.reset();
+    end_time_.reset();
+    deadline_.reset();
+    result_.reset();
+}
+
+void Task::Reset(TaskId id, atom::core::ModelPtr model, std::vector<atom::core::Tensor> inputs,
+                 atom::core::Priority priority) {
+    Reset(id, std::move(inputs));
+    model_ = std::move(model);
+    priority_ = priority;
+    callback_ = nullptr;
+    awaiter_ = {};
+    dependencies_.clear();
+    numa_node_ = -1;
+}
+
+void Task::AddDependency(TaskId dep_id) {
+    if (std::find(dependencies_.begin(), dependencies_.end(), dep_id) == dependencies_.end()) {
+        dependencies_.push_back(dep_id);
+    }
+}
+
+void Task::RemoveDependency(TaskId dep_id) {
+    std::erase(dependencies_, dep_id);
+}
+
+void Task::InvokeCallback(const TaskResult& result) {
+    if (callback_) {
+        callback_(result);
+    }
+}
+
+} // namespace atom::scheduler
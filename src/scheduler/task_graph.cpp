@@ -0,0 +1,157 @@
+#include "atom/scheduler/task_graph.hpp"
+#include <algorithm>
+
+namespace atom::scheduler {
+
+namespace {
+
+// Runs a Transform node through the same path as a model
+class TransformModel : public atom::core::ModelBase {
+public:
+    TransformModel(std::string name, TaskGraphTemplate::Transform transform)
+        : ModelBase(std::move(name)), transform_(std::move(transform)) {
+        initialized_ = true;
+    }
+
+    atom::core::Result<void> Initialize(const std::string&, const atom::core::InferenceOptions&) override { return {}; }
+    atom::core::Result<void> Warmup() override { return {}; }
+    void Shutdown() override {}
+
+    atom::core::Result<std::vector<atom::core::Tensor>> Infer(const std::vector<atom::core::Tensor>& inputs) override {
+        return transform_(inputs);
+    }
+
+    using ModelBase::InferAsync;
+    atom::core::Result<void> InferAsync(std::vector<atom::core::Tensor> inputs, InferCallback callback) override {
+        callback(transform_(inputs));
+        return {};
+    }
+
+    atom::core::BackendType GetBackendType() const override { return atom::core::BackendType::Custom; }
+    size_t GetMemoryUsage() const override { return 0; }
+
+private:
+    TaskGraphTemplate::Transform transform_;
+};
+
+} // namespace
+
+GraphRun::GraphRun(const TaskGraphTemplate& graph)
+    : pending_(std::make_unique<std::atomic<atom::core::u32>[]>(graph.GetNodeCount()))
+    , readers_(std::make_unique<std::atomic<atom::core::u32>[]>(graph.GetNodeCount()))
+    , outputs_(graph.GetNodeCount()) {
+    tasks_.reserve(graph.GetNodeCount());
+    for (TaskGraphTemplate::NodeId i = 0; i < graph.GetNodeCount(); ++i) {
+        const auto& node = graph.nodes_[i];
+        auto task = std::make_shared<Task>(0, node.model, std::vector<atom::core::Tensor>{}, node.priority);
+        task->SetGraphNode(this, i);
+        tasks_.push_back(std::move(task));
+    }
+}
+
+TaskGraphTemplate::TaskGraphTemplate(std::string name) : name_(std::move(name)) {}
+
+TaskGraphTemplate::~TaskGraphTemplate() = default;
+
+atom::core::Result<TaskGraphTemplate::NodeId> TaskGraphTemplate::AddNode(std::string name,
+    atom::core::ModelPtr model, atom::core::Priority priority) {
+    if (compiled_) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Task graph already compiled: " + name_));
+    }
+    nodes_.push_back(Node{std::move(name), std::move(model), priority, {}, {}});
+    return static_cast<NodeId>(nodes_.size() - 1);
+}
+
+atom::core::Result<TaskGraphTemplate::NodeId> TaskGraphTemplate::AddNode(std::string name,
+    Transform transform, atom::core::Priority priority) {
+    atom::core::ModelPtr model;
+    if (transform) {
+        model = std::make_shared<TransformModel>(name, std::move(transform));
+    }
+    return AddNode(std::move(name), std::move(model), priority);
+}
+
+atom::core::Result<void> TaskGraphTemplate::AddEdge(NodeId from, NodeId to) {
+    if (compiled_) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Task graph already compiled: " + name_));
+    }
+    if (from >= nodes_.size() || to >= nodes_.size() || from == to) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Invalid edge in task graph " + name_ + ": " + std::to_string(from) + " -> " + std::to_string(to)));
+    }
+
+    auto& successors = nodes_[from].successors;
+    if (std::find(successors.begin(), successors.end(), to) != successors.end()) {
+        return {};
+    }
+    successors.push_back(to);
+    nodes_[to].predecessors.push_back(from);
+    return {};
+}
+
+atom::core::Result<void> TaskGraphTemplate::Compile() {
+    if (compiled_) return {};
+    if (nodes_.empty()) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+            "Task graph has no nodes: " + name_));
+    }
+
+    for (const auto& node : nodes_) {
+        if (!node.model) {
+            return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::InvalidArgument,
+                "Task graph node has neither model nor transform: " + name_ + "/" + node.name));
+        }
+    }
+
+    // Kahn's algorithm; whatever is left unordered sits on a cycle
+    std::vector<size_t> in_degree(nodes_.size());
+    std::vector<NodeId> order;
+    order.reserve(nodes_.size());
+    for (NodeId i = 0; i < nodes_.size(); ++i) {
+        in_degree[i] = nodes_[i].predecessors.size();
+        if (in_degree[i] == 0) order.push_back(i);
+    }
+    for (size_t head = 0; head < order.size(); ++head) {
+        for (NodeId next : nodes_[order[head]].successors) {
+            if (--in_degree[next] == 0) order.push_back(next);
+        }
+    }
+    if (order.size() != nodes_.size()) {
+        return std::unexpected(ATOM_ERROR(atom::core::ErrorCode::SchedulerError,
+            "Task graph contains a cycle: " + name_));
+    }
+
+    for (NodeId i = 0; i < nodes_.size(); ++i) {
+        if (nodes_[i].predecessors.empty()) roots_.push_back(i);
+        if (nodes_[i].successors.empty()) sinks_.push_back(i);
+    }
+    order_ = std::move(order);
+    compiled_ = true;
+    return {};
+}
+
+size_t TaskGraphTemplate::GetPooledRunCount() const {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    return free_runs_.size();
+}
+
+std::unique_ptr<GraphRun> TaskGraphTemplate::AcquireRun() const {
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        if (!free_runs_.empty()) {
+            auto run = std::move(free_runs_.back());
+            free_runs_.pop_back();
+            return run;
+        }
+    }
+    return std::make_unique<GraphRun>(*this);
+}
+
+void TaskGraphTemplate::ReleaseRun(std::unique_ptr<GraphRun> run) const {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    free_runs_.push_back(std::move(run));
+}
+
+} // namespace atom::scheduler
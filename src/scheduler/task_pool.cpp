@@ -0,0 +1,167 @@
+#include "atom/scheduler/task_pool.hpp"
+
+namespace atom::scheduler {
+
+TaskPool::TaskPool(atom::core::Duration retention) : retention_(retention) {}
+
+TaskPool::~TaskPool() {
+    for (auto& chunk : chunks_) {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
+size_t TaskPool::GetCapacity() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return chunk_count_ * kChunkSize;
+}
+
+TaskPool::Record* TaskPool::Find(TaskId id) const {
+    const atom::core::u32 slot = SlotOf(id);
+    if (slot / kChunkSize >= kMaxChunks) return nullptr;
+    Record* chunk = chunks_[slot / kChunkSize].load(std::memory_order_acquire);
+    return chunk ? &chunk[slot % kChunkSize] : nullptr;
+}
+
+TaskPool::Record* TaskPool::Acquire(TaskId& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (free_.empty()) {
+        Reclaim(std::chrono::high_resolution_clock::now());
+    }
+    if (free_.empty()) {
+        if (chunk_count_ == kMaxChunks) return nullptr;
+
+        auto* chunk = new Record[kChunkSize];
+        for (size_t i = 0; i < kChunkSize; ++i) {
+            chunk[i].task = std::make_shared<Task>(0, nullptr, std::vector<atom::core::Tensor>{});
+        }
+        chunks_[chunk_count_].store(chunk, std::memory_order_release);
+
+        // Sized for every slot, so returning one never allocates
+        const size_t capacity = (chunk_count_ + 1) * kChunkSize;
+        free_.reserve(capacity);
+        std::vector<RetireEntry> ring(capacity);
+        for (size_t i = 0; i < retiring_size_; ++i) {
+            ring[i] = retiring_[(retiring_head_ + i) % retiring_.size()];
+        }
+        retiring_ = std::move(ring);
+        retiring_head_ = 0;
+        for (size_t i = kChunkSize; i-- > 0;) {
+            free_.push_back(static_cast<atom::core::u32>(chunk_count_ * kChunkSize + i));
+        }
+        chunk_count_++;
+    }
+
+    const atom::core::u32 slot = free_.back();
+    free_.pop_back();
+    Record& record = *Find(slot);
+    {
+        std::lock_guard<std::mutex> record_lock(record.mutex);
+        id = MakeId(slot, record.generation);
+    }
+    live_count_.fetch_add(1, std::memory_order_relaxed);
+    return &record;
+}
+
+void TaskPool::Retire(TaskId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    PushRetiring(RetireEntry{SlotOf(id), GenerationOf(id)});
+}
+
+void TaskPool::Consume(TaskId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Record* record = Find(id);
+    if (!record) return;
+    {
+        std::lock_guard<std::mutex> record_lock(record->mutex);
+        if (record->generation != GenerationOf(id)) return;
+        record->consumed = true;
+    }
+    // Still referenced records are picked up again by Reclaim
+    Recycle(*record, SlotOf(id));
+}
+
+void TaskPool::Discard(TaskId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Record* record = Find(id);
+    if (!record) return;
+    {
+        std::lock_guard<std::mutex> record_lock(record->mutex);
+        if (record->generation != GenerationOf(id)) return;
+        record->finished = true;
+        record->consumed = true;
+    }
+    if (!Recycle(*record, SlotOf(id))) {
+        PushRetiring(RetireEntry{SlotOf(id), GenerationOf(id)});
+    }
+}
+
+void TaskPool::PushRetiring(RetireEntry entry) {
+    // The ring has a place per slot. Entries of records recycled on
+    // consumption linger until they reach the head; when they fill the
+    // ring, drop them (at most one current entry per slot remains).
+    if (retiring_size_ == retiring_.size()) {
+        size_t kept = 0;
+        for (size_t i = 0; i < retiring_size_; ++i) {
+            const RetireEntry queued = retiring_[(retiring_head_ + i) % retiring_.size()];
+            Record& record = *Find(queued.slot);
+            std::lock_guard<std::mutex> record_lock(record.mutex);
+            if (record.generation == queued.generation) {
+                retiring_[(retiring_head_ + kept++) % retiring_.size()] = queued;
+            }
+        }
+        retiring_size_ = kept;
+    }
+    retiring_[(retiring_head_ + retiring_size_) % retiring_.size()] = entry;
+    retiring_size_++;
+}
+
+bool TaskPool::Recycle(Record& record, atom::core::u32 slot) {
+    {
+        std::lock_guard<std::mutex> record_lock(record.mutex);
+        if (!record.finished || record.waiters > 0 || record.task.use_count() > 1) return false;
+
+        if (++record.generation == 0) record.generation = 1;
+        record.finished = false;
+        record.consumed = false;
+        record.result.reset();
+        record.dependents.clear();
+        record.pending.store(0, std::memory_order_relaxed);
+    }
+    // Drop the model, inputs and callback captures now rather than on reuse
+    record.task->Reset(0, nullptr, {}, atom::core::Priority::Normal);
+    free_.push_back(slot);
+    live_count_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+void TaskPool::Reclaim(atom::core::TimePoint now) {
+    // Entries are in finish order: the first unconsumed one still inside the
+    // retention window ends the scan. Ones still in use go to the back.
+    for (size_t scanned = retiring_size_; scanned > 0 && retiring_size_ > 0; --scanned) {
+        const RetireEntry entry = retiring_[retiring_head_];
+        Record& record = *Find(entry.slot);
+        {
+            std::lock_guard<std::mutex> record_lock(record.mutex);
+            if (record.generation == entry.generation && !record.consumed &&
+                now - record.finished_at < retention_) {
+                break;
+            }
+        }
+
+        retiring_head_ = (retiring_head_ + 1) % retiring_.size();
+        retiring_size_--;
+
+        bool current;
+        {
+            std::lock_guard<std::mutex> record_lock(record.mutex);
+            current = record.generation == entry.generation;
+            if (current) record.consumed = true;
+        }
+        if (current && !Recycle(record, entry.slot)) {
+            PushRetiring(entry);
+        }
+    }
+}
+
+} // namespace atom::scheduler
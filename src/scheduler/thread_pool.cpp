@@ -1,4 +1,350 @@
-// Placeholder implementation for scheduler/thread_pool
 #include "atom/scheduler/thread_pool.hpp"
+#include "atom/logging/logger.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
 
-// TODO: Implement scheduler/thread_pool
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace atom::scheduler {
+
+using atom::core::u32;
+using atom::core::u64;
+
+namespace {
+
+constexpr u32 kMinSpin = 16;        // FindTask rounds before parking
+constexpr u32 kMaxSpin = 1024;
+constexpr size_t kNodeCacheSize = 256;
+constexpr size_t kNodeBatch = 64;         // nodes moved between a thread and the shared spares
+constexpr size_t kMaxSpareNodes = 4096;
+
+// Worker the current thread belongs to, if any
+thread_local const void* t_pool = nullptr;
+thread_local size_t t_worker = 0;
+
+void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+u64 NextRandom(u64& state) {
+    // xorshift64
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+} // namespace
+
+// A node is released on the thread that ran it. A thread that only posts
+// (the Scheduler's dispatcher) would allocate every node and its workers
+// free them, so past the cap nodes spill in batches to a shared list that
+// empty caches refill from; only beyond that do they go back to the allocator.
+struct ThreadPool::NodeCache {
+    TaskNode* head{nullptr};
+    size_t size{0};
+
+    ~NodeCache() {
+        while (head) delete std::exchange(head, head->next);
+    }
+};
+
+struct ThreadPool::SpareNodes {
+    std::mutex mutex;
+    TaskNode* head{nullptr};
+    size_t size{0};
+
+    ~SpareNodes() {
+        while (head) delete std::exchange(head, head->next);
+    }
+};
+
+ThreadPool::SpareNodes& ThreadPool::Spares() {
+    static SpareNodes spares;
+    return spares;
+}
+
+ThreadPool::NodeCache& ThreadPool::LocalNodeCache() {
+    thread_local NodeCache cache;
+    return cache;
+}
+
+ThreadPool::TaskNode* ThreadPool::AcquireNode(Task&& task) {
+    NodeCache& cache = LocalNodeCache();
+    if (!cache.head) {
+        SpareNodes& spares = Spares();
+        std::lock_guard<std::mutex> lock(spares.mutex);
+        for (size_t i = 0; i < kNodeBatch && spares.head; ++i) {
+            TaskNode* node = spares.head;
+            spares.head = node->next;
+            spares.size--;
+            node->next = cache.head;
+            cache.head = node;
+            ++cache.size;
+        }
+    }
+    if (!cache.head) return new TaskNode{std::move(task)};
+
+    TaskNode* node = std::exchange(cache.head, cache.head->next);
+    --cache.size;
+    node->task = std::move(task);
+    node->next = nullptr;
+    return node;
+}
+
+void ThreadPool::ReleaseNode(TaskNode* node) {
+    NodeCache& cache = LocalNodeCache();
+    node->next = cache.head;
+    cache.head = node;
+    ++cache.size;
+    if (cache.size <= kNodeCacheSize) return;
+
+    TaskNode* batch = nullptr;
+    for (size_t i = 0; i < kNodeBatch; ++i) {
+        TaskNode* spilled = std::exchange(cache.head, cache.head->next);
+        spilled->next = batch;
+        batch = spilled;
+    }
+    cache.size -= kNodeBatch;
+
+    SpareNodes& spares = Spares();
+    {
+        std::lock_guard<std::mutex> lock(spares.mutex);
+        if (spares.size < kMaxSpareNodes) {
+            while (batch) {
+                TaskNode* spare = std::exchange(batch, batch->next);
+                spare->next = spares.head;
+                spares.head = spare;
+                spares.size++;
+            }
+        }
+    }
+    while (batch) delete std::exchange(batch, batch->next);
+}
+
+ThreadPool::ThreadPool(size_t num_threads, atom::core::AffinityPolicy affinity) {
+    num_threads = std::max<size_t>(num_threads, 1);
+    auto placements = atom::core::NumaTopology::Instance().PlaceWorkers(num_threads, affinity);
+    workers_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->rng = 0x9e3779b97f4a7c15ull * (i + 1);
+        worker->spin_limit = kMinSpin;
+        worker->placement = std::move(placements[i]);
+
+        // Placements come sorted by node, so each node opens one group
+        if (groups_.empty() || groups_.back()->node != worker->placement.node) {
+            auto group = std::make_unique<Group>();
+            group->node = worker->placement.node;
+            group->begin = i;
+            groups_.push_back(std::move(group));
+        }
+        groups_.back()->end = i + 1;
+        worker->group = groups_.size() - 1;
+        workers_.push_back(std::move(worker));
+    }
+    // Start only once every deque exists, since workers steal from all of them
+    for (size_t i = 0; i < num_threads; ++i) {
+        workers_[i]->thread = std::thread([this, i]() { WorkerThread(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    Stop();
+}
+
+void ThreadPool::Post(Task task, int node) {
+    if (stopped_.load(std::memory_order_relaxed)) {
+        throw std::runtime_error("ThreadPool is stopped");
+    }
+
+    TaskNode* item = AcquireNode(std::move(task));
+    pending_.fetch_add(1, std::memory_order_relaxed);
+
+    auto inject = [item](Injector& injector) {
+        std::lock_guard<std::mutex> lock(injector.mutex);
+        (injector.tail ? injector.tail->next : injector.head) = item;
+        injector.tail = item;
+        injector.count.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    // groups_.size() when any node will do
+    const size_t target = GroupOfNode(node);
+    if (t_pool == this && (target == groups_.size() || target == workers_[t_worker]->group)) {
+        workers_[t_worker]->deque.Push(item);
+        Notify(workers_[t_worker]->group);
+    } else if (target < groups_.size()) {
+        inject(groups_[target]->injector);
+        Notify(target);
+    } else {
+        inject(injector_);
+        Notify(t_pool == this ? workers_[t_worker]->group : 0);
+    }
+}
+
+size_t ThreadPool::GroupOfNode(int node) const {
+    if (node < 0) return groups_.size();
+    for (size_t i = 0; i < groups_.size(); ++i) {
+        if (groups_[i]->node == node) return i;
+    }
+    return groups_.size();
+}
+
+void ThreadPool::Notify(size_t group) {
+    // Pairs with the sleeper count increment in WorkerThread: either this
+    // thread sees the sleeper, or the sleeper sees the new task. Sleepers
+    // of the group go first; one elsewhere takes the task as remote work.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (size_t i = 0; i < groups_.size(); ++i) {
+        Group& candidate = *groups_[(group + i) % groups_.size()];
+        if (candidate.sleepers.load(std::memory_order_relaxed) == 0) continue;
+        if (!candidate.waking.exchange(true)) {
+            candidate.wake_epoch.fetch_add(1, std::memory_order_release);
+            candidate.wake_epoch.notify_one();
+        }
+        return;
+    }
+}
+
+void ThreadPool::Stop() {
+    if (stopped_.exchange(true)) return;
+    for (auto& group : groups_) {
+        group->wake_epoch.fetch_add(1, std::memory_order_release);
+        group->wake_epoch.notify_all();
+    }
+
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+void ThreadPool::WaitAll() {
+    for (size_t pending = pending_.load(); pending != 0; pending = pending_.load()) {
+        pending_.wait(pending);
+    }
+}
+
+size_t ThreadPool::GetQueuedTaskCount() const {
+    const size_t pending = pending_.load();
+    const size_t active = active_count_.load();
+    return pending > active ? pending - active : 0;
+}
+
+ThreadPool::TaskNode* ThreadPool::FindTask(Worker& self, bool remote) {
+    if (TaskNode* node = self.deque.Pop()) return node;
+
+    Group& own = *groups_[self.group];
+    if (TaskNode* node = TakeInjected(own.injector, self.group)) return node;
+    if (TaskNode* node = TakeInjected(injector_, self.group)) return node;
+    if (TaskNode* node = Steal(self, own.begin, own.end)) return node;
+    if (!remote || groups_.size() == 1) return nullptr;
+
+    // Nothing left on this node: run another node's work rather than idle
+    for (size_t i = 1; i < groups_.size(); ++i) {
+        const size_t other = (self.group + i) % groups_.size();
+        if (TaskNode* node = TakeInjected(groups_[other]->injector, other)) return node;
+    }
+    return Steal(self, 0, workers_.size());
+}
+
+ThreadPool::TaskNode* ThreadPool::TakeInjected(Injector& injector, size_t group) {
+    if (injector.count.load(std::memory_order_relaxed) == 0) return nullptr;
+
+    std::unique_lock<std::mutex> lock(injector.mutex);
+    if (!injector.head) return nullptr;
+    TaskNode* node = std::exchange(injector.head, injector.head->next);
+    if (!injector.head) injector.tail = nullptr;
+    node->next = nullptr;
+    const bool more = injector.count.fetch_sub(1, std::memory_order_relaxed) > 1;
+    lock.unlock();
+    if (more) Notify(group);
+    return node;
+}
+
+ThreadPool::TaskNode* ThreadPool::Steal(Worker& self, size_t begin, size_t end) {
+    // From a random victim, then the ones after it
+    const size_t count = end - begin;
+    const size_t start = static_cast<size_t>(NextRandom(self.rng) % count);
+    for (size_t i = 0; i < count; ++i) {
+        Worker& victim = *workers_[begin + (start + i) % count];
+        if (&victim == &self) continue;
+        if (TaskNode* node = victim.deque.Steal()) {
+            if (!victim.deque.Empty()) Notify(victim.group);
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+void ThreadPool::Execute(TaskNode* node) {
+    active_count_.fetch_add(1, std::memory_order_relaxed);
+    try {
+        node->task();
+    } catch (...) {
+        // Posted tasks have nobody to report to
+    }
+    node->task.Reset();
+    ReleaseNode(node);
+    active_count_.fetch_sub(1, std::memory_order_relaxed);
+    if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        pending_.notify_all();
+    }
+}
+
+void ThreadPool::WorkerThread(size_t index) {
+    t_pool = this;
+    t_worker = index;
+    Worker& self = *workers_[index];
+    Group& group = *groups_[self.group];
+    if (auto pinned = atom::core::PinCurrentThread(self.placement); !pinned) {
+        LOG_WARNING("Worker " + std::to_string(index) + " runs unpinned: " + pinned.error().message);
+    }
+
+    // Other nodes' work is only looked at before parking, so a busy node's
+    // own workers get the first chance at it
+    while (true) {
+        if (TaskNode* node = FindTask(self, false)) {
+            Execute(node);
+            continue;
+        }
+
+        // Spin before parking; spin longer while spinning keeps finding work
+        TaskNode* node = nullptr;
+        for (u32 i = 0; i < self.spin_limit && !node; ++i) {
+            CpuRelax();
+            node = FindTask(self, false);
+        }
+        if (node) {
+            self.spin_limit = std::min(self.spin_limit * 2, kMaxSpin);
+            Execute(node);
+            continue;
+        }
+        self.spin_limit = std::max(self.spin_limit / 2, kMinSpin);
+
+        const u32 epoch = group.wake_epoch.load(std::memory_order_acquire);
+        group.sleepers.fetch_add(1, std::memory_order_seq_cst);
+        node = FindTask(self, true);
+        if (!node) {
+            // Drain remaining work before exiting
+            if (stopped_.load()) {
+                group.sleepers.fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+            group.wake_epoch.wait(epoch, std::memory_order_acquire);
+            group.waking.store(false);
+        }
+        group.sleepers.fetch_sub(1, std::memory_order_relaxed);
+        if (node) Execute(node);
+    }
+}
+
+} // namespace atom::scheduler